@@ -1,7 +1,8 @@
 {
   "variables": {
     "v8_enable_pointer_compression": "false",
-    "v8_enable_31bit_smis_on_64bit_arch": "false"
+    "v8_enable_31bit_smis_on_64bit_arch": "false",
+    "ed25519_no_sc64%": "false"
   },
   "targets": [
     {
@@ -23,6 +24,7 @@
         "src/aesb.c",
         "src/blake256.c",
         "src/chacha8.cpp",
+        "src/chukwa-context.cpp",
         "src/crypto.cpp",
         "src/groestl.c",
         "src/hash.c",
@@ -38,8 +40,12 @@
         "src/skein.c",
         "src/slow-hash-arm.c",
         "src/slow-hash-x86.c",
+        "src/slow-hash-pool.cpp",
         "src/slow-hash-portable.c",
+        "src/slow-hash-scratchpad.c",
         "src/StringTools.cpp",
+        "src/subwallet-key-index.cpp",
+        "src/tree-hash-accumulator.cpp",
         "src/tree-hash.c",
         "external/argon2/lib/argon2.c",
         "external/argon2/arch/generic/lib/argon2-arch.c",
@@ -67,12 +73,14 @@
         "external/ed25519/fe_sub.c",
         "external/ed25519/fe_tobytes.c",
         "external/ed25519/ge_add.c",
+        "external/ed25519/ge_avx2.c",
         "external/ed25519/ge_cached_0.c",
         "external/ed25519/ge_cached_cmov.c",
         "external/ed25519/ge_check_subgroup_precomp_vartime.c",
         "external/ed25519/ge_double_scalarmult_base_vartime.c",
         "external/ed25519/ge_double_scalarmult_precomp_vartime.c",
         "external/ed25519/ge_dsm_precomp.c",
+        "external/ed25519/ge_fixed_base_precomp.c",
         "external/ed25519/ge_frombytes_vartime.c",
         "external/ed25519/ge_fromfe_frombytes_vartime.c",
         "external/ed25519/ge_madd.c",
@@ -82,6 +90,7 @@
         "external/ed25519/ge_p1p1_to_p3.c",
         "external/ed25519/ge_p2_0.c",
         "external/ed25519/ge_p2_dbl.c",
+        "external/ed25519/ge_p2_tobytes_batch.c",
         "external/ed25519/ge_p3_0.c",
         "external/ed25519/ge_p3_dbl.c",
         "external/ed25519/ge_p3_to_cached.c",
@@ -91,13 +100,17 @@
         "external/ed25519/ge_precomp_cmov.c",
         "external/ed25519/ge_scalarmult.c",
         "external/ed25519/ge_scalarmult_base.c",
+        "external/ed25519/ge_scalarmult_fixed_base.c",
         "external/ed25519/ge_sub.c",
         "external/ed25519/ge_tobytes.c",
         "external/ed25519/load_3.c",
         "external/ed25519/load_4.c",
+        "external/ed25519/load_8.c",
         "external/ed25519/negative.c",
+        "external/ed25519/sc64.c",
         "external/ed25519/sc_0.c",
         "external/ed25519/sc_add.c",
+        "external/ed25519/sc_batch.c",
         "external/ed25519/sc_check.c",
         "external/ed25519/sc_isnonzero.c",
         "external/ed25519/sc_mul.c",
@@ -166,6 +179,14 @@
         "-fexceptions"
       ],
       "conditions": [
+        [
+          "ed25519_no_sc64=='true'",
+          {
+            "defines": [
+              "ED25519_NO_SC64"
+            ]
+          }
+        ],
         [
           'OS=="mac"', 
           {
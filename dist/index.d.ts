@@ -1,3 +1,4 @@
+/// <reference types="node" />
 import { IKeyPair, ICryptoConfig, IPreparedRingSignatures, CryptoType } from './Interfaces';
 export { IKeyPair, ICryptoConfig, IPreparedRingSignatures, CryptoType };
 /**
@@ -442,4 +443,63 @@ export declare class Crypto {
      * @param data
      */
     chukwa_slow_hash_v2(data: string): Promise<string>;
+    /**
+     * Generates the key derivations (aB) of every public key with its private key. The
+     * keys are packed 32 bytes apiece, and an argument holding a single key is used for
+     * every record, e.g. a wallet's private view key. Only available with the Node.js
+     * native addon. Resolves to the packed derivations, zeroed where one failed
+     * @param public_keys the packed public keys
+     * @param private_keys the packed private keys
+     */
+    generateKeyDerivations(public_keys: Uint8Array, private_keys: Uint8Array): Promise<Buffer>;
+    /**
+     * Derives the output keys of a batch of outputs, as derivePublicKey does for one.
+     * Only available with the Node.js native addon
+     * @param derivations the packed key derivations
+     * @param output_indexes the output indexes, or a single index for every record
+     * @param public_keys the packed public keys, or a single public key for every record
+     */
+    derivePublicKeys(derivations: Uint8Array, output_indexes: number | number[] | Uint32Array, public_keys: Uint8Array): Promise<Buffer>;
+    /**
+     * Underives the public keys of a batch of outputs, as underivePublicKey does for one.
+     * Only available with the Node.js native addon
+     * @param derivations the packed key derivations
+     * @param output_indexes the output indexes, or a single index for every record
+     * @param outputKeys the packed output keys
+     */
+    underivePublicKeys(derivations: Uint8Array, output_indexes: number | number[] | Uint32Array, outputKeys: Uint8Array): Promise<Buffer>;
+    /**
+     * Generates the key images of a batch of outputs, as generateKeyImage does for one.
+     * Only available with the Node.js native addon
+     * @param publicEphemerals the packed public ephemerals
+     * @param private_ephemerals the packed private ephemerals
+     */
+    generateKeyImages(publicEphemerals: Uint8Array, private_ephemerals: Uint8Array): Promise<Buffer>;
+    /**
+     * Checks a batch of signatures, as checkSignature does for one. Only available with
+     * the Node.js native addon. Resolves to one byte per signature, 1 if it is valid
+     * @param message_digests the packed hashes, or a single hash for every record
+     * @param public_keys the packed public keys
+     * @param signatures the packed 64 byte signatures
+     */
+    checkSignaturesBatch(message_digests: Uint8Array, public_keys: Uint8Array, signatures: Uint8Array): Promise<Buffer>;
+    /**
+     * Checks a batch of ring signatures, as checkRingSignatures does for one. The input
+     * keys and signatures of every ring are packed one ring after the other, with the
+     * size of each ring given by ring_sizes. Only available with the Node.js native
+     * addon. Resolves to one byte per ring, 1 if its signatures are valid
+     * @param prefix_hashes the packed prefix hashes
+     * @param key_images the packed key images
+     * @param input_keys the packed input keys of every ring
+     * @param signatures the packed signatures of every ring
+     * @param ring_sizes the size of every ring, or a single size for every ring
+     */
+    checkRingSignaturesBatch(prefix_hashes: Uint8Array, key_images: Uint8Array, input_keys: Uint8Array, signatures: Uint8Array, ring_sizes: number | number[] | Uint32Array): Promise<Buffer>;
+    /**
+     * Calculates the cn_fast_hash of every record_length bytes of the data supplied.
+     * Only available with the Node.js native addon. Resolves to the packed hashes
+     * @param data the packed messages
+     * @param record_length the length of each message
+     */
+    cn_fast_hashes(data: Uint8Array, record_length: number): Promise<Buffer>;
 }
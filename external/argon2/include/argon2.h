@@ -80,6 +80,9 @@ extern "C" {
 #define ARGON2_FLAG_CLEAR_PASSWORD (UINT32_C(1) << 0)
 #define ARGON2_FLAG_CLEAR_SECRET (UINT32_C(1) << 1)
 #define ARGON2_FLAG_GENKAT (UINT32_C(1) << 3)
+/* Skips wiping the block memory once hashing is done, for public inputs such as
+ * proof-of-work where there is nothing secret left in it. */
+#define ARGON2_FLAG_NO_CLEAR_MEMORY (UINT32_C(1) << 4)
 
 /* Global flag to determine if we are wiping internal memory buffers. This flag
  * is defined in core.c and deafults to 1 (wipe internal memory). */
@@ -433,6 +436,20 @@ ARGON2_PUBLIC size_t argon2_encodedlen(uint32_t t_cost, uint32_t m_cost,
  */
 ARGON2_PUBLIC void argon2_select_impl(FILE *out, const char *prefix);
 
+/**
+ * Selects an optimized implementation by name (e. g. "SSE2", "SSSE3", "XOP",
+ * "AVX2" or "AVX-512F", compared case-insensitively) instead of benchmarking.
+ * @param name The name of the implementation to use
+ * @return 0 on success, -1 if the implementation is unknown or the CPU does not
+ * support it (in which case the selection is left unchanged)
+ */
+ARGON2_PUBLIC int argon2_force_impl(const char *name);
+
+/**
+ * @return The name of the implementation currently in use
+ */
+ARGON2_PUBLIC const char *argon2_selected_impl_name(void);
+
 /* signals support for passing preallocated memory: */
 #define ARGON2_PREALLOCATED_MEMORY
 
@@ -112,7 +112,9 @@ void free_memory(const argon2_context *context,
                  const argon2_instance_t *instance) {
     size_t memory_size = instance->memory_blocks * ARGON2_BLOCK_SIZE;
 
-    clear_internal_memory(instance->memory, memory_size);
+    if (!(context->flags & ARGON2_FLAG_NO_CLEAR_MEMORY)) {
+        clear_internal_memory(instance->memory, memory_size);
+    }
 
     if (instance->keep_memory) {
         /* user-supplied memory -- do not free */
@@ -118,3 +118,52 @@ void argon2_select_impl(FILE *out, const char *prefix)
     }
     select_impl(out, prefix);
 }
+
+static int names_equal(const char *a, const char *b)
+{
+    for (; *a != '\0' && *b != '\0'; a++, b++) {
+        char ca = *a, cb = *b;
+        if (ca >= 'a' && ca <= 'z') {
+            ca = (char)(ca - 'a' + 'A');
+        }
+        if (cb >= 'a' && cb <= 'z') {
+            cb = (char)(cb - 'a' + 'A');
+        }
+        if (ca != cb) {
+            return 0;
+        }
+    }
+    return *a == *b;
+}
+
+int argon2_force_impl(const char *name)
+{
+    argon2_impl_list impls;
+    unsigned int i;
+
+    if (name == NULL) {
+        return -1;
+    }
+
+    argon2_get_impl_list(&impls);
+
+    for (i = 0; i < impls.count; i++) {
+        const argon2_impl *impl = &impls.entries[i];
+
+        if (!names_equal(impl->name, name)) {
+            continue;
+        }
+        if (impl->check != NULL && !impl->check()) {
+            return -1;
+        }
+        selected_argon_impl = *impl;
+        return 0;
+    }
+
+    return -1;
+}
+
+const char *argon2_selected_impl_name(void)
+{
+    return selected_argon_impl.name;
+}
@@ -30,6 +30,7 @@
 #include "ge_double_scalarmult_base_vartime.h"
 #include "ge_double_scalarmult_precomp_vartime.h"
 #include "ge_dsm_precomp.h"
+#include "ge_fixed_base_precomp.h"
 #include "ge_frombytes_vartime.h"
 #include "ge_fromfe_frombytes_vartime.h"
 #include "ge_madd.h"
@@ -39,6 +40,7 @@
 #include "ge_p1p1_to_p3.h"
 #include "ge_p2_0.h"
 #include "ge_p2_dbl.h"
+#include "ge_p2_tobytes_batch.h"
 #include "ge_p3_0.h"
 #include "ge_p3_dbl.h"
 #include "ge_p3_to_cached.h"
@@ -48,11 +50,13 @@
 #include "ge_precomp_cmov.h"
 #include "ge_scalarmult.h"
 #include "ge_scalarmult_base.h"
+#include "ge_scalarmult_fixed_base.h"
 #include "ge_sub.h"
 #include "ge_tobytes.h"
 #include "sc.h"
 #include "sc_0.h"
 #include "sc_add.h"
+#include "sc_batch.h"
 #include "sc_check.h"
 #include "sc_isnonzero.h"
 #include "sc_mul.h"
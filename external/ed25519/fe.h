@@ -8,6 +8,26 @@
 
 #include <stdint.h>
 
+/*
+On 64-bit targets with a native 128-bit multiply the field elements are held
+as five unsigned 51-bit limbs (radix 2^51), which needs far fewer partial
+products per multiplication than the ten signed 25.5-bit limbs of ref10.
+Defining ED25519_FE_REF10 forces the portable ref10 representation.
+*/
+#if !defined(ED25519_FE_REF10) && defined(__SIZEOF_INT128__) && (defined(__x86_64__) || defined(__aarch64__))
+#define ED25519_FE_51
+
+__extension__ typedef unsigned __int128 fe_uint128;
+
+typedef uint64_t fe[5];
+
+#define FE51_MASK ((uint64_t)0x7ffffffffffff)
+
+/* The limbs of 4p, used to keep subtraction and negation from underflowing */
+#define FE51_4P0 ((uint64_t)0x1fffffffffffb4)
+#define FE51_4P1234 ((uint64_t)0x1ffffffffffffc)
+#else
 typedef int32_t fe[10];
+#endif
 
 #endif // ED25519_FE_H
@@ -5,6 +5,23 @@
 
 #include "fe_0.h"
 
+#if defined(ED25519_FE_51)
+
+/*
+h = 0
+*/
+
+void fe_0(fe h)
+{
+    h[0] = 0;
+    h[1] = 0;
+    h[2] = 0;
+    h[3] = 0;
+    h[4] = 0;
+}
+
+#else
+
 /*
 h = 0
 */
@@ -21,4 +38,6 @@ void fe_0(fe h)
     h[7] = 0;
     h[8] = 0;
     h[9] = 0;
-}
\ No newline at end of file
+}
+
+#endif
@@ -5,6 +5,28 @@
 
 #include "fe_cmov.h"
 
+#if defined(ED25519_FE_51)
+
+/*
+Replace (f,g) with (g,g) if b == 1;
+replace (f,g) with (f,g) if b == 0.
+
+Preconditions: b in {0,1}.
+*/
+
+void fe_cmov(fe f, const fe g, unsigned int b)
+{
+    const uint64_t mask = (uint64_t)0 - (uint64_t)b;
+
+    f[0] ^= (f[0] ^ g[0]) & mask;
+    f[1] ^= (f[1] ^ g[1]) & mask;
+    f[2] ^= (f[2] ^ g[2]) & mask;
+    f[3] ^= (f[3] ^ g[3]) & mask;
+    f[4] ^= (f[4] ^ g[4]) & mask;
+}
+
+#else
+
 /*
 Replace (f,g) with (g,g) if b == 1;
 replace (f,g) with (f,g) if b == 0.
@@ -66,4 +88,6 @@ void fe_cmov(fe f, const fe g, unsigned int b)
     f[7] = f7 ^ x7;
     f[8] = f8 ^ x8;
     f[9] = f9 ^ x9;
-}
\ No newline at end of file
+}
+
+#endif
@@ -5,6 +5,23 @@
 
 #include "fe_copy.h"
 
+#if defined(ED25519_FE_51)
+
+/*
+h = f
+*/
+
+void fe_copy(fe h, const fe f)
+{
+    h[0] = f[0];
+    h[1] = f[1];
+    h[2] = f[2];
+    h[3] = f[3];
+    h[4] = f[4];
+}
+
+#else
+
 /*
 h = f
 */
@@ -32,3 +49,5 @@ void fe_copy(fe h, const fe f)
     h[8] = f8;
     h[9] = f9;
 }
+
+#endif
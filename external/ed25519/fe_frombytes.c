@@ -5,6 +5,24 @@
 
 #include "fe_frombytes.h"
 
+#if defined(ED25519_FE_51)
+
+/*
+Loads the 255-bit little-endian value in s, ignoring the top bit, as five
+51-bit limbs.
+*/
+
+void fe_frombytes(fe h, const unsigned char *s)
+{
+    h[0] = load_8(s) & FE51_MASK;
+    h[1] = (load_8(s + 6) >> 3) & FE51_MASK;
+    h[2] = (load_8(s + 12) >> 6) & FE51_MASK;
+    h[3] = (load_8(s + 19) >> 1) & FE51_MASK;
+    h[4] = (load_8(s + 24) >> 12) & FE51_MASK;
+}
+
+#else
+
 void fe_frombytes(fe h, const unsigned char *s)
 {
     int64_t h0 = load_4(s);
@@ -70,4 +88,6 @@ void fe_frombytes(fe h, const unsigned char *s)
     h[7] = (int32_t)h7;
     h[8] = (int32_t)h8;
     h[9] = (int32_t)h9;
-}
\ No newline at end of file
+}
+
+#endif
@@ -9,6 +9,7 @@
 #include "fe.h"
 #include "load_3.h"
 #include "load_4.h"
+#include "load_8.h"
 
 void fe_frombytes(fe h, const unsigned char *s);
 
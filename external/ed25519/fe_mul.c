@@ -5,6 +5,83 @@
 
 #include "fe_mul.h"
 
+#if defined(ED25519_FE_51)
+
+/*
+h = f * g
+Can overlap h with f or g.
+
+Preconditions:
+   f and g bounded by 2^51 + 2^15 in every limb.
+
+Postconditions:
+   h bounded by 2^51 + 2^15 in every limb.
+*/
+
+/*
+Notes on implementation strategy:
+
+Each limb is 51 bits so every 51x51-bit product fits in an unsigned 128-bit
+integer along with the sum of five of them. The reduction 2^255 = 19 folds the
+upper half of the schoolbook product back onto the lower limbs by multiplying
+the relevant g limbs by 19 up front (19 * 2^52 still fits in 64 bits).
+
+The final carry chain leaves every limb below 2^51 except h1, which may pick
+up a small carry from h0.
+*/
+
+void fe_mul(fe h, const fe f, const fe g)
+{
+    const uint64_t f0 = f[0];
+    const uint64_t f1 = f[1];
+    const uint64_t f2 = f[2];
+    const uint64_t f3 = f[3];
+    const uint64_t f4 = f[4];
+    const uint64_t g0 = g[0];
+    const uint64_t g1 = g[1];
+    const uint64_t g2 = g[2];
+    const uint64_t g3 = g[3];
+    const uint64_t g4 = g[4];
+    const uint64_t g1_19 = 19 * g1;
+    const uint64_t g2_19 = 19 * g2;
+    const uint64_t g3_19 = 19 * g3;
+    const uint64_t g4_19 = 19 * g4;
+    fe_uint128 r0, r1, r2, r3, r4;
+    uint64_t h0, h1, h2, h3, h4;
+
+    r0 = (fe_uint128)f0 * g0 + (fe_uint128)f1 * g4_19 + (fe_uint128)f2 * g3_19 + (fe_uint128)f3 * g2_19
+         + (fe_uint128)f4 * g1_19;
+    r1 = (fe_uint128)f0 * g1 + (fe_uint128)f1 * g0 + (fe_uint128)f2 * g4_19 + (fe_uint128)f3 * g3_19
+         + (fe_uint128)f4 * g2_19;
+    r2 = (fe_uint128)f0 * g2 + (fe_uint128)f1 * g1 + (fe_uint128)f2 * g0 + (fe_uint128)f3 * g4_19
+         + (fe_uint128)f4 * g3_19;
+    r3 = (fe_uint128)f0 * g3 + (fe_uint128)f1 * g2 + (fe_uint128)f2 * g1 + (fe_uint128)f3 * g0
+         + (fe_uint128)f4 * g4_19;
+    r4 = (fe_uint128)f0 * g4 + (fe_uint128)f1 * g3 + (fe_uint128)f2 * g2 + (fe_uint128)f3 * g1
+         + (fe_uint128)f4 * g0;
+
+    r1 += (uint64_t)(r0 >> 51);
+    h0 = (uint64_t)r0 & FE51_MASK;
+    r2 += (uint64_t)(r1 >> 51);
+    h1 = (uint64_t)r1 & FE51_MASK;
+    r3 += (uint64_t)(r2 >> 51);
+    h2 = (uint64_t)r2 & FE51_MASK;
+    r4 += (uint64_t)(r3 >> 51);
+    h3 = (uint64_t)r3 & FE51_MASK;
+    h0 += (uint64_t)(r4 >> 51) * 19;
+    h4 = (uint64_t)r4 & FE51_MASK;
+    h1 += h0 >> 51;
+    h0 &= FE51_MASK;
+
+    h[0] = h0;
+    h[1] = h1;
+    h[2] = h2;
+    h[3] = h3;
+    h[4] = h4;
+}
+
+#else
+
 /*
 h = f * g
 Can overlap h with f or g.
@@ -278,4 +355,6 @@ void fe_mul(fe h, const fe f, const fe g)
     h[7] = (int32_t)h7;
     h[8] = (int32_t)h8;
     h[9] = (int32_t)h9;
-}
\ No newline at end of file
+}
+
+#endif
@@ -5,6 +5,67 @@
 
 #include "fe_sq.h"
 
+#if defined(ED25519_FE_51)
+
+/*
+h = f * f
+Can overlap h with f.
+
+Preconditions:
+   f bounded by 2^51 + 2^15 in every limb.
+
+Postconditions:
+   h bounded by 2^51 + 2^15 in every limb.
+*/
+
+/*
+See fe_mul.c for discussion of implementation strategy.
+*/
+
+void fe_sq(fe h, const fe f)
+{
+    const uint64_t f0 = f[0];
+    const uint64_t f1 = f[1];
+    const uint64_t f2 = f[2];
+    const uint64_t f3 = f[3];
+    const uint64_t f4 = f[4];
+    const uint64_t f0_2 = 2 * f0;
+    const uint64_t f1_2 = 2 * f1;
+    const uint64_t f3_19 = 19 * f3;
+    const uint64_t f4_19 = 19 * f4;
+    const uint64_t f3_38 = 38 * f3;
+    const uint64_t f4_38 = 38 * f4;
+    fe_uint128 r0, r1, r2, r3, r4;
+    uint64_t h0, h1, h2, h3, h4;
+
+    r0 = (fe_uint128)f0 * f0 + (fe_uint128)f1_2 * f4_19 + (fe_uint128)f2 * f3_38;
+    r1 = (fe_uint128)f0_2 * f1 + (fe_uint128)f2 * f4_38 + (fe_uint128)f3 * f3_19;
+    r2 = (fe_uint128)f0_2 * f2 + (fe_uint128)f1 * f1 + (fe_uint128)f3 * f4_38;
+    r3 = (fe_uint128)f0_2 * f3 + (fe_uint128)f1_2 * f2 + (fe_uint128)f4 * f4_19;
+    r4 = (fe_uint128)f0_2 * f4 + (fe_uint128)f1_2 * f3 + (fe_uint128)f2 * f2;
+
+    r1 += (uint64_t)(r0 >> 51);
+    h0 = (uint64_t)r0 & FE51_MASK;
+    r2 += (uint64_t)(r1 >> 51);
+    h1 = (uint64_t)r1 & FE51_MASK;
+    r3 += (uint64_t)(r2 >> 51);
+    h2 = (uint64_t)r2 & FE51_MASK;
+    r4 += (uint64_t)(r3 >> 51);
+    h3 = (uint64_t)r3 & FE51_MASK;
+    h0 += (uint64_t)(r4 >> 51) * 19;
+    h4 = (uint64_t)r4 & FE51_MASK;
+    h1 += h0 >> 51;
+    h0 &= FE51_MASK;
+
+    h[0] = h0;
+    h[1] = h1;
+    h[2] = h2;
+    h[3] = h3;
+    h[4] = h4;
+}
+
+#else
+
 /*
 h = f * f
 Can overlap h with f.
@@ -174,4 +235,6 @@ void fe_sq(fe h, const fe f)
     h[7] = (int32_t)h7;
     h[8] = (int32_t)h8;
     h[9] = (int32_t)h9;
-}
\ No newline at end of file
+}
+
+#endif
@@ -5,6 +5,49 @@
 
 #include "fe_sub.h"
 
+#if defined(ED25519_FE_51)
+
+/*
+h = f - g
+Can overlap h with f or g.
+
+4p is added before subtracting so that no limb underflows.
+
+Preconditions:
+   f and g bounded by 2^51 + 2^15 in every limb.
+
+Postconditions:
+   h bounded by 2^51 + 2^15 in every limb.
+*/
+
+void fe_sub(fe h, const fe f, const fe g)
+{
+    uint64_t h0 = (f[0] + FE51_4P0) - g[0];
+    uint64_t h1 = (f[1] + FE51_4P1234) - g[1];
+    uint64_t h2 = (f[2] + FE51_4P1234) - g[2];
+    uint64_t h3 = (f[3] + FE51_4P1234) - g[3];
+    uint64_t h4 = (f[4] + FE51_4P1234) - g[4];
+
+    h1 += h0 >> 51;
+    h0 &= FE51_MASK;
+    h2 += h1 >> 51;
+    h1 &= FE51_MASK;
+    h3 += h2 >> 51;
+    h2 &= FE51_MASK;
+    h4 += h3 >> 51;
+    h3 &= FE51_MASK;
+    h0 += (h4 >> 51) * 19;
+    h4 &= FE51_MASK;
+
+    h[0] = h0;
+    h[1] = h1;
+    h[2] = h2;
+    h[3] = h3;
+    h[4] = h4;
+}
+
+#else
+
 /*
 h = f - g
 Can overlap h with f or g.
@@ -59,4 +102,6 @@ void fe_sub(fe h, const fe f, const fe g)
     h[7] = h7;
     h[8] = h8;
     h[9] = h9;
-}
\ No newline at end of file
+}
+
+#endif
@@ -5,6 +5,116 @@
 
 #include "fe_tobytes.h"
 
+#if defined(ED25519_FE_51)
+
+/*
+Preconditions:
+  h bounded by 2^51 + 2^15 in every limb.
+
+The first two carry passes leave h fully carried and below 2^255 + 19. Adding
+19 and carrying again tells us (via the bit that lands in 2^255) whether h was
+at least p; the remaining step adds 2^255 - 19 and discards bit 255, which
+subtracts p exactly when needed and otherwise undoes the +19.
+*/
+
+void fe_tobytes(unsigned char *s, const fe h)
+{
+    uint64_t t0 = h[0];
+    uint64_t t1 = h[1];
+    uint64_t t2 = h[2];
+    uint64_t t3 = h[3];
+    uint64_t t4 = h[4];
+    uint64_t w;
+    int i;
+
+    t1 += t0 >> 51;
+    t0 &= FE51_MASK;
+    t2 += t1 >> 51;
+    t1 &= FE51_MASK;
+    t3 += t2 >> 51;
+    t2 &= FE51_MASK;
+    t4 += t3 >> 51;
+    t3 &= FE51_MASK;
+    t0 += (t4 >> 51) * 19;
+    t4 &= FE51_MASK;
+
+    t1 += t0 >> 51;
+    t0 &= FE51_MASK;
+    t2 += t1 >> 51;
+    t1 &= FE51_MASK;
+    t3 += t2 >> 51;
+    t2 &= FE51_MASK;
+    t4 += t3 >> 51;
+    t3 &= FE51_MASK;
+    t0 += (t4 >> 51) * 19;
+    t4 &= FE51_MASK;
+
+    /* now t is between 0 and 2^255 - 1, properly carried */
+
+    t0 += 19;
+
+    t1 += t0 >> 51;
+    t0 &= FE51_MASK;
+    t2 += t1 >> 51;
+    t1 &= FE51_MASK;
+    t3 += t2 >> 51;
+    t2 &= FE51_MASK;
+    t4 += t3 >> 51;
+    t3 &= FE51_MASK;
+    t0 += (t4 >> 51) * 19;
+    t4 &= FE51_MASK;
+
+    /* now between 19 and 2^255 - 1 in both cases, and offset by 19 */
+
+    t0 += FE51_MASK + 1 - 19;
+    t1 += FE51_MASK;
+    t2 += FE51_MASK;
+    t3 += FE51_MASK;
+    t4 += FE51_MASK;
+
+    /* now between 2^255 and 2^256 - 20, and offset by 2^255 */
+
+    t1 += t0 >> 51;
+    t0 &= FE51_MASK;
+    t2 += t1 >> 51;
+    t1 &= FE51_MASK;
+    t3 += t2 >> 51;
+    t2 &= FE51_MASK;
+    t4 += t3 >> 51;
+    t3 &= FE51_MASK;
+    t4 &= FE51_MASK;
+
+    w = t0 | (t1 << 51);
+
+    for (i = 0; i < 8; i++)
+    {
+        s[i] = (unsigned char)(w >> (8 * i));
+    }
+
+    w = (t1 >> 13) | (t2 << 38);
+
+    for (i = 0; i < 8; i++)
+    {
+        s[8 + i] = (unsigned char)(w >> (8 * i));
+    }
+
+    w = (t2 >> 26) | (t3 << 25);
+
+    for (i = 0; i < 8; i++)
+    {
+        s[16 + i] = (unsigned char)(w >> (8 * i));
+    }
+
+    w = (t3 >> 39) | (t4 << 12);
+
+    for (i = 0; i < 8; i++)
+    {
+        s[24 + i] = (unsigned char)(w >> (8 * i));
+    }
+}
+
+#else
+
 /*
 Preconditions:
   |h| bounded by 1.1*2^26,1.1*2^25,1.1*2^26,1.1*2^25,etc.
@@ -140,4 +250,6 @@ void fe_tobytes(unsigned char *s, const fe h)
     s[29] = h9 >> 2;
     s[30] = h9 >> 10;
     s[31] = h9 >> 18;
-}
\ No newline at end of file
+}
+
+#endif
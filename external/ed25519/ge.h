@@ -48,4 +48,7 @@ typedef struct
 
 typedef ge_cached ge_dsmp[8];
 
+/* j * 256^i * P for j = 1..8 and i = 0..31, laid out like the base point table */
+typedef ge_precomp ge_fixed_base[32][8];
+
 #endif // ED25519_GE_H
@@ -0,0 +1,903 @@
+// Copyright (c) 2020, The TurtleCoin Developers
+//
+// Please see the included LICENSE file for more information.
+
+#include "ge_avx2.h"
+
+#if defined(ED25519_AVX2)
+
+#include "equal.h"
+#include "fe_1.h"
+#include "fe_add.h"
+#include "fe_frombytes.h"
+#include "fe_tobytes.h"
+#include "load_8.h"
+#include "negative.h"
+#include "slide.h"
+
+#include <immintrin.h>
+#include <string.h>
+
+/*
+Only the functions below are compiled for AVX2, the rest of the library keeps
+the baseline instruction set so that the dispatch in ge_scalarmult.c and friends
+can fall back to the scalar code on older processors.
+*/
+#define AVX2_TARGET __attribute__((target("avx2")))
+
+/*
+Four field elements, one in each 64-bit lane. Each element is held as ten
+unsigned limbs of alternately 26 and 25 bits (the radix 2^25.5 of ref10), so a
+single _mm256_mul_epu32 forms the same limb product for all four elements.
+
+A "reduced" element has limbs bounded by 2^26 + 2^18 (even) and 2^25 + 2^18
+(odd). fe4_mul and fe4_sq also accept the sum of two reduced elements or the
+output of fe4_sub, which keeps 19 times any limb below 2^32 and every column
+sum below 2^63.
+*/
+typedef struct
+{
+    __m256i v[10];
+} fe4;
+
+/* Lane selectors for _mm256_permute4x64_epi64 and _mm256_blend_epi32 */
+#define FE4_LANES(a, b, c, d) ((a) | ((b) << 2) | ((c) << 4) | ((d) << 6))
+#define FE4_BLEND(a, b, c, d) (((a) ? 0x03 : 0) | ((b) ? 0x0c : 0) | ((c) ? 0x30 : 0) | ((d) ? 0xc0 : 0))
+
+/* h = f with its lanes rearranged */
+#define FE4_PERMUTE(h, f, lanes)                                              \
+    do                                                                        \
+    {                                                                         \
+        int fe4_i;                                                            \
+        for (fe4_i = 0; fe4_i < 10; fe4_i++)                                  \
+        {                                                                     \
+            (h)->v[fe4_i] = _mm256_permute4x64_epi64((f)->v[fe4_i], (lanes)); \
+        }                                                                     \
+    } while (0)
+
+/* h = the lanes of g selected by mask, the other lanes of f */
+#define FE4_SELECT(h, f, g, mask)                                                \
+    do                                                                           \
+    {                                                                            \
+        int fe4_i;                                                               \
+        for (fe4_i = 0; fe4_i < 10; fe4_i++)                                     \
+        {                                                                        \
+            (h)->v[fe4_i] = _mm256_blend_epi32((f)->v[fe4_i], (g)->v[fe4_i], (mask)); \
+        }                                                                        \
+    } while (0)
+
+/* Bit offset of every limb */
+static const int fe4_offsets[10] = {0, 26, 51, 77, 102, 128, 153, 179, 204, 230};
+
+/* Splits a canonical encoding into its ten limbs */
+static void fe4_limbs_frombytes(uint64_t *h, const unsigned char *s)
+{
+    unsigned char buffer[40];
+    int i;
+
+    memset(buffer, 0, sizeof(buffer));
+    memcpy(buffer, s, 32);
+
+    for (i = 0; i < 10; i++)
+    {
+        const int offset = fe4_offsets[i];
+        const uint64_t mask = ((uint64_t)1 << (26 - (i & 1))) - 1;
+
+        h[i] = (load_8(buffer + (offset >> 3)) >> (offset & 7)) & mask;
+    }
+}
+
+/* Packs ten reduced limbs into the canonical encoding, as in the ref10 fe_tobytes */
+static void fe4_limbs_tobytes(unsigned char *s, const uint64_t *limbs)
+{
+    int64_t h[10];
+    int64_t q;
+    int64_t carry;
+    int i, j;
+
+    for (i = 0; i < 10; i++)
+    {
+        h[i] = (int64_t)limbs[i];
+    }
+
+    q = (19 * h[9] + ((int64_t)1 << 24)) >> 25;
+
+    for (i = 0; i < 10; i++)
+    {
+        q = (h[i] + q) >> (26 - (i & 1));
+    }
+
+    /* Goal: Output h - (2^255 - 19) q, which is between 0 and 2^255 - 20. */
+    h[0] += 19 * q;
+
+    for (i = 0; i < 10; i++)
+    {
+        carry = h[i] >> (26 - (i & 1));
+        h[i] -= carry << (26 - (i & 1));
+
+        if (i < 9)
+        {
+            h[i + 1] += carry;
+        }
+    }
+
+    memset(s, 0, 32);
+
+    for (i = 0; i < 10; i++)
+    {
+        const int offset = fe4_offsets[i];
+        const uint64_t value = (uint64_t)h[i] << (offset & 7);
+
+        for (j = 0; j < 5 && (offset >> 3) + j < 32; j++)
+        {
+            s[(offset >> 3) + j] |= (unsigned char)(value >> (8 * j));
+        }
+    }
+}
+
+/* h = (f0, f1, f2, f3) */
+static AVX2_TARGET void fe4_pack(fe4 *h, const fe f0, const fe f1, const fe f2, const fe f3)
+{
+    uint64_t limbs[4][10];
+    unsigned char s[32];
+    int i;
+
+    fe_tobytes(s, f0);
+    fe4_limbs_frombytes(limbs[0], s);
+    fe_tobytes(s, f1);
+    fe4_limbs_frombytes(limbs[1], s);
+    fe_tobytes(s, f2);
+    fe4_limbs_frombytes(limbs[2], s);
+    fe_tobytes(s, f3);
+    fe4_limbs_frombytes(limbs[3], s);
+
+    for (i = 0; i < 10; i++)
+    {
+        h->v[i] = _mm256_set_epi64x(
+            (long long)limbs[3][i], (long long)limbs[2][i], (long long)limbs[1][i], (long long)limbs[0][i]);
+    }
+}
+
+/* f = lane of h, which must be reduced */
+static AVX2_TARGET void fe4_unpack(fe f, const fe4 *h, int lane)
+{
+    uint64_t lanes[4];
+    uint64_t limbs[10];
+    unsigned char s[32];
+    int i;
+
+    for (i = 0; i < 10; i++)
+    {
+        _mm256_storeu_si256((__m256i *)lanes, h->v[i]);
+        limbs[i] = lanes[lane];
+    }
+
+    fe4_limbs_tobytes(s, limbs);
+    fe_frombytes(f, s);
+}
+
+static AVX2_TARGET void fe4_0(fe4 *h)
+{
+    int i;
+
+    for (i = 0; i < 10; i++)
+    {
+        h->v[i] = _mm256_setzero_si256();
+    }
+}
+
+/* h = f + g, without carrying */
+static AVX2_TARGET void fe4_add(fe4 *h, const fe4 *f, const fe4 *g)
+{
+    int i;
+
+    for (i = 0; i < 10; i++)
+    {
+        h->v[i] = _mm256_add_epi64(f->v[i], g->v[i]);
+    }
+}
+
+/* h = f + 2p - g, without carrying. g must be reduced. */
+static AVX2_TARGET void fe4_sub(fe4 *h, const fe4 *f, const fe4 *g)
+{
+    const __m256i p0 = _mm256_set1_epi64x(0x7ffffda);
+    const __m256i even = _mm256_set1_epi64x(0x7fffffe);
+    const __m256i odd = _mm256_set1_epi64x(0x3fffffe);
+    int i;
+
+    h->v[0] = _mm256_sub_epi64(_mm256_add_epi64(f->v[0], p0), g->v[0]);
+
+    for (i = 1; i < 10; i++)
+    {
+        h->v[i] = _mm256_sub_epi64(_mm256_add_epi64(f->v[i], (i & 1) ? odd : even), g->v[i]);
+    }
+}
+
+static AVX2_TARGET void fe4_carry26(fe4 *h, int i)
+{
+    const __m256i c = _mm256_srli_epi64(h->v[i], 26);
+
+    h->v[i + 1] = _mm256_add_epi64(h->v[i + 1], c);
+    h->v[i] = _mm256_and_si256(h->v[i], _mm256_set1_epi64x(0x3ffffff));
+}
+
+static AVX2_TARGET void fe4_carry25(fe4 *h, int i)
+{
+    const __m256i c = _mm256_srli_epi64(h->v[i], 25);
+
+    h->v[i + 1] = _mm256_add_epi64(h->v[i + 1], c);
+    h->v[i] = _mm256_and_si256(h->v[i], _mm256_set1_epi64x(0x1ffffff));
+}
+
+/*
+Carries every limb of h (each below 2^63) so that h is reduced, in the same
+order as the ref10 fe_mul. The carry out of h9 can exceed 32 bits, so it is
+multiplied by 19 with shifts rather than with _mm256_mul_epu32.
+*/
+static AVX2_TARGET void fe4_reduce(fe4 *h)
+{
+    __m256i c;
+
+    fe4_carry26(h, 0);
+    fe4_carry26(h, 4);
+    fe4_carry25(h, 1);
+    fe4_carry25(h, 5);
+    fe4_carry26(h, 2);
+    fe4_carry26(h, 6);
+    fe4_carry25(h, 3);
+    fe4_carry25(h, 7);
+    fe4_carry26(h, 4);
+    fe4_carry26(h, 8);
+
+    c = _mm256_srli_epi64(h->v[9], 25);
+    h->v[9] = _mm256_and_si256(h->v[9], _mm256_set1_epi64x(0x1ffffff));
+    c = _mm256_add_epi64(c, _mm256_add_epi64(_mm256_slli_epi64(c, 1), _mm256_slli_epi64(c, 4)));
+    h->v[0] = _mm256_add_epi64(h->v[0], c);
+
+    fe4_carry26(h, 0);
+}
+
+static AVX2_TARGET __m256i fe4_madd(__m256i h, __m256i f, __m256i g)
+{
+    return _mm256_add_epi64(h, _mm256_mul_epu32(f, g));
+}
+
+/*
+h = f * g
+Can overlap h with f or g.
+
+The same schoolbook product as the ref10 fe_mul: odd x odd limb products are
+doubled, and products that wrap past 2^255 are multiplied by 19.
+*/
+static AVX2_TARGET void fe4_mul(fe4 *h, const fe4 *f, const fe4 *g)
+{
+    const __m256i nineteen = _mm256_set1_epi64x(19);
+    const __m256i f0 = f->v[0];
+    const __m256i f1 = f->v[1];
+    const __m256i f2 = f->v[2];
+    const __m256i f3 = f->v[3];
+    const __m256i f4 = f->v[4];
+    const __m256i f5 = f->v[5];
+    const __m256i f6 = f->v[6];
+    const __m256i f7 = f->v[7];
+    const __m256i f8 = f->v[8];
+    const __m256i f9 = f->v[9];
+    const __m256i g0 = g->v[0];
+    const __m256i g1 = g->v[1];
+    const __m256i g2 = g->v[2];
+    const __m256i g3 = g->v[3];
+    const __m256i g4 = g->v[4];
+    const __m256i g5 = g->v[5];
+    const __m256i g6 = g->v[6];
+    const __m256i g7 = g->v[7];
+    const __m256i g8 = g->v[8];
+    const __m256i g9 = g->v[9];
+    const __m256i f1_2 = _mm256_add_epi64(f1, f1);
+    const __m256i f3_2 = _mm256_add_epi64(f3, f3);
+    const __m256i f5_2 = _mm256_add_epi64(f5, f5);
+    const __m256i f7_2 = _mm256_add_epi64(f7, f7);
+    const __m256i f9_2 = _mm256_add_epi64(f9, f9);
+    const __m256i g1_19 = _mm256_mul_epu32(g1, nineteen);
+    const __m256i g2_19 = _mm256_mul_epu32(g2, nineteen);
+    const __m256i g3_19 = _mm256_mul_epu32(g3, nineteen);
+    const __m256i g4_19 = _mm256_mul_epu32(g4, nineteen);
+    const __m256i g5_19 = _mm256_mul_epu32(g5, nineteen);
+    const __m256i g6_19 = _mm256_mul_epu32(g6, nineteen);
+    const __m256i g7_19 = _mm256_mul_epu32(g7, nineteen);
+    const __m256i g8_19 = _mm256_mul_epu32(g8, nineteen);
+    const __m256i g9_19 = _mm256_mul_epu32(g9, nineteen);
+    __m256i h0, h1, h2, h3, h4, h5, h6, h7, h8, h9;
+
+    h0 = _mm256_mul_epu32(f0, g0);
+    h0 = fe4_madd(h0, f1_2, g9_19);
+    h0 = fe4_madd(h0, f2, g8_19);
+    h0 = fe4_madd(h0, f3_2, g7_19);
+    h0 = fe4_madd(h0, f4, g6_19);
+    h0 = fe4_madd(h0, f5_2, g5_19);
+    h0 = fe4_madd(h0, f6, g4_19);
+    h0 = fe4_madd(h0, f7_2, g3_19);
+    h0 = fe4_madd(h0, f8, g2_19);
+    h0 = fe4_madd(h0, f9_2, g1_19);
+
+    h1 = _mm256_mul_epu32(f0, g1);
+    h1 = fe4_madd(h1, f1, g0);
+    h1 = fe4_madd(h1, f2, g9_19);
+    h1 = fe4_madd(h1, f3, g8_19);
+    h1 = fe4_madd(h1, f4, g7_19);
+    h1 = fe4_madd(h1, f5, g6_19);
+    h1 = fe4_madd(h1, f6, g5_19);
+    h1 = fe4_madd(h1, f7, g4_19);
+    h1 = fe4_madd(h1, f8, g3_19);
+    h1 = fe4_madd(h1, f9, g2_19);
+
+    h2 = _mm256_mul_epu32(f0, g2);
+    h2 = fe4_madd(h2, f1_2, g1);
+    h2 = fe4_madd(h2, f2, g0);
+    h2 = fe4_madd(h2, f3_2, g9_19);
+    h2 = fe4_madd(h2, f4, g8_19);
+    h2 = fe4_madd(h2, f5_2, g7_19);
+    h2 = fe4_madd(h2, f6, g6_19);
+    h2 = fe4_madd(h2, f7_2, g5_19);
+    h2 = fe4_madd(h2, f8, g4_19);
+    h2 = fe4_madd(h2, f9_2, g3_19);
+
+    h3 = _mm256_mul_epu32(f0, g3);
+    h3 = fe4_madd(h3, f1, g2);
+    h3 = fe4_madd(h3, f2, g1);
+    h3 = fe4_madd(h3, f3, g0);
+    h3 = fe4_madd(h3, f4, g9_19);
+    h3 = fe4_madd(h3, f5, g8_19);
+    h3 = fe4_madd(h3, f6, g7_19);
+    h3 = fe4_madd(h3, f7, g6_19);
+    h3 = fe4_madd(h3, f8, g5_19);
+    h3 = fe4_madd(h3, f9, g4_19);
+
+    h4 = _mm256_mul_epu32(f0, g4);
+    h4 = fe4_madd(h4, f1_2, g3);
+    h4 = fe4_madd(h4, f2, g2);
+    h4 = fe4_madd(h4, f3_2, g1);
+    h4 = fe4_madd(h4, f4, g0);
+    h4 = fe4_madd(h4, f5_2, g9_19);
+    h4 = fe4_madd(h4, f6, g8_19);
+    h4 = fe4_madd(h4, f7_2, g7_19);
+    h4 = fe4_madd(h4, f8, g6_19);
+    h4 = fe4_madd(h4, f9_2, g5_19);
+
+    h5 = _mm256_mul_epu32(f0, g5);
+    h5 = fe4_madd(h5, f1, g4);
+    h5 = fe4_madd(h5, f2, g3);
+    h5 = fe4_madd(h5, f3, g2);
+    h5 = fe4_madd(h5, f4, g1);
+    h5 = fe4_madd(h5, f5, g0);
+    h5 = fe4_madd(h5, f6, g9_19);
+    h5 = fe4_madd(h5, f7, g8_19);
+    h5 = fe4_madd(h5, f8, g7_19);
+    h5 = fe4_madd(h5, f9, g6_19);
+
+    h6 = _mm256_mul_epu32(f0, g6);
+    h6 = fe4_madd(h6, f1_2, g5);
+    h6 = fe4_madd(h6, f2, g4);
+    h6 = fe4_madd(h6, f3_2, g3);
+    h6 = fe4_madd(h6, f4, g2);
+    h6 = fe4_madd(h6, f5_2, g1);
+    h6 = fe4_madd(h6, f6, g0);
+    h6 = fe4_madd(h6, f7_2, g9_19);
+    h6 = fe4_madd(h6, f8, g8_19);
+    h6 = fe4_madd(h6, f9_2, g7_19);
+
+    h7 = _mm256_mul_epu32(f0, g7);
+    h7 = fe4_madd(h7, f1, g6);
+    h7 = fe4_madd(h7, f2, g5);
+    h7 = fe4_madd(h7, f3, g4);
+    h7 = fe4_madd(h7, f4, g3);
+    h7 = fe4_madd(h7, f5, g2);
+    h7 = fe4_madd(h7, f6, g1);
+    h7 = fe4_madd(h7, f7, g0);
+    h7 = fe4_madd(h7, f8, g9_19);
+    h7 = fe4_madd(h7, f9, g8_19);
+
+    h8 = _mm256_mul_epu32(f0, g8);
+    h8 = fe4_madd(h8, f1_2, g7);
+    h8 = fe4_madd(h8, f2, g6);
+    h8 = fe4_madd(h8, f3_2, g5);
+    h8 = fe4_madd(h8, f4, g4);
+    h8 = fe4_madd(h8, f5_2, g3);
+    h8 = fe4_madd(h8, f6, g2);
+    h8 = fe4_madd(h8, f7_2, g1);
+    h8 = fe4_madd(h8, f8, g0);
+    h8 = fe4_madd(h8, f9_2, g9_19);
+
+    h9 = _mm256_mul_epu32(f0, g9);
+    h9 = fe4_madd(h9, f1, g8);
+    h9 = fe4_madd(h9, f2, g7);
+    h9 = fe4_madd(h9, f3, g6);
+    h9 = fe4_madd(h9, f4, g5);
+    h9 = fe4_madd(h9, f5, g4);
+    h9 = fe4_madd(h9, f6, g3);
+    h9 = fe4_madd(h9, f7, g2);
+    h9 = fe4_madd(h9, f8, g1);
+    h9 = fe4_madd(h9, f9, g0);
+    h->v[0] = h0;
+    h->v[1] = h1;
+    h->v[2] = h2;
+    h->v[3] = h3;
+    h->v[4] = h4;
+    h->v[5] = h5;
+    h->v[6] = h6;
+    h->v[7] = h7;
+    h->v[8] = h8;
+    h->v[9] = h9;
+
+    fe4_reduce(h);
+}
+
+/*
+h = f * f
+Can overlap h with f.
+
+As fe4_mul, with the symmetric products folded together.
+*/
+static AVX2_TARGET void fe4_sq(fe4 *h, const fe4 *f)
+{
+    const __m256i nineteen = _mm256_set1_epi64x(19);
+    const __m256i f0 = f->v[0];
+    const __m256i f1 = f->v[1];
+    const __m256i f2 = f->v[2];
+    const __m256i f3 = f->v[3];
+    const __m256i f4 = f->v[4];
+    const __m256i f5 = f->v[5];
+    const __m256i f6 = f->v[6];
+    const __m256i f7 = f->v[7];
+    const __m256i f8 = f->v[8];
+    const __m256i f9 = f->v[9];
+    const __m256i f0_2 = _mm256_add_epi64(f0, f0);
+    const __m256i f1_2 = _mm256_add_epi64(f1, f1);
+    const __m256i f2_2 = _mm256_add_epi64(f2, f2);
+    const __m256i f3_2 = _mm256_add_epi64(f3, f3);
+    const __m256i f4_2 = _mm256_add_epi64(f4, f4);
+    const __m256i f5_2 = _mm256_add_epi64(f5, f5);
+    const __m256i f6_2 = _mm256_add_epi64(f6, f6);
+    const __m256i f7_2 = _mm256_add_epi64(f7, f7);
+    const __m256i f8_2 = _mm256_add_epi64(f8, f8);
+    const __m256i f9_2 = _mm256_add_epi64(f9, f9);
+    const __m256i f1_4 = _mm256_add_epi64(f1_2, f1_2);
+    const __m256i f3_4 = _mm256_add_epi64(f3_2, f3_2);
+    const __m256i f5_4 = _mm256_add_epi64(f5_2, f5_2);
+    const __m256i f7_4 = _mm256_add_epi64(f7_2, f7_2);
+    const __m256i f5_19 = _mm256_mul_epu32(f5, nineteen);
+    const __m256i f6_19 = _mm256_mul_epu32(f6, nineteen);
+    const __m256i f7_19 = _mm256_mul_epu32(f7, nineteen);
+    const __m256i f8_19 = _mm256_mul_epu32(f8, nineteen);
+    const __m256i f9_19 = _mm256_mul_epu32(f9, nineteen);
+    __m256i h0, h1, h2, h3, h4, h5, h6, h7, h8, h9;
+
+    h0 = _mm256_mul_epu32(f0, f0);
+    h0 = fe4_madd(h0, f1_4, f9_19);
+    h0 = fe4_madd(h0, f2_2, f8_19);
+    h0 = fe4_madd(h0, f3_4, f7_19);
+    h0 = fe4_madd(h0, f4_2, f6_19);
+    h0 = fe4_madd(h0, f5_2, f5_19);
+
+    h1 = _mm256_mul_epu32(f0_2, f1);
+    h1 = fe4_madd(h1, f2_2, f9_19);
+    h1 = fe4_madd(h1, f3_2, f8_19);
+    h1 = fe4_madd(h1, f4_2, f7_19);
+    h1 = fe4_madd(h1, f5_2, f6_19);
+
+    h2 = _mm256_mul_epu32(f0_2, f2);
+    h2 = fe4_madd(h2, f1_2, f1);
+    h2 = fe4_madd(h2, f3_4, f9_19);
+    h2 = fe4_madd(h2, f4_2, f8_19);
+    h2 = fe4_madd(h2, f5_4, f7_19);
+    h2 = fe4_madd(h2, f6, f6_19);
+
+    h3 = _mm256_mul_epu32(f0_2, f3);
+    h3 = fe4_madd(h3, f1_2, f2);
+    h3 = fe4_madd(h3, f4_2, f9_19);
+    h3 = fe4_madd(h3, f5_2, f8_19);
+    h3 = fe4_madd(h3, f6_2, f7_19);
+
+    h4 = _mm256_mul_epu32(f0_2, f4);
+    h4 = fe4_madd(h4, f1_4, f3);
+    h4 = fe4_madd(h4, f2, f2);
+    h4 = fe4_madd(h4, f5_4, f9_19);
+    h4 = fe4_madd(h4, f6_2, f8_19);
+    h4 = fe4_madd(h4, f7_2, f7_19);
+
+    h5 = _mm256_mul_epu32(f0_2, f5);
+    h5 = fe4_madd(h5, f1_2, f4);
+    h5 = fe4_madd(h5, f2_2, f3);
+    h5 = fe4_madd(h5, f6_2, f9_19);
+    h5 = fe4_madd(h5, f7_2, f8_19);
+
+    h6 = _mm256_mul_epu32(f0_2, f6);
+    h6 = fe4_madd(h6, f1_4, f5);
+    h6 = fe4_madd(h6, f2_2, f4);
+    h6 = fe4_madd(h6, f3_2, f3);
+    h6 = fe4_madd(h6, f7_4, f9_19);
+    h6 = fe4_madd(h6, f8, f8_19);
+
+    h7 = _mm256_mul_epu32(f0_2, f7);
+    h7 = fe4_madd(h7, f1_2, f6);
+    h7 = fe4_madd(h7, f2_2, f5);
+    h7 = fe4_madd(h7, f3_2, f4);
+    h7 = fe4_madd(h7, f8_2, f9_19);
+
+    h8 = _mm256_mul_epu32(f0_2, f8);
+    h8 = fe4_madd(h8, f1_4, f7);
+    h8 = fe4_madd(h8, f2_2, f6);
+    h8 = fe4_madd(h8, f3_4, f5);
+    h8 = fe4_madd(h8, f4, f4);
+    h8 = fe4_madd(h8, f9_2, f9_19);
+
+    h9 = _mm256_mul_epu32(f0_2, f9);
+    h9 = fe4_madd(h9, f1_2, f8);
+    h9 = fe4_madd(h9, f2_2, f7);
+    h9 = fe4_madd(h9, f3_2, f6);
+    h9 = fe4_madd(h9, f4_2, f5);
+    h->v[0] = h0;
+    h->v[1] = h1;
+    h->v[2] = h2;
+    h->v[3] = h3;
+    h->v[4] = h4;
+    h->v[5] = h5;
+    h->v[6] = h6;
+    h->v[7] = h7;
+    h->v[8] = h8;
+    h->v[9] = h9;
+
+    fe4_reduce(h);
+}
+
+/*
+Replace f with g if b == 1;
+leave f unchanged if b == 0.
+
+Preconditions: b in {0,1}.
+*/
+static AVX2_TARGET void fe4_cmov(fe4 *f, const fe4 *g, unsigned int b)
+{
+    const __m256i mask = _mm256_set1_epi64x(-(long long)b);
+    int i;
+
+    for (i = 0; i < 10; i++)
+    {
+        f->v[i] = _mm256_blendv_epi8(f->v[i], g->v[i], mask);
+    }
+}
+
+/*
+Points are held as (X, Y, Z, T) and cached points, the second operand of an
+addition, as (Y - X, Y + X, 2Z, 2dT).
+*/
+
+/* The neutral element, (0, 1, 1, 0) */
+static AVX2_TARGET void ge4_0(fe4 *h)
+{
+    fe4_0(h);
+
+    h->v[0] = _mm256_set_epi64x(0, 1, 1, 0);
+}
+
+/* The neutral element as a cached point, (1, 1, 2, 0) */
+static AVX2_TARGET void ge4_cached_0(fe4 *h)
+{
+    fe4_0(h);
+
+    h->v[0] = _mm256_set_epi64x(0, 2, 1, 1);
+}
+
+/* (1, 1, 1, d), used to turn (Y - X, Y + X, 2Z, 2T) into a cached point */
+static AVX2_TARGET void ge4_cached_scale(fe4 *h)
+{
+    static const unsigned char d[32] = {0xa3, 0x78, 0x59, 0x13, 0xca, 0x4d, 0xeb, 0x75, 0xab, 0xd8, 0x41,
+                                        0x41, 0x4d, 0x0a, 0x70, 0x00, 0x98, 0xe8, 0x79, 0x77, 0x79, 0x40,
+                                        0xc7, 0x8c, 0x73, 0xfe, 0x6f, 0x2b, 0xee, 0x6c, 0x03, 0x52};
+    uint64_t limbs[10];
+    int i;
+
+    fe4_limbs_frombytes(limbs, d);
+
+    h->v[0] = _mm256_set_epi64x((long long)limbs[0], 1, 1, 1);
+
+    for (i = 1; i < 10; i++)
+    {
+        h->v[i] = _mm256_set_epi64x((long long)limbs[i], 0, 0, 0);
+    }
+}
+
+/* r = 2 * p */
+static AVX2_TARGET void ge4_dbl(fe4 *r, const fe4 *p)
+{
+    fe4 zero, s, n, s1, s2, t, u;
+
+    fe4_0(&zero);
+
+    FE4_PERMUTE(&t, p, FE4_LANES(1, 0, 2, 3));
+    fe4_add(&t, p, &t);
+    FE4_PERMUTE(&t, &t, FE4_LANES(0, 0, 0, 0));
+    FE4_SELECT(&u, p, &t, FE4_BLEND(0, 0, 0, 1));
+
+    /* (S1, S2, S3, S4) = (X^2, Y^2, Z^2, (X + Y)^2) */
+    fe4_sq(&s, &u);
+    fe4_sub(&n, &zero, &s);
+
+    FE4_PERMUTE(&s1, &s, FE4_LANES(0, 0, 0, 0));
+    FE4_PERMUTE(&s2, &s, FE4_LANES(1, 1, 1, 1));
+
+    /* (0, 0, 2 * S3, -S4) */
+    fe4_add(&t, &s, &s);
+    FE4_SELECT(&t, &zero, &t, FE4_BLEND(0, 0, 1, 0));
+    FE4_SELECT(&t, &t, &n, FE4_BLEND(0, 0, 0, 1));
+
+    /* (S1 + S2, S1 - S2, S1 - S2 + 2 * S3, S1 + S2 - S4) = (H, G, F, E) */
+    fe4_add(&t, &t, &s1);
+    FE4_SELECT(&u, &zero, &s2, FE4_BLEND(1, 0, 0, 1));
+    fe4_add(&t, &t, &u);
+    FE4_PERMUTE(&n, &n, FE4_LANES(1, 1, 1, 1));
+    FE4_SELECT(&u, &zero, &n, FE4_BLEND(0, 1, 1, 0));
+    fe4_add(&t, &t, &u);
+    fe4_reduce(&t);
+
+    /* (E, G, G, E) * (F, H, F, H) = (X3, Y3, Z3, T3) */
+    FE4_PERMUTE(&u, &t, FE4_LANES(3, 1, 1, 3));
+    FE4_PERMUTE(&t, &t, FE4_LANES(2, 0, 2, 0));
+    fe4_mul(r, &u, &t);
+}
+
+/* r = p + q, where q is a cached point */
+static AVX2_TARGET void ge4_add(fe4 *r, const fe4 *p, const fe4 *q)
+{
+    fe4 s, t, u;
+
+    /* (Y - X, Y + X, Z, T) */
+    FE4_PERMUTE(&t, p, FE4_LANES(1, 0, 2, 3));
+    fe4_add(&s, &t, p);
+    fe4_sub(&u, &t, p);
+    FE4_SELECT(&u, &u, &s, FE4_BLEND(0, 1, 0, 0));
+    FE4_SELECT(&u, &u, p, FE4_BLEND(0, 0, 1, 1));
+
+    /* (A, B, D, C) */
+    fe4_mul(&u, &u, q);
+
+    /* (B - A, B + A, D + C, D - C) = (E, H, G, F) */
+    FE4_PERMUTE(&t, &u, FE4_LANES(1, 0, 3, 2));
+    fe4_add(&s, &u, &t);
+    fe4_sub(&t, &t, &u);
+    FE4_SELECT(&t, &t, &s, FE4_BLEND(0, 1, 1, 0));
+
+    /* (E, G, F, E) * (F, H, G, H) = (X3, Y3, Z3, T3) */
+    FE4_PERMUTE(&u, &t, FE4_LANES(0, 2, 3, 0));
+    FE4_PERMUTE(&t, &t, FE4_LANES(3, 1, 2, 1));
+    fe4_mul(r, &u, &t);
+}
+
+/* r = p as a cached point */
+static AVX2_TARGET void ge4_to_cached(fe4 *r, const fe4 *p, const fe4 *scale)
+{
+    fe4 s, t;
+
+    /* (Y - X, Y + X, 2Z, 2T) */
+    FE4_PERMUTE(&t, p, FE4_LANES(1, 0, 2, 3));
+    fe4_add(&s, &t, p);
+    fe4_sub(&t, &t, p);
+    FE4_SELECT(&t, &s, &t, FE4_BLEND(1, 0, 0, 0));
+
+    fe4_mul(r, &t, scale);
+}
+
+/* r = -q, both cached points */
+static AVX2_TARGET void ge4_cached_neg(fe4 *r, const fe4 *q)
+{
+    fe4 n, t;
+
+    FE4_PERMUTE(&t, q, FE4_LANES(1, 0, 2, 3));
+    fe4_0(&n);
+    fe4_sub(&n, &n, &t);
+    FE4_SELECT(r, &t, &n, FE4_BLEND(0, 0, 0, 1));
+}
+
+static AVX2_TARGET void ge4_from_p3(fe4 *r, const ge_p3 *p)
+{
+    fe4_pack(r, p->X, p->Y, p->Z, p->T);
+}
+
+static AVX2_TARGET void ge4_to_p2(ge_p2 *r, const fe4 *p)
+{
+    fe4_unpack(r->X, p, 0);
+    fe4_unpack(r->Y, p, 1);
+    fe4_unpack(r->Z, p, 2);
+}
+
+/* r = A, 3A, 5A, ..., 15A and rneg their negations, see ge_dsm_precomp.c */
+static AVX2_TARGET void ge4_dsm_precomp(fe4 *r, fe4 *rneg, const ge_p3 *s)
+{
+    fe4 scale, p, p2, u;
+    int i;
+
+    ge4_cached_scale(&scale);
+    ge4_from_p3(&p, s);
+
+    ge4_to_cached(&r[0], &p, &scale);
+    ge4_dbl(&p2, &p);
+
+    for (i = 0; i < 7; i++)
+    {
+        ge4_add(&u, &p2, &r[i]);
+        ge4_to_cached(&r[i + 1], &u, &scale);
+    }
+
+    for (i = 0; i < 8; i++)
+    {
+        ge4_cached_neg(&rneg[i], &r[i]);
+    }
+}
+
+/* The sliding window loop shared by both double scalar multiplications */
+static AVX2_TARGET void ge4_double_scalarmult_vartime(
+    ge_p2 *r,
+    const unsigned char *a,
+    const ge_p3 *A,
+    const unsigned char *b,
+    const fe4 *Bi,
+    const fe4 *Bineg)
+{
+    signed char aslide[256];
+    signed char bslide[256];
+    fe4 Ai[8]; /* A, 3A, 5A, 7A, 9A, 11A, 13A, 15A */
+    fe4 Aineg[8];
+    fe4 p;
+    int i;
+
+    slide(aslide, a);
+    slide(bslide, b);
+    ge4_dsm_precomp(Ai, Aineg, A);
+
+    ge4_0(&p);
+
+    for (i = 255; i >= 0; --i)
+    {
+        if (aslide[i] || bslide[i])
+            break;
+    }
+
+    for (; i >= 0; --i)
+    {
+        ge4_dbl(&p, &p);
+
+        if (aslide[i] > 0)
+        {
+            ge4_add(&p, &p, &Ai[aslide[i] / 2]);
+        }
+        else if (aslide[i] < 0)
+        {
+            ge4_add(&p, &p, &Aineg[(-aslide[i]) / 2]);
+        }
+
+        if (bslide[i] > 0)
+        {
+            ge4_add(&p, &p, &Bi[bslide[i] / 2]);
+        }
+        else if (bslide[i] < 0)
+        {
+            ge4_add(&p, &p, &Bineg[(-bslide[i]) / 2]);
+        }
+    }
+
+    ge4_to_p2(r, &p);
+}
+
+int ge_avx2_supported(void)
+{
+    return __builtin_cpu_supports("avx2") ? 1 : 0;
+}
+
+/* See ge_scalarmult.c, a[31] <= 127 */
+AVX2_TARGET void ge_scalarmult_avx2(ge_p2 *r, const unsigned char *a, const ge_p3 *A)
+{
+    signed char e[64];
+    int carry, carry2, i, j;
+    fe4 Ai[8]; /* 1 * A, 2 * A, ..., 8 * A */
+    fe4 scale, p, u, cur, minuscur;
+
+    carry = 0; /* 0..1 */
+    for (i = 0; i < 31; i++)
+    {
+        carry += a[i]; /* 0..256 */
+        carry2 = (carry + 8) >> 4; /* 0..16 */
+        e[2 * i] = carry - (carry2 << 4); /* -8..7 */
+        carry = (carry2 + 8) >> 4; /* 0..1 */
+        e[2 * i + 1] = carry2 - (carry << 4); /* -8..7 */
+    }
+    carry += a[31]; /* 0..128 */
+    carry2 = (carry + 8) >> 4; /* 0..8 */
+    e[62] = carry - (carry2 << 4); /* -8..7 */
+    e[63] = carry2; /* 0..8 */
+
+    ge4_cached_scale(&scale);
+    ge4_from_p3(&p, A);
+    ge4_to_cached(&Ai[0], &p, &scale);
+
+    for (i = 0; i < 7; i++)
+    {
+        ge4_add(&u, &p, &Ai[i]);
+        ge4_to_cached(&Ai[i + 1], &u, &scale);
+    }
+
+    ge4_0(&p);
+
+    for (i = 63; i >= 0; i--)
+    {
+        signed char b = e[i];
+        unsigned char bnegative = negative(b);
+        unsigned char babs = b - (((-bnegative) & b) << 1);
+
+        ge4_dbl(&p, &p);
+        ge4_dbl(&p, &p);
+        ge4_dbl(&p, &p);
+        ge4_dbl(&p, &p);
+
+        ge4_cached_0(&cur);
+
+        for (j = 0; j < 8; j++)
+        {
+            fe4_cmov(&cur, &Ai[j], equal(babs, j + 1));
+        }
+
+        ge4_cached_neg(&minuscur, &cur);
+        fe4_cmov(&cur, &minuscur, bnegative);
+        ge4_add(&p, &p, &cur);
+    }
+
+    ge4_to_p2(r, &p);
+}
+
+/* See ge_double_scalarmult_base_vartime.c, Bi holds B, 3B, 5B, ..., 15B */
+AVX2_TARGET void ge_double_scalarmult_base_vartime_avx2(
+    ge_p2 *r,
+    const unsigned char *a,
+    const ge_p3 *A,
+    const unsigned char *b,
+    const ge_precomp Bi[8])
+{
+    fe4 Bc[8];
+    fe4 Bcneg[8];
+    fe two;
+    int i;
+
+    fe_1(two);
+    fe_add(two, two, two);
+
+    for (i = 0; i < 8; i++)
+    {
+        fe4_pack(&Bc[i], Bi[i].yminusx, Bi[i].yplusx, two, Bi[i].xy2d);
+        ge4_cached_neg(&Bcneg[i], &Bc[i]);
+    }
+
+    ge4_double_scalarmult_vartime(r, a, A, b, Bc, Bcneg);
+}
+
+/* See ge_double_scalarmult_precomp_vartime.c */
+AVX2_TARGET void ge_double_scalarmult_precomp_vartime_avx2(
+    ge_p2 *r,
+    const unsigned char *a,
+    const ge_p3 *A,
+    const unsigned char *b,
+    const ge_dsmp Bi)
+{
+    fe4 Bc[8];
+    fe4 Bcneg[8];
+    fe z2;
+    int i;
+
+    for (i = 0; i < 8; i++)
+    {
+        fe_add(z2, Bi[i].Z, Bi[i].Z);
+        fe4_pack(&Bc[i], Bi[i].YminusX, Bi[i].YplusX, z2, Bi[i].T2d);
+        ge4_cached_neg(&Bcneg[i], &Bc[i]);
+    }
+
+    ge4_double_scalarmult_vartime(r, a, A, b, Bc, Bcneg);
+}
+
+#endif
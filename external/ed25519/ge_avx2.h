@@ -0,0 +1,40 @@
+// Copyright (c) 2020, The TurtleCoin Developers
+//
+// Please see the included LICENSE file for more information.
+
+#ifndef ED25519_GE_AVX2_H
+#define ED25519_GE_AVX2_H
+
+#include "ge.h"
+
+/*
+The AVX2 engine keeps the four coordinates (X, Y, Z, T) of an extended point in
+the four 64-bit lanes of each vector and evaluates the parallel Edwards formulas
+of Hisil, Wong, Carter and Dawson, so that every field multiplication in an
+addition or doubling runs four at a time. It is compiled on x86_64 with GCC or
+Clang unless ED25519_NO_AVX2 is defined, and is only used once CPUID reports
+that the processor (and OS) support AVX2.
+*/
+#if !defined(ED25519_NO_AVX2) && defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define ED25519_AVX2
+
+int ge_avx2_supported(void);
+
+void ge_scalarmult_avx2(ge_p2 *r, const unsigned char *a, const ge_p3 *A);
+
+void ge_double_scalarmult_base_vartime_avx2(
+    ge_p2 *r,
+    const unsigned char *a,
+    const ge_p3 *A,
+    const unsigned char *b,
+    const ge_precomp Bi[8]);
+
+void ge_double_scalarmult_precomp_vartime_avx2(
+    ge_p2 *r,
+    const unsigned char *a,
+    const ge_p3 *A,
+    const unsigned char *b,
+    const ge_dsmp Bi);
+#endif
+
+#endif // ED25519_GE_AVX2_H
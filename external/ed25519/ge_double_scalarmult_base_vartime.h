@@ -8,6 +8,7 @@
 
 #include "ge.h"
 #include "ge_add.h"
+#include "ge_avx2.h"
 #include "ge_dsm_precomp.h"
 #include "ge_madd.h"
 #include "ge_msub.h"
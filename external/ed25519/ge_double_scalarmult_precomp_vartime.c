@@ -19,6 +19,14 @@ void ge_double_scalarmult_precomp_vartime(
     ge_p3 u;
     int i;
 
+#if defined(ED25519_AVX2)
+    if (ge_avx2_supported())
+    {
+        ge_double_scalarmult_precomp_vartime_avx2(r, a, A, b, Bi);
+        return;
+    }
+#endif
+
     slide(aslide, a);
     slide(bslide, b);
     ge_dsm_precomp(Ai, A);
@@ -7,6 +7,7 @@
 #define ED25519_GE_DOUBLE_SCALARMULT_PRECOMP_VARTIME_H
 
 #include "ge.h"
+#include "ge_avx2.h"
 #include "ge_dsm_precomp.h"
 #include "ge_p1p1_to_p2.h"
 #include "ge_p2_0.h"
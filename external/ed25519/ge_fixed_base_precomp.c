@@ -0,0 +1,79 @@
+// Copyright (c) 2012-2017, The CryptoNote Developers, The Bytecoin Developers
+// Copyright (c) 2020, The TurtleCoin Developers
+//
+// Please see the included LICENSE file for more information.
+
+#include "ge_fixed_base_precomp.h"
+
+/*
+r = p in the affine form used by ge_madd, given recip = 1 / Z
+*/
+
+static void precomp_from_cached(ge_precomp *r, const ge_cached *p, const fe recip)
+{
+    fe_mul(r->yplusx, p->YplusX, recip);
+    fe_mul(r->yminusx, p->YminusX, recip);
+    fe_mul(r->xy2d, p->T2d, recip);
+}
+
+/*
+r[i][j] = (j + 1) * 256^i * A
+
+This is the same layout as the table ge_scalarmult_base uses for the base
+point, so that ge_scalarmult_fixed_base can multiply A at the same cost.
+Each row of eight multiples is brought to affine form with one shared
+inversion.
+*/
+
+void ge_fixed_base_precomp(ge_fixed_base r, const ge_p3 *A)
+{
+    ge_cached row[8];
+    fe products[8];
+    fe inverse;
+    fe recip;
+    ge_p1p1 t;
+    ge_p2 s;
+    ge_p3 base;
+    ge_p3 u;
+    int i, j;
+
+    base = *A;
+
+    for (i = 0; i < 32; i++)
+    {
+        ge_p3_to_cached(&row[0], &base);
+        ge_p3_dbl(&t, &base);
+        ge_p1p1_to_p3(&u, &t);
+        ge_p3_to_cached(&row[1], &u);
+        for (j = 2; j < 8; j++)
+        {
+            ge_add(&t, &u, &row[0]);
+            ge_p1p1_to_p3(&u, &t);
+            ge_p3_to_cached(&row[j], &u);
+        }
+
+        fe_copy(products[0], row[0].Z);
+        for (j = 1; j < 8; j++)
+        {
+            fe_mul(products[j], products[j - 1], row[j].Z);
+        }
+        fe_invert(inverse, products[7]);
+        for (j = 7; j > 0; j--)
+        {
+            /* inverse holds 1 / (Z0 * ... * Zj) */
+            fe_mul(recip, inverse, products[j - 1]);
+            fe_mul(inverse, inverse, row[j].Z);
+            precomp_from_cached(&r[i][j], &row[j], recip);
+        }
+        precomp_from_cached(&r[i][0], &row[0], inverse);
+
+        /* base = 256 * base */
+        ge_p3_dbl(&t, &base);
+        for (j = 0; j < 7; j++)
+        {
+            ge_p1p1_to_p2(&s, &t);
+            ge_p2_dbl(&t, &s);
+        }
+        ge_p1p1_to_p3(&base, &t);
+    }
+}
@@ -0,0 +1,22 @@
+// Copyright (c) 2012-2017, The CryptoNote Developers, The Bytecoin Developers
+// Copyright (c) 2020, The TurtleCoin Developers
+//
+// Please see the included LICENSE file for more information.
+
+#ifndef ED25519_GE_FIXED_BASE_PRECOMP_H
+#define ED25519_GE_FIXED_BASE_PRECOMP_H
+
+#include "fe_copy.h"
+#include "fe_invert.h"
+#include "fe_mul.h"
+#include "ge.h"
+#include "ge_add.h"
+#include "ge_p1p1_to_p2.h"
+#include "ge_p1p1_to_p3.h"
+#include "ge_p2_dbl.h"
+#include "ge_p3_dbl.h"
+#include "ge_p3_to_cached.h"
+
+void ge_fixed_base_precomp(ge_fixed_base r, const ge_p3 *A);
+
+#endif // ED25519_GE_FIXED_BASE_PRECOMP_H
@@ -7,11 +7,19 @@
 
 /* sqrt(x) is such an integer y that 0 <= y <= p - 1, y % 2 = 0, and y^2 = x (mod p). */
 /* d = -121665 / 121666 */
+#if defined(ED25519_FE_51)
+static const fe fe_d =
+    {0x34dca135978a3, 0x1a8283b156ebd, 0x5e7a26001c029, 0x739c663a03cbb, 0x52036cee2b6ff}; /* d */
+
+static const fe fe_sqrtm1 =
+    {0x61b274a0ea0b0, 0x0d5a5fc8f189d, 0x7ef5e9cbd0c60, 0x78595a6804c9e, 0x2b8324804fc1d}; /* sqrt(-1) */
+#else
 static const fe fe_d =
     {-10913610, 13857413, -15372611, 6949391, 114729, -8787816, -6275908, -3247719, -18696448, -12055116}; /* d */
 
 static const fe fe_sqrtm1 =
     {-32595792, -7943725, 9377950, 3500415, 12389472, -272473, -25146209, -2005654, 326686, 11406482}; /* sqrt(-1) */
+#endif
 
 int ge_frombytes_vartime(ge_p3 *h, const unsigned char *s)
 {
@@ -7,6 +7,30 @@
 
 /* sqrt(x) is such an integer y that 0 <= y <= p - 1, y % 2 = 0, and y^2 = x (mod p). */
 /* d = -121665 / 121666 */
+#if defined(ED25519_FE_51)
+static const fe fe_d =
+    {0x34dca135978a3, 0x1a8283b156ebd, 0x5e7a26001c029, 0x739c663a03cbb, 0x52036cee2b6ff}; /* d */
+
+static const fe fe_sqrtm1 =
+    {0x61b274a0ea0b0, 0x0d5a5fc8f189d, 0x7ef5e9cbd0c60, 0x78595a6804c9e, 0x2b8324804fc1d}; /* sqrt(-1) */
+
+static const fe fe_ma = {0x7fffffff892e7, 0x7ffffffffffff, 0x7ffffffffffff, 0x7ffffffffffff, 0x7ffffffffffff}; /* -A */
+
+static const fe fe_ma2 =
+    {0x7ffc8db3de3c9, 0x7ffffffffffff, 0x7ffffffffffff, 0x7ffffffffffff, 0x7ffffffffffff}; /* -A^2 */
+
+static const fe fe_fffb1 =
+    {0x76975321c41ee, 0x517254e71a454, 0x7ec678f465012, 0x58b9054e29ba0, 0x7e71fbefdad61}; /* sqrt(-2 * A * (A + 2)) */
+
+static const fe fe_fffb2 =
+    {0x66483607c9ae0, 0x0c08adefbfa5b, 0x0597ef947780d, 0x67b48ea28dbe0, 0x4d061e0a045a2}; /* sqrt(2 * A * (A + 2)) */
+
+static const fe fe_fffb3 =
+    {0x37d8717302c66, 0x1d4b2c8452b03, 0x4368bb50093fd, 0x477dc4aa3201f, 0x674a110d14c20}; /* sqrt(-sqrt(-1) * A * (A + 2)) */
+
+static const fe fe_fffb4 =
+    {0x51903b6b39186, 0x11427e94930a7, 0x3dd0cbbb91bf0, 0x5fc93607a443f, 0x1a43f3031067d}; /* sqrt(sqrt(-1) * A * (A + 2)) */
+#else
 static const fe fe_d =
     {-10913610, 13857413, -15372611, 6949391, 114729, -8787816, -6275908, -3247719, -18696448, -12055116}; /* d */
 
@@ -60,6 +84,7 @@ static const fe fe_fffb4 = {-21786234,
                             -8444712,
                             3212926,
                             6885324}; /* sqrt(sqrt(-1) * A * (A + 2)) */
+#endif
 
 void ge_fromfe_frombytes_vartime(ge_p2 *r, const unsigned char *s)
 {
@@ -68,6 +93,16 @@ void ge_fromfe_frombytes_vartime(ge_p2 *r, const unsigned char *s)
 
     /* From fe_frombytes.c */
 
+#if defined(ED25519_FE_51)
+    /* Unlike fe_frombytes, bit 255 is kept and folded back in as 19 */
+    u[0] = load_8(s) & FE51_MASK;
+    u[1] = (load_8(s + 6) >> 3) & FE51_MASK;
+    u[2] = (load_8(s + 12) >> 6) & FE51_MASK;
+    u[3] = (load_8(s + 19) >> 1) & FE51_MASK;
+    u[4] = load_8(s + 24) >> 12;
+    u[0] += (u[4] >> 51) * 19;
+    u[4] &= FE51_MASK;
+#else
     int64_t h0 = load_4(s);
     int64_t h1 = load_3(s + 4) << 6;
     int64_t h2 = load_3(s + 7) << 5;
@@ -131,6 +166,7 @@ void ge_fromfe_frombytes_vartime(ge_p2 *r, const unsigned char *s)
     u[7] = (int32_t)h7;
     u[8] = (int32_t)h8;
     u[9] = (int32_t)h9;
+#endif
 
     /* End fe_frombytes.c */
 
@@ -19,6 +19,7 @@
 #include "fe_sq2.h"
 #include "fe_sub.h"
 #include "ge.h"
+#include "load_8.h"
 #include "sc.h"
 
 #include <assert.h>
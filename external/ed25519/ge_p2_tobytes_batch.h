@@ -0,0 +1,26 @@
+// Copyright (c) 2020, The TurtleCoin Developers
+//
+// Please see the included LICENSE file for more information.
+
+#ifndef ED25519_GE_P2_TOBYTES_BATCH_H
+#define ED25519_GE_P2_TOBYTES_BATCH_H
+
+#include "fe_0.h"
+#include "fe_1.h"
+#include "fe_cmov.h"
+#include "fe_copy.h"
+#include "fe_invert.h"
+#include "fe_isnegative.h"
+#include "fe_isnonzero.h"
+#include "fe_mul.h"
+#include "fe_tobytes.h"
+#include "ge.h"
+
+#include <stddef.h>
+
+/* The number of points that share each field inversion */
+#define GE_P2_TOBYTES_BATCH 64
+
+void ge_p2_tobytes_batch(unsigned char (*out)[32], const ge_p2 *in, size_t n);
+
+#endif // ED25519_GE_P2_TOBYTES_BATCH_H
@@ -5,8 +5,13 @@
 
 #include "ge_p3_to_cached.h"
 
+#if defined(ED25519_FE_51)
+static const fe fe_d2 =
+    {0x69b9426b2f159, 0x35050762add7a, 0x3cf44c0038052, 0x6738cc7407977, 0x2406d9dc56dff}; /* 2 * d */
+#else
 static const fe fe_d2 =
     {-21827239, -5839606, -30745221, 13898782, 229458, 15978800, -12551817, -6495438, 29715968, 9444199}; /* 2 * d */
+#endif
 
 /*
 r = p
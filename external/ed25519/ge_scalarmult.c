@@ -14,6 +14,14 @@ void ge_scalarmult(ge_p2 *r, const unsigned char *a, const ge_p3 *A)
     ge_p1p1 t;
     ge_p3 u;
 
+#if defined(ED25519_AVX2)
+    if (ge_avx2_supported())
+    {
+        ge_scalarmult_avx2(r, a, A);
+        return;
+    }
+#endif
+
     carry = 0; /* 0..1 */
     for (i = 0; i < 31; i++)
     {
@@ -11,6 +11,7 @@
 #include "fe_neg.h"
 #include "ge.h"
 #include "ge_add.h"
+#include "ge_avx2.h"
 #include "ge_cached_0.h"
 #include "ge_cached_cmov.h"
 #include "ge_p1p1_to_p2.h"
@@ -0,0 +1,89 @@
+// Copyright (c) 2012-2017, The CryptoNote Developers, The Bytecoin Developers
+// Copyright (c) 2020, The TurtleCoin Developers
+//
+// Please see the included LICENSE file for more information.
+
+#include "ge_scalarmult_fixed_base.h"
+
+static void select(ge_precomp *t, const ge_fixed_base table, int pos, signed char b)
+{
+    ge_precomp minust;
+    unsigned char bnegative = negative(b);
+    unsigned char babs = b - (((-bnegative) & b) << 1);
+
+    ge_precomp_0(t);
+    ge_precomp_cmov(t, &table[pos][0], equal(babs, 1));
+    ge_precomp_cmov(t, &table[pos][1], equal(babs, 2));
+    ge_precomp_cmov(t, &table[pos][2], equal(babs, 3));
+    ge_precomp_cmov(t, &table[pos][3], equal(babs, 4));
+    ge_precomp_cmov(t, &table[pos][4], equal(babs, 5));
+    ge_precomp_cmov(t, &table[pos][5], equal(babs, 6));
+    ge_precomp_cmov(t, &table[pos][6], equal(babs, 7));
+    ge_precomp_cmov(t, &table[pos][7], equal(babs, 8));
+    fe_copy(minust.yplusx, t->yminusx);
+    fe_copy(minust.yminusx, t->yplusx);
+    fe_neg(minust.xy2d, t->xy2d);
+    ge_precomp_cmov(t, &minust, bnegative);
+}
+
+/*
+h = a * A
+where a = a[0]+256*a[1]+...+256^31 a[31]
+and table was filled in for A by ge_fixed_base_precomp.
+
+Preconditions:
+  a[31] <= 127
+*/
+
+void ge_scalarmult_fixed_base(ge_p3 *h, const unsigned char *a, const ge_fixed_base table)
+{
+    signed char e[64];
+    signed char carry;
+    ge_p1p1 r;
+    ge_p2 s;
+    ge_precomp t;
+    int i;
+
+    for (i = 0; i < 32; ++i)
+    {
+        e[2 * i + 0] = (a[i] >> 0) & 15;
+        e[2 * i + 1] = (a[i] >> 4) & 15;
+    }
+    /* each e[i] is between 0 and 15 */
+    /* e[63] is between 0 and 7 */
+
+    carry = 0;
+    for (i = 0; i < 63; ++i)
+    {
+        e[i] += carry;
+        carry = e[i] + 8;
+        carry >>= 4;
+        e[i] -= carry << 4;
+    }
+    e[63] += carry;
+    /* each e[i] is between -8 and 8 */
+
+    ge_p3_0(h);
+    for (i = 1; i < 64; i += 2)
+    {
+        select(&t, table, i / 2, e[i]);
+        ge_madd(&r, h, &t);
+        ge_p1p1_to_p3(h, &r);
+    }
+
+    ge_p3_dbl(&r, h);
+    ge_p1p1_to_p2(&s, &r);
+    ge_p2_dbl(&r, &s);
+    ge_p1p1_to_p2(&s, &r);
+    ge_p2_dbl(&r, &s);
+    ge_p1p1_to_p2(&s, &r);
+    ge_p2_dbl(&r, &s);
+    ge_p1p1_to_p3(h, &r);
+
+    for (i = 0; i < 64; i += 2)
+    {
+        select(&t, table, i / 2, e[i]);
+        ge_madd(&r, h, &t);
+        ge_p1p1_to_p3(h, &r);
+    }
+}
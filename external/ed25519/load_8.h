@@ -0,0 +1,13 @@
+// Copyright (c) 2012-2017, The CryptoNote Developers, The Bytecoin Developers
+// Copyright (c) 2020, The TurtleCoin Developers
+//
+// Please see the included LICENSE file for more information.
+
+#ifndef ED25519_LOAD_8_H
+#define ED25519_LOAD_8_H
+
+#include <stdint.h>
+
+uint64_t load_8(const unsigned char *in);
+
+#endif // ED25519_LOAD_8_H
@@ -0,0 +1,390 @@
+// Copyright (c) 2020, The TurtleCoin Developers
+//
+// Please see the included LICENSE file for more information.
+
+#include "sc64.h"
+
+#if defined(ED25519_SC64)
+
+#include <stdint.h>
+
+typedef unsigned __int128 sc64_uint128;
+
+/* l = 2^252 + 27742317777372353535851937790883648493 */
+static const uint64_t L[4] = {0x5812631a5cf5d3edULL, 0x14def9dea2f79cd6ULL, 0x0000000000000000ULL, 0x1000000000000000ULL};
+
+static void sc64_load(uint64_t *r, const unsigned char *s, int limbs)
+{
+    int i;
+
+    for (i = 0; i < limbs; i++)
+    {
+        r[i] = (uint64_t)s[8 * i] | ((uint64_t)s[8 * i + 1] << 8) | ((uint64_t)s[8 * i + 2] << 16)
+               | ((uint64_t)s[8 * i + 3] << 24) | ((uint64_t)s[8 * i + 4] << 32) | ((uint64_t)s[8 * i + 5] << 40)
+               | ((uint64_t)s[8 * i + 6] << 48) | ((uint64_t)s[8 * i + 7] << 56);
+    }
+}
+
+static void sc64_store(unsigned char *s, const uint64_t r[4])
+{
+    int i;
+
+    for (i = 0; i < 4; i++)
+    {
+        s[8 * i] = (unsigned char)r[i];
+        s[8 * i + 1] = (unsigned char)(r[i] >> 8);
+        s[8 * i + 2] = (unsigned char)(r[i] >> 16);
+        s[8 * i + 3] = (unsigned char)(r[i] >> 24);
+        s[8 * i + 4] = (unsigned char)(r[i] >> 32);
+        s[8 * i + 5] = (unsigned char)(r[i] >> 40);
+        s[8 * i + 6] = (unsigned char)(r[i] >> 48);
+        s[8 * i + 7] = (unsigned char)(r[i] >> 56);
+    }
+}
+
+/* p = a * b */
+static void sc64_mul_4x4(uint64_t p[8], const uint64_t a[4], const uint64_t b[4])
+{
+    sc64_uint128 t;
+    uint64_t carry;
+    int i;
+    int j;
+
+    for (i = 0; i < 8; i++)
+    {
+        p[i] = 0;
+    }
+
+    for (i = 0; i < 4; i++)
+    {
+        carry = 0;
+
+        for (j = 0; j < 4; j++)
+        {
+            t = (sc64_uint128)a[i] * b[j] + p[i + j] + carry;
+            p[i + j] = (uint64_t)t;
+            carry = (uint64_t)(t >> 64);
+        }
+
+        p[i + 4] = carry;
+    }
+}
+
+/* r = x * (l - 2^252), for x of n limbs and r of n + 2 limbs */
+static void sc64_mul_delta(uint64_t *r, const uint64_t *x, int n)
+{
+    sc64_uint128 t;
+    uint64_t carry;
+    int i;
+
+    carry = 0;
+
+    for (i = 0; i < n; i++)
+    {
+        t = (sc64_uint128)x[i] * L[0] + carry;
+        r[i] = (uint64_t)t;
+        carry = (uint64_t)(t >> 64);
+    }
+
+    r[n] = carry;
+    carry = 0;
+
+    for (i = 0; i < n; i++)
+    {
+        t = (sc64_uint128)x[i] * L[1] + r[i + 1] + carry;
+        r[i + 1] = (uint64_t)t;
+        carry = (uint64_t)(t >> 64);
+    }
+
+    r[n + 1] = carry;
+}
+
+/*
+r = x mod l, for x = x[0..3] + 2^256 * top below 2^260. Then q = floor(x / 2^252)
+is below 256 and x - q * l = (x mod 2^252) - q * (l - 2^252) lies in (-l, l), so
+a single addition of l, when it went negative, finishes the reduction
+*/
+static void sc64_reduce_small(uint64_t r[4], const uint64_t x[4], const uint64_t top)
+{
+    sc64_uint128 t;
+    uint64_t q = (x[3] >> 60) | (top << 4);
+    uint64_t d[3];
+    uint64_t borrow;
+    uint64_t mask;
+
+    sc64_mul_delta(d, &q, 1);
+
+    t = (sc64_uint128)x[0] - d[0];
+    r[0] = (uint64_t)t;
+    borrow = (uint64_t)(t >> 64) & 1;
+    t = (sc64_uint128)x[1] - d[1] - borrow;
+    r[1] = (uint64_t)t;
+    borrow = (uint64_t)(t >> 64) & 1;
+    t = (sc64_uint128)x[2] - d[2] - borrow;
+    r[2] = (uint64_t)t;
+    borrow = (uint64_t)(t >> 64) & 1;
+    t = (sc64_uint128)(x[3] & 0x0fffffffffffffffULL) - borrow;
+    r[3] = (uint64_t)t;
+    borrow = (uint64_t)(t >> 64) & 1;
+
+    mask = 0 - borrow;
+
+    t = (sc64_uint128)r[0] + (L[0] & mask);
+    r[0] = (uint64_t)t;
+    t = (sc64_uint128)r[1] + (L[1] & mask) + (uint64_t)(t >> 64);
+    r[1] = (uint64_t)t;
+    t = (sc64_uint128)r[2] + (L[2] & mask) + (uint64_t)(t >> 64);
+    r[2] = (uint64_t)t;
+    r[3] = r[3] + (L[3] & mask) + (uint64_t)(t >> 64);
+}
+
+/* r = r - l if r >= l, for r < 2^256, without branching on r */
+static void sc64_sub_l_if_ge(uint64_t r[4])
+{
+    sc64_uint128 t;
+    uint64_t d[4];
+    uint64_t borrow = 0;
+    uint64_t mask;
+    int i;
+
+    for (i = 0; i < 4; i++)
+    {
+        t = (sc64_uint128)r[i] - L[i] - borrow;
+        d[i] = (uint64_t)t;
+        borrow = (uint64_t)(t >> 64) & 1;
+    }
+
+    /* All ones if the subtraction did not borrow, i.e. r >= l */
+    mask = borrow - 1;
+
+    for (i = 0; i < 4; i++)
+    {
+        r[i] = (d[i] & mask) | (r[i] & ~mask);
+    }
+}
+
+/* r = (a - b) mod l, for a, b < l */
+static void sc64_sub_mod(uint64_t r[4], const uint64_t a[4], const uint64_t b[4])
+{
+    sc64_uint128 t;
+    uint64_t borrow = 0;
+    uint64_t carry = 0;
+    uint64_t mask;
+    int i;
+
+    for (i = 0; i < 4; i++)
+    {
+        t = (sc64_uint128)a[i] - b[i] - borrow;
+        r[i] = (uint64_t)t;
+        borrow = (uint64_t)(t >> 64) & 1;
+    }
+
+    /* Add l back if the subtraction went below zero */
+    mask = 0 - borrow;
+
+    for (i = 0; i < 4; i++)
+    {
+        t = (sc64_uint128)r[i] + (L[i] & mask) + carry;
+        r[i] = (uint64_t)t;
+        carry = (uint64_t)(t >> 64);
+    }
+}
+
+/* r = (a + b) mod l, for a, b < l */
+static void sc64_add_mod(uint64_t r[4], const uint64_t a[4], const uint64_t b[4])
+{
+    sc64_uint128 t;
+    uint64_t carry = 0;
+    int i;
+
+    for (i = 0; i < 4; i++)
+    {
+        t = (sc64_uint128)a[i] + b[i] + carry;
+        r[i] = (uint64_t)t;
+        carry = (uint64_t)(t >> 64);
+    }
+
+    sc64_sub_l_if_ge(r);
+}
+
+/*
+r = x mod l, for x < 2^512. As 2^252 = -(l - 2^252) mod l, the bits of x above 2^252
+are folded back down twice, leaving x = (x mod 2^252) - (y mod 2^252) + z mod l with
+y and z the products of the folds, each of which is below l once z is reduced
+*/
+static void sc64_reduce_wide(uint64_t r[4], const uint64_t x[8])
+{
+    uint64_t high[5];
+    uint64_t y[7];
+    uint64_t low[4];
+    uint64_t z[5];
+    int i;
+
+    for (i = 0; i < 4; i++)
+    {
+        high[i] = (x[i + 3] >> 60) | (x[i + 4] << 4);
+    }
+
+    high[4] = x[7] >> 60;
+
+    /* y = floor(x / 2^252) * (l - 2^252), below 2^385 */
+    sc64_mul_delta(y, high, 5);
+
+    high[0] = (y[3] >> 60) | (y[4] << 4);
+    high[1] = (y[4] >> 60) | (y[5] << 4);
+    high[2] = (y[5] >> 60) | (y[6] << 4);
+
+    /* z = floor(y / 2^252) * (l - 2^252), below 2^258 */
+    sc64_mul_delta(z, high, 3);
+
+    sc64_reduce_small(z, z, z[4]);
+
+    low[0] = y[0];
+    low[1] = y[1];
+    low[2] = y[2];
+    low[3] = y[3] & 0x0fffffffffffffffULL;
+
+    r[0] = x[0];
+    r[1] = x[1];
+    r[2] = x[2];
+    r[3] = x[3] & 0x0fffffffffffffffULL;
+
+    sc64_sub_mod(r, r, low);
+
+    sc64_add_mod(r, r, z);
+}
+
+void sc64_reduce(unsigned char *s)
+{
+    uint64_t x[8];
+    uint64_t r[4];
+
+    sc64_load(x, s, 8);
+    sc64_reduce_wide(r, x);
+    sc64_store(s, r);
+}
+
+void sc64_reduce32(unsigned char *s)
+{
+    uint64_t x[4];
+    uint64_t r[4];
+
+    sc64_load(x, s, 4);
+    sc64_reduce_small(r, x, 0);
+    sc64_store(s, r);
+}
+
+void sc64_add(unsigned char *s, const unsigned char *a, const unsigned char *b)
+{
+    sc64_uint128 t;
+    uint64_t x[4];
+    uint64_t y[4];
+    uint64_t r[4];
+    uint64_t carry = 0;
+    int i;
+
+    sc64_load(x, a, 4);
+    sc64_load(y, b, 4);
+
+    for (i = 0; i < 4; i++)
+    {
+        t = (sc64_uint128)x[i] + y[i] + carry;
+        x[i] = (uint64_t)t;
+        carry = (uint64_t)(t >> 64);
+    }
+
+    sc64_reduce_small(r, x, carry);
+    sc64_store(s, r);
+}
+
+void sc64_sub(unsigned char *s, const unsigned char *a, const unsigned char *b)
+{
+    uint64_t x[4];
+    uint64_t y[4];
+    uint64_t r[4];
+
+    sc64_load(x, a, 4);
+    sc64_load(y, b, 4);
+
+    sc64_reduce_small(x, x, 0);
+    sc64_reduce_small(y, y, 0);
+
+    sc64_sub_mod(r, x, y);
+    sc64_store(s, r);
+}
+
+void sc64_mul(unsigned char *s, const unsigned char *a, const unsigned char *b)
+{
+    uint64_t x[4];
+    uint64_t y[4];
+    uint64_t p[8];
+    uint64_t r[4];
+
+    sc64_load(x, a, 4);
+    sc64_load(y, b, 4);
+
+    sc64_mul_4x4(p, x, y);
+
+    sc64_reduce_wide(r, p);
+    sc64_store(s, r);
+}
+
+void sc64_muladd(unsigned char *s, const unsigned char *a, const unsigned char *b, const unsigned char *c)
+{
+    sc64_uint128 t;
+    uint64_t x[4];
+    uint64_t y[4];
+    uint64_t z[4];
+    uint64_t p[8];
+    uint64_t r[4];
+    uint64_t carry = 0;
+    int i;
+
+    sc64_load(x, a, 4);
+    sc64_load(y, b, 4);
+    sc64_load(z, c, 4);
+
+    sc64_mul_4x4(p, x, y);
+
+    /* a * b + c stays below 2^512 for any a, b, c below 2^256 */
+    for (i = 0; i < 4; i++)
+    {
+        t = (sc64_uint128)p[i] + z[i] + carry;
+        p[i] = (uint64_t)t;
+        carry = (uint64_t)(t >> 64);
+    }
+
+    for (i = 4; i < 8; i++)
+    {
+        t = (sc64_uint128)p[i] + carry;
+        p[i] = (uint64_t)t;
+        carry = (uint64_t)(t >> 64);
+    }
+
+    sc64_reduce_wide(r, p);
+    sc64_store(s, r);
+}
+
+void sc64_mulsub(unsigned char *s, const unsigned char *a, const unsigned char *b, const unsigned char *c)
+{
+    uint64_t x[4];
+    uint64_t y[4];
+    uint64_t z[4];
+    uint64_t p[8];
+    uint64_t ab[4];
+    uint64_t r[4];
+
+    sc64_load(x, a, 4);
+    sc64_load(y, b, 4);
+    sc64_load(z, c, 4);
+
+    sc64_mul_4x4(p, x, y);
+
+    sc64_reduce_wide(ab, p);
+    sc64_reduce_small(z, z, 0);
+
+    sc64_sub_mod(r, z, ab);
+    sc64_store(s, r);
+}
+
+#endif
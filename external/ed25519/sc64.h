@@ -0,0 +1,35 @@
+// Copyright (c) 2020, The TurtleCoin Developers
+//
+// Please see the included LICENSE file for more information.
+
+#ifndef ED25519_SC64_H
+#define ED25519_SC64_H
+
+/*
+The 64-bit scalar engine holds scalars as four 64-bit limbs and forms products with
+128-bit multiplications, instead of the twelve 21-bit limbs and long carry chains of
+ref10. Products are reduced modulo l by folding the bits above 2^252 back down, as
+2^252 = -(l - 2^252) mod l and l - 2^252 fits in two limbs. It gives the same outputs
+as the ref10 routines for any inputs and runs in constant time. It is compiled
+wherever the compiler has a 128-bit integer type unless ED25519_NO_SC64 is defined,
+in which case sc_reduce and friends keep the ref10 code.
+*/
+#if !defined(ED25519_NO_SC64) && defined(__SIZEOF_INT128__)
+#define ED25519_SC64
+
+void sc64_reduce(unsigned char *s);
+
+void sc64_reduce32(unsigned char *s);
+
+void sc64_add(unsigned char *s, const unsigned char *a, const unsigned char *b);
+
+void sc64_sub(unsigned char *s, const unsigned char *a, const unsigned char *b);
+
+void sc64_mul(unsigned char *s, const unsigned char *a, const unsigned char *b);
+
+void sc64_muladd(unsigned char *s, const unsigned char *a, const unsigned char *b, const unsigned char *c);
+
+void sc64_mulsub(unsigned char *s, const unsigned char *a, const unsigned char *b, const unsigned char *c);
+#endif
+
+#endif // ED25519_SC64_H
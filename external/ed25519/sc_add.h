@@ -7,6 +7,7 @@
 #define ED25519_SC_ADD_H
 
 #include "sc.h"
+#include "sc64.h"
 
 void sc_add(unsigned char *s, const unsigned char *a, const unsigned char *b);
 
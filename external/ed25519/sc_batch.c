@@ -0,0 +1,85 @@
+// Copyright (c) 2020, The TurtleCoin Developers
+//
+// Please see the included LICENSE file for more information.
+
+#include "sc_batch.h"
+
+void sc_batch_reduce(unsigned char (*s)[64], size_t n)
+{
+    size_t i;
+
+    for (i = 0; i < n; i++)
+    {
+        sc_reduce(s[i]);
+    }
+}
+
+void sc_batch_reduce32(unsigned char (*s)[32], size_t n)
+{
+    size_t i;
+
+    for (i = 0; i < n; i++)
+    {
+        sc_reduce32(s[i]);
+    }
+}
+
+void sc_batch_add(unsigned char (*s)[32], const unsigned char (*a)[32], const unsigned char (*b)[32], size_t n)
+{
+    size_t i;
+
+    for (i = 0; i < n; i++)
+    {
+        sc_add(s[i], a[i], b[i]);
+    }
+}
+
+void sc_batch_sub(unsigned char (*s)[32], const unsigned char (*a)[32], const unsigned char (*b)[32], size_t n)
+{
+    size_t i;
+
+    for (i = 0; i < n; i++)
+    {
+        sc_sub(s[i], a[i], b[i]);
+    }
+}
+
+void sc_batch_mul(unsigned char (*s)[32], const unsigned char (*a)[32], const unsigned char (*b)[32], size_t n)
+{
+    size_t i;
+
+    for (i = 0; i < n; i++)
+    {
+        sc_mul(s[i], a[i], b[i]);
+    }
+}
+
+void sc_batch_muladd(
+    unsigned char (*s)[32],
+    const unsigned char (*a)[32],
+    const unsigned char (*b)[32],
+    const unsigned char (*c)[32],
+    size_t n)
+{
+    size_t i;
+
+    for (i = 0; i < n; i++)
+    {
+        sc_muladd(s[i], a[i], b[i], c[i]);
+    }
+}
+
+void sc_batch_mulsub(
+    unsigned char (*s)[32],
+    const unsigned char (*a)[32],
+    const unsigned char (*b)[32],
+    const unsigned char (*c)[32],
+    size_t n)
+{
+    size_t i;
+
+    for (i = 0; i < n; i++)
+    {
+        sc_mulsub(s[i], a[i], b[i], c[i]);
+    }
+}
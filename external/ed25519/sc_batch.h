@@ -0,0 +1,47 @@
+// Copyright (c) 2020, The TurtleCoin Developers
+//
+// Please see the included LICENSE file for more information.
+
+#ifndef ED25519_SC_BATCH_H
+#define ED25519_SC_BATCH_H
+
+#include "sc_add.h"
+#include "sc_mul.h"
+#include "sc_muladd.h"
+#include "sc_mulsub.h"
+#include "sc_reduce.h"
+#include "sc_reduce32.h"
+#include "sc_sub.h"
+
+#include <stddef.h>
+
+/*
+The scalar routines over n scalars at once, where s[i] = op(a[i], b[i], c[i]).
+Outputs may alias inputs, as they may for the single routines. sc_batch_reduce
+reduces each 64-byte s[i] in place, leaving the scalar in its first 32 bytes.
+*/
+void sc_batch_reduce(unsigned char (*s)[64], size_t n);
+
+void sc_batch_reduce32(unsigned char (*s)[32], size_t n);
+
+void sc_batch_add(unsigned char (*s)[32], const unsigned char (*a)[32], const unsigned char (*b)[32], size_t n);
+
+void sc_batch_sub(unsigned char (*s)[32], const unsigned char (*a)[32], const unsigned char (*b)[32], size_t n);
+
+void sc_batch_mul(unsigned char (*s)[32], const unsigned char (*a)[32], const unsigned char (*b)[32], size_t n);
+
+void sc_batch_muladd(
+    unsigned char (*s)[32],
+    const unsigned char (*a)[32],
+    const unsigned char (*b)[32],
+    const unsigned char (*c)[32],
+    size_t n);
+
+void sc_batch_mulsub(
+    unsigned char (*s)[32],
+    const unsigned char (*a)[32],
+    const unsigned char (*b)[32],
+    const unsigned char (*c)[32],
+    size_t n);
+
+#endif // ED25519_SC_BATCH_H
@@ -13,6 +13,12 @@ Output:
   s[0]+256*s[1]+...+256^31*s[31] = (ab) mod l
   where l = 2^252 + 27742317777372353535851937790883648493.
 */
+#if defined(ED25519_SC64)
+void sc_mul(unsigned char *s, const unsigned char *a, const unsigned char *b)
+{
+    sc64_mul(s, a, b);
+}
+#else
 void sc_mul(unsigned char *s, const unsigned char *a, const unsigned char *b)
 {
     int64_t a0 = 2097151 & load_3(a);
@@ -464,4 +470,5 @@ void sc_mul(unsigned char *s, const unsigned char *a, const unsigned char *b)
     s[29] = (unsigned char)(s11 >> 1);
     s[30] = (unsigned char)(s11 >> 9);
     s[31] = (unsigned char)(s11 >> 17);
-}
\ No newline at end of file
+}
+#endif
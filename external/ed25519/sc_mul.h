@@ -7,6 +7,7 @@
 #define ED25519_SC_MUL_H
 
 #include "sc.h"
+#include "sc64.h"
 
 void sc_mul(unsigned char *s, const unsigned char *a, const unsigned char *b);
 
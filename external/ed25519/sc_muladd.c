@@ -14,6 +14,12 @@ Output:
   s[0]+256*s[1]+...+256^31*s[31] = (c+ab) mod l
   where l = 2^252 + 27742317777372353535851937790883648493.
 */
+#if defined(ED25519_SC64)
+void sc_muladd(unsigned char *s, const unsigned char *a, const unsigned char *b, const unsigned char *c)
+{
+    sc64_muladd(s, a, b, c);
+}
+#else
 void sc_muladd(unsigned char *s, const unsigned char *a, const unsigned char *b, const unsigned char *c)
 {
     int64_t a0 = 2097151 & load_3(a);
@@ -478,4 +484,5 @@ void sc_muladd(unsigned char *s, const unsigned char *a, const unsigned char *b,
     s[29] = (unsigned char)(s11 >> 1);
     s[30] = (unsigned char)(s11 >> 9);
     s[31] = (unsigned char)(s11 >> 17);
-}
\ No newline at end of file
+}
+#endif
@@ -16,6 +16,12 @@ Output:
   where l = 2^252 + 27742317777372353535851937790883648493.
 */
 
+#if defined(ED25519_SC64)
+void sc_mulsub(unsigned char *s, const unsigned char *a, const unsigned char *b, const unsigned char *c)
+{
+    sc64_mulsub(s, a, b, c);
+}
+#else
 void sc_mulsub(unsigned char *s, const unsigned char *a, const unsigned char *b, const unsigned char *c)
 {
     int64_t a0 = 2097151 & load_3(a);
@@ -480,4 +486,5 @@ void sc_mulsub(unsigned char *s, const unsigned char *a, const unsigned char *b,
     s[29] = (unsigned char)(s11 >> 1);
     s[30] = (unsigned char)(s11 >> 9);
     s[31] = (unsigned char)(s11 >> 17);
-}
\ No newline at end of file
+}
+#endif
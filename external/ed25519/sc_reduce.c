@@ -15,6 +15,12 @@ Output:
   Overwrites s in place.
 */
 
+#if defined(ED25519_SC64)
+void sc_reduce(unsigned char *s)
+{
+    sc64_reduce(s);
+}
+#else
 void sc_reduce(unsigned char *s)
 {
     int64_t s0 = 2097151 & load_3(s);
@@ -335,4 +341,5 @@ void sc_reduce(unsigned char *s)
     s[29] = (unsigned char)(s11 >> 1);
     s[30] = (unsigned char)(s11 >> 9);
     s[31] = (unsigned char)(s11 >> 17);
-}
\ No newline at end of file
+}
+#endif
@@ -5,6 +5,12 @@
 
 #include "sc_reduce32.h"
 
+#if defined(ED25519_SC64)
+void sc_reduce32(unsigned char *s)
+{
+    sc64_reduce32(s);
+}
+#else
 void sc_reduce32(unsigned char *s)
 {
     int64_t s0 = 2097151 & load_3(s);
@@ -189,4 +195,5 @@ void sc_reduce32(unsigned char *s)
     s[29] = (unsigned char)(s11 >> 1);
     s[30] = (unsigned char)(s11 >> 9);
     s[31] = (unsigned char)(s11 >> 17);
-}
\ No newline at end of file
+}
+#endif
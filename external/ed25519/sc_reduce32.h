@@ -7,6 +7,7 @@
 #define ED25519_SC_REDUCE32_H
 
 #include "sc.h"
+#include "sc64.h"
 
 void sc_reduce32(unsigned char *s);
 
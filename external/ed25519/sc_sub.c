@@ -5,6 +5,12 @@
 
 #include "sc_sub.h"
 
+#if defined(ED25519_SC64)
+void sc_sub(unsigned char *s, const unsigned char *a, const unsigned char *b)
+{
+    sc64_sub(s, a, b);
+}
+#else
 void sc_sub(unsigned char *s, const unsigned char *a, const unsigned char *b)
 {
     int64_t a0 = 2097151 & load_3(a);
@@ -213,4 +219,5 @@ void sc_sub(unsigned char *s, const unsigned char *a, const unsigned char *b)
     s[29] = (unsigned char)(s11 >> 1);
     s[30] = (unsigned char)(s11 >> 9);
     s[31] = (unsigned char)(s11 >> 17);
-}
\ No newline at end of file
+}
+#endif
@@ -41,6 +41,47 @@ namespace Common
         uint64_t outSize;
         return fromHex(text, &val, sizeof(val), outSize) && outSize == sizeof(val);
     }
+
+    /* The codecs beneath fromHex and toHex, which use AVX2, SSE4.1 or NEON where the processor has them */
+    bool decodeHex(
+        const char *text,
+        uint64_t size,
+        void *data); // Assigns values of the 'size' hex characters at 'text' to 'data', returns false on error, does
+                     // not throw
+    void encodeHex(
+        const void *data,
+        uint64_t size,
+        char *text); // Writes the 2 * 'size' character hex representation of ('data', 'size') to 'text', does not throw
+
+    template<typename T> bool podFromHexBatch(const std::vector<std::string> &texts, T *values)
+    { // Assigns values of each of 'texts' to 'values', which are exactly 2 * sizeof(T) characters, does not throw
+        for (uint64_t i = 0; i < texts.size(); ++i)
+        {
+            if (texts[i].size() != sizeof(T) * 2 || !decodeHex(texts[i].data(), texts[i].size(), &values[i]))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    template<typename T> bool podFromHexBatch(const char *text, uint64_t count, T *values)
+    { // Assigns values of 'count' consecutive hex strings of 2 * sizeof(T) characters at 'text', does not throw
+        return decodeHex(text, count * sizeof(T) * 2, values);
+    }
+
+    template<typename T> void podToHexBatch(const T *values, uint64_t count, std::vector<std::string> &texts)
+    { // Assigns the hex representation of each of ('values', 'count') to 'texts', does not throw
+        texts.resize(count);
+
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            texts[i].resize(sizeof(T) * 2);
+
+            encodeHex(&values[i], sizeof(T), &texts[i][0]);
+        }
+    }
     std::string
         toHex(const void *data, uint64_t size); // Returns hex representation of ('data', 'size'), does not throw
 
@@ -0,0 +1,24 @@
+// Copyright (c) 2020, The TurtleCoin Developers
+//
+// Please see the included LICENSE file for more information.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Random
+{
+    const size_t CHACHA20_BLOCK_SIZE = 64;
+
+    const size_t CHACHA20_KEY_WORDS = 8;
+
+    /* A single block of ChaCha20 in the original layout, with a 64-bit block counter in
+       state words 12 and 13 and a 64-bit nonce in words 14 and 15. This is the keystream
+       behind randomBytes, which always uses a zero nonce. */
+    void chacha20_block(
+        const uint32_t key[CHACHA20_KEY_WORDS],
+        const uint64_t counter,
+        const uint64_t nonce,
+        uint8_t *out);
+} // namespace Random
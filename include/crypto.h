@@ -8,16 +8,100 @@
 #pragma once
 
 #include "hash.h"
+#include "subwallet-key-index.h"
 
 #include <CryptoTypes.h>
 #include <cstddef>
 #include <limits>
+#include <memory>
 #include <mutex>
 #include <type_traits>
 #include <vector>
 
 namespace Crypto
 {
+    /* A single ring signature to be verified as part of crypto_ops::checkRingSignatures */
+    struct RingSignatureCheck
+    {
+        Hash prefixHash;
+
+        KeyImage keyImage;
+
+        std::vector<PublicKey> publicKeys;
+
+        std::vector<Signature> signatures;
+    };
+
+    /* A single transaction output to be checked for ownership by crypto_ops::scanTransactions */
+    struct TransactionOutputRecord
+    {
+        PublicKey txPublicKey;
+
+        uint64_t outputIndex;
+
+        PublicKey outputKey;
+    };
+
+    /* An output found by crypto_ops::scanTransactions to belong to one of the given spend keys */
+    struct OwnedOutput
+    {
+        /* The index of the output in the scanned records */
+        size_t recordIndex;
+
+        /* The index in the SubwalletKeyIndex of the spend key the output was sent to */
+        size_t subwalletIndex;
+
+        /* Hs(8aR || outputIndex), as needed to derive the output's secret key */
+        EllipticCurveScalar derivationScalar;
+    };
+
+    /* A public key that is derived against over and over, such as a wallet's public spend
+       key or the view key of an address that is paid repeatedly. The point is decompressed
+       once and a table of its multiples is built so that generate_key_derivation can use
+       the same fixed-base method as multiplications by the base point. Building the table
+       costs about as much as six derivations, and it takes up about 30KB. */
+    class PrecomputedPoint
+    {
+      public:
+        explicit PrecomputedPoint(const PublicKey &key);
+
+        /* False if the key is not a valid point, every function given it then fails */
+        bool valid() const;
+
+        const PublicKey &key() const;
+
+      private:
+        friend class crypto_ops;
+
+        struct Tables;
+
+        PublicKey m_key;
+
+        std::shared_ptr<const Tables> m_tables;
+    };
+
+    /* Where a run of crypto_ops::generate_deterministic_subwallet_keys left off. Every
+       subwallet key is stretched with its own index as the salt, so no hashing work
+       carries over from one subwallet to the next; a restore is resumed by passing the
+       checkpoint back in. */
+    struct SubwalletKeysCheckpoint
+    {
+        uint64_t nextSubwalletIndex = 0;
+    };
+
+    /* The counters of the ring member cache, see crypto_ops::setRingMemberCacheSize */
+    struct RingMemberCacheStats
+    {
+        uint64_t hits = 0;
+
+        uint64_t misses = 0;
+
+        /* The number of ring members currently held */
+        size_t size = 0;
+
+        size_t capacity = 0;
+    };
+
     class crypto_ops
     {
         crypto_ops();
@@ -45,6 +129,8 @@ namespace Crypto
         friend bool secret_key_to_public_key(const SecretKey &, PublicKey &);
         static bool generate_key_derivation(const PublicKey &, const SecretKey &, KeyDerivation &);
         friend bool generate_key_derivation(const PublicKey &, const SecretKey &, KeyDerivation &);
+        static bool generate_key_derivation(const PrecomputedPoint &, const SecretKey &, KeyDerivation &);
+        friend bool generate_key_derivation(const PrecomputedPoint &, const SecretKey &, KeyDerivation &);
         static void derivation_to_scalar(const KeyDerivation &, size_t, EllipticCurveScalar &);
         friend void derivation_to_scalar(const KeyDerivation &, size_t, EllipticCurveScalar &);
         static void derivation_to_scalar(const KeyDerivation &, size_t, const uint8_t *, size_t, EllipticCurveScalar &);
@@ -57,6 +143,10 @@ namespace Crypto
             derive_public_key(const KeyDerivation &, size_t, const PublicKey &, const uint8_t *, size_t, PublicKey &);
         static bool
             derive_public_key(const KeyDerivation &, size_t, const PublicKey &, const uint8_t *, size_t, PublicKey &);
+        static bool derive_public_key(const KeyDerivation &, size_t, const PrecomputedPoint &, PublicKey &);
+        friend bool derive_public_key(const KeyDerivation &, size_t, const PrecomputedPoint &, PublicKey &);
+        static bool derive_public_key(const EllipticCurveScalar &, const PrecomputedPoint &, PublicKey &);
+        friend bool derive_public_key(const EllipticCurveScalar &, const PrecomputedPoint &, PublicKey &);
         // hack for pg
         static bool underive_public_key_and_get_scalar(
             const KeyDerivation &,
@@ -85,6 +175,8 @@ namespace Crypto
             underive_public_key(const KeyDerivation &, size_t, const PublicKey &, const uint8_t *, size_t, PublicKey &);
         friend bool
             underive_public_key(const KeyDerivation &, size_t, const PublicKey &, const uint8_t *, size_t, PublicKey &);
+        static bool is_output_for(const KeyDerivation &, size_t, const PublicKey &, const PrecomputedPoint &);
+        friend bool is_output_for(const KeyDerivation &, size_t, const PublicKey &, const PrecomputedPoint &);
         static void generate_signature(const Hash &, const PublicKey &, const SecretKey &, Signature &);
         friend void generate_signature(const Hash &, const PublicKey &, const SecretKey &, Signature &);
         static bool check_signature(const Hash &, const PublicKey &, const Signature &);
@@ -106,6 +198,25 @@ namespace Crypto
             SecretKey &subWalletPrivateKey);
 
       public:
+        /* Uniformly random scalars, each reduced from 64 bytes of the thread's ChaCha20
+           keystream (see Random::randomBytes). The bulk versions read the keystream for
+           many scalars at once. */
+        static void randomScalar(EllipticCurveScalar &scalar);
+
+        static void randomScalars(EllipticCurveScalar *scalars, const size_t count);
+
+        static std::vector<EllipticCurveScalar> randomScalars(const size_t count);
+
+        /* Generates count random key pairs into publicKeys and secretKeys, as generate_keys
+           would. The secret keys are drawn in bulk, and the public keys are compressed in
+           batches that share a single field inversion, spread over the given number of
+           threads. Meant for filling large pools of keys ahead of demand. */
+        static void generate_keys_batch(
+            const size_t count,
+            PublicKey *publicKeys,
+            SecretKey *secretKeys,
+            const size_t threads = 1);
+
         static bool prepareRingSignatures(
             const Hash prefixHash,
             const KeyImage keyImage,
@@ -142,6 +253,68 @@ namespace Crypto
             const std::vector<PublicKey> pubs,
             const std::vector<Signature> signatures);
 
+        /* As above, over count ring members and their signatures, without copying them into vectors */
+        static bool checkRingSignature(
+            const Hash &prefix_hash,
+            const KeyImage &image,
+            const PublicKey *pubs,
+            const Signature *signatures,
+            const size_t count);
+
+        /* Verifies many ring signatures at once, e.g. every input of a block. Ring members
+           that appear in more than one ring are only decompressed and hashed to the curve
+           once, and the work is spread over the given number of threads. results[i] is set
+           to the validity of checks[i]. Returns true if every signature is valid. */
+        static bool checkRingSignatures(
+            const std::vector<RingSignatureCheck> &checks,
+            std::vector<bool> &results,
+            const size_t threads = 1);
+
+        static bool checkRingSignatures(const std::vector<RingSignatureCheck> &checks, const size_t threads = 1);
+
+        /* Ring members are drawn from the same outputs over and over, so a node checking
+           every new transaction decompresses and hashes the popular ones to the curve many
+           times. This enables a process wide cache of the decompressed point and hash_to_ec
+           of up to capacity public keys, consulted by checkRingSignature(s), ring signature
+           preparation and generate_key_image. The least recently used keys are evicted
+           first, each entry takes about 450 bytes, and the cache is safe to use from many
+           threads. It is disabled by default, and a capacity of 0 disables and empties it. */
+        static void setRingMemberCacheSize(const size_t capacity);
+
+        static RingMemberCacheStats getRingMemberCacheStats();
+
+        /* Empties the ring member cache and resets its counters, keeping its capacity */
+        static void clearRingMemberCache();
+
+        /* Finds the outputs in records which belong to any of the given public spend keys.
+           Every unique transaction public key is only derived once, the recovered spend keys
+           are serialized in batches that share a single field inversion, and the work is
+           spread over the given number of threads. The owned outputs are returned in the
+           order of records. Returns false if the view key is not a valid scalar.
+
+           Wallet containers with many subwallets should build the SubwalletKeyIndex once
+           and reuse it, the other overloads build a temporary one on every call. */
+        static bool scanTransactions(
+            const SecretKey &privateViewKey,
+            const SubwalletKeyIndex &publicSpendKeys,
+            const std::vector<TransactionOutputRecord> &records,
+            std::vector<OwnedOutput> &ownedOutputs,
+            const size_t threads = 1);
+
+        static bool scanTransactions(
+            const SecretKey &privateViewKey,
+            const std::vector<PublicKey> &publicSpendKeys,
+            const std::vector<TransactionOutputRecord> &records,
+            std::vector<OwnedOutput> &ownedOutputs,
+            const size_t threads = 1);
+
+        static bool scanTransactions(
+            const SecretKey &privateViewKey,
+            const PublicKey &publicSpendKey,
+            const std::vector<TransactionOutputRecord> &records,
+            std::vector<OwnedOutput> &ownedOutputs,
+            const size_t threads = 1);
+
         static void generateViewFromSpend(const Crypto::SecretKey &spend, Crypto::SecretKey &viewSecret);
 
         static void generateViewFromSpend(
@@ -161,6 +334,29 @@ namespace Crypto
             /* Generate the related public key for the new deterministic private key */
             return secret_key_to_public_key(subwalletPrivate, subwalletPublic);
         }
+
+        /* Generates the keys of subwallets [firstSubwalletIndex, firstSubwalletIndex + count)
+           into subwalletPrivates and subwalletPublics, spread over the given number of threads.
+           The output vectors are sized once up front and the key stretching runs on the stack,
+           so nothing is allocated per key. If checkpoint is given, it is set to the subwallet
+           that follows the range. */
+        static bool generate_deterministic_subwallet_keys(
+            const SecretKey &basePrivate,
+            const uint64_t firstSubwalletIndex,
+            const size_t count,
+            std::vector<SecretKey> &subwalletPrivates,
+            std::vector<PublicKey> &subwalletPublics,
+            SubwalletKeysCheckpoint *checkpoint = nullptr,
+            const size_t threads = 1);
+
+        /* Generates the next count subwallet keys after the checkpoint and advances it */
+        static bool generate_deterministic_subwallet_keys(
+            const SecretKey &basePrivate,
+            SubwalletKeysCheckpoint &checkpoint,
+            const size_t count,
+            std::vector<SecretKey> &subwalletPrivates,
+            std::vector<PublicKey> &subwalletPublics,
+            const size_t threads = 1);
     };
 
     /* Generate a new key pair
@@ -185,6 +381,19 @@ namespace Crypto
             basePrivate, subwalletIndex, subwalletPrivate, subwalletPublic);
     }
 
+    inline bool generate_deterministic_subwallet_keys(
+        const SecretKey &basePrivate,
+        const uint64_t firstSubwalletIndex,
+        const size_t count,
+        std::vector<SecretKey> &subwalletPrivates,
+        std::vector<PublicKey> &subwalletPublics,
+        SubwalletKeysCheckpoint *checkpoint = nullptr,
+        const size_t threads = 1)
+    {
+        return crypto_ops::generate_deterministic_subwallet_keys(
+            basePrivate, firstSubwalletIndex, count, subwalletPrivates, subwalletPublics, checkpoint, threads);
+    }
+
     inline SecretKey generate_m_keys(
         PublicKey &pub,
         SecretKey &sec,
@@ -223,6 +432,13 @@ namespace Crypto
         return crypto_ops::generate_key_derivation(key1, key2, derivation);
     }
 
+    /* As above, but multiplies by a precomputed table rather than decompressing key1 every time */
+    inline bool
+        generate_key_derivation(const PrecomputedPoint &key1, const SecretKey &key2, KeyDerivation &derivation)
+    {
+        return crypto_ops::generate_key_derivation(key1, key2, derivation);
+    }
+
     inline void derivation_to_scalar(const KeyDerivation &derivation, size_t output_index, EllipticCurveScalar &res)
     {
         crypto_ops::derivation_to_scalar(derivation, output_index, res);
@@ -254,6 +470,23 @@ namespace Crypto
         return crypto_ops::derive_public_key(derivationScalar, base, derived_key);
     }
 
+    inline bool derive_public_key(
+        const KeyDerivation &derivation,
+        size_t output_index,
+        const PrecomputedPoint &base,
+        PublicKey &derived_key)
+    {
+        return crypto_ops::derive_public_key(derivation, output_index, base, derived_key);
+    }
+
+    inline bool derive_public_key(
+        const EllipticCurveScalar &derivationScalar,
+        const PrecomputedPoint &base,
+        PublicKey &derived_key)
+    {
+        return crypto_ops::derive_public_key(derivationScalar, base, derived_key);
+    }
+
     inline bool underive_public_key_and_get_scalar(
         const KeyDerivation &derivation,
         std::size_t output_index,
@@ -315,6 +548,19 @@ namespace Crypto
         return crypto_ops::underive_public_key(derivation, output_index, derived_key, base);
     }
 
+    /* Returns true if derived_key is the output key derive_public_key gives for base, i.e.
+       if the output belongs to base, which is what comparing underive_public_key against
+       base answers. Rather than decompressing derived_key, the expected output key is
+       derived from the already decompressed base and compared. */
+    inline bool is_output_for(
+        const KeyDerivation &derivation,
+        size_t output_index,
+        const PublicKey &derived_key,
+        const PrecomputedPoint &base)
+    {
+        return crypto_ops::is_output_for(derivation, output_index, derived_key, base);
+    }
+
     /* Generation and checking of a standard signature.
      */
     inline void generate_signature(const Hash &prefix_hash, const PublicKey &pub, const SecretKey &sec, Signature &sig)
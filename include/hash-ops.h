@@ -68,7 +68,18 @@ enum
     SLOW_HASH_CONTEXT_LITE_SIZE = 1048976 // Suml: Unused for now but this is the right size for 1MB scratchpads.
 };
 
+/* One of the buffers that cn_fast_hash_iov hashes as if they were concatenated */
+struct hash_iovec
+{
+    const void *data;
+    size_t length;
+};
+
 void cn_fast_hash(const void *data, size_t length, char *hash);
+void cn_fast_hash_iov(const struct hash_iovec *iov, size_t count, char *hash);
+/* Hashes count messages at once, interleaving the Keccak states of up to eight of
+   them in each permutation when the processor supports AVX2 or AVX-512 */
+void cn_fast_hash_batch(const void *const *data, const size_t *length, size_t count, char (*hashes)[HASH_SIZE]);
 void cn_slow_hash(
     const void *data,
     size_t length,
@@ -79,6 +90,25 @@ void cn_slow_hash(
     uint64_t page_size,
     uint64_t scratchpad,
     uint64_t iterations);
+void cn_slow_hash_batch(
+    const void *const *data,
+    const size_t *length,
+    size_t count,
+    char (*hashes)[HASH_SIZE],
+    int light,
+    int variant,
+    int prehashed,
+    uint64_t page_size,
+    uint64_t scratchpad,
+    uint64_t iterations);
+
+/* Each thread keeps its CryptoNight scratchpad between hashes. It is grown on
+   demand by cn_slow_hash, but may be sized up front with slow_hash_thread_init
+   and released early with slow_hash_thread_teardown */
+void slow_hash_thread_init(uint64_t page_size);
+void slow_hash_thread_teardown(void);
+uint8_t *slow_hash_allocate_state(uint64_t page_size);
+void slow_hash_free_state(void);
 
 void hash_extra_blake(const void *data, size_t length, char *hash);
 void hash_extra_groestl(const void *data, size_t length, char *hash);
@@ -88,6 +118,19 @@ void hash_extra_skein(const void *data, size_t length, char *hash);
 void tree_hash(const char (*hashes)[HASH_SIZE], size_t count, char *root_hash);
 size_t tree_depth(size_t count);
 void tree_branch(const char (*hashes)[HASH_SIZE], size_t count, char (*branch)[HASH_SIZE]);
+/* The variants below never allocate. Each level of the tree is hashed through
+   cn_fast_hash_batch, in the scratch space of tree_hash_scratch_size(count) hashes */
+size_t tree_hash_scratch_size(size_t count);
+void tree_hash_with_scratch(
+    const char (*hashes)[HASH_SIZE],
+    size_t count,
+    char (*scratch)[HASH_SIZE],
+    char *root_hash);
+void tree_branch_with_scratch(
+    const char (*hashes)[HASH_SIZE],
+    size_t count,
+    char (*scratch)[HASH_SIZE],
+    char (*branch)[HASH_SIZE]);
 void tree_hash_from_branch(
     const char (*branch)[HASH_SIZE],
     size_t depth,
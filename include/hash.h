@@ -66,9 +66,20 @@ namespace Crypto
     extern "C"
     {
 #include "hash-ops.h"
+#include "keccak.h"
     }
 
-    static bool argon2_optimization_selected = false;
+    /* Chooses the Argon2 implementation used for Chukwa. Only the first call in the process
+       does any work, and any calls racing with it wait for it to finish, so it is safe to
+       call from many threads and may be called eagerly at startup to keep the benchmark
+       off the first hash.
+
+       The implementation ("SSE2", "SSSE3", "XOP", "AVX2" or "AVX-512F") can be forced with
+       the implementation argument of that first call, or else with the ARGON2_IMPL
+       environment variable. If neither is given, or the CPU does not support the one asked
+       for, the fastest available implementation is benchmarked for. Returns the name of the
+       implementation in use. */
+    const char *select_argon2_optimization(const char *implementation = nullptr);
 
     /*
       Cryptonight hash functions
@@ -86,6 +97,23 @@ namespace Crypto
         return h;
     }
 
+    inline void cn_fast_hash_iov(const hash_iovec *iov, size_t count, Hash &hash)
+    {
+        cn_fast_hash_iov(iov, count, reinterpret_cast<char *>(&hash));
+    }
+
+    inline Hash cn_fast_hash_iov(const hash_iovec *iov, size_t count)
+    {
+        Hash h;
+        cn_fast_hash_iov(iov, count, reinterpret_cast<char *>(&h));
+        return h;
+    }
+
+    inline void cn_fast_hash_batch(const void *const *data, const size_t *length, size_t count, Hash *hashes)
+    {
+        cn_fast_hash_batch(data, length, count, reinterpret_cast<char(*)[HASH_SIZE]>(hashes));
+    }
+
     // Standard CryptoNight
     inline void cn_slow_hash_v0(const void *data, size_t length, Hash &hash)
     {
@@ -321,7 +349,8 @@ namespace Crypto
     }
 
     // CryptoNight Soft Shell
-    inline void cn_soft_shell_slow_hash_v0(const void *data, size_t length, Hash &hash, uint64_t height)
+    /* Calculates the scratchpad size and iteration count used at the given height */
+    inline void cn_soft_shell_parameters(uint64_t height, uint64_t &scratchpad, uint64_t &iterations)
     {
         uint64_t base_offset = (height % CN_SOFT_SHELL_WINDOW);
         int64_t offset = (height % (CN_SOFT_SHELL_WINDOW * 2)) - (base_offset * 2);
@@ -330,9 +359,15 @@ namespace Crypto
             offset = base_offset;
         }
 
-        uint64_t scratchpad = CN_SOFT_SHELL_MEMORY + (static_cast<uint64_t>(offset) * CN_SOFT_SHELL_PAD_MULTIPLIER);
+        scratchpad = CN_SOFT_SHELL_MEMORY + (static_cast<uint64_t>(offset) * CN_SOFT_SHELL_PAD_MULTIPLIER);
         scratchpad = (static_cast<uint64_t>(scratchpad / 128)) * 128;
-        uint64_t iterations = CN_SOFT_SHELL_ITER + (static_cast<uint64_t>(offset) * CN_SOFT_SHELL_ITER_MULTIPLIER);
+        iterations = CN_SOFT_SHELL_ITER + (static_cast<uint64_t>(offset) * CN_SOFT_SHELL_ITER_MULTIPLIER);
+    }
+
+    inline void cn_soft_shell_slow_hash_v0(const void *data, size_t length, Hash &hash, uint64_t height)
+    {
+        uint64_t scratchpad, iterations;
+        cn_soft_shell_parameters(height, scratchpad, iterations);
         uint64_t pagesize = scratchpad;
 
         cn_slow_hash(data, length, reinterpret_cast<char *>(&hash), 1, 0, 0, pagesize, scratchpad, iterations);
@@ -340,16 +375,8 @@ namespace Crypto
 
     inline void cn_soft_shell_slow_hash_v1(const void *data, size_t length, Hash &hash, uint64_t height)
     {
-        uint64_t base_offset = (height % CN_SOFT_SHELL_WINDOW);
-        int64_t offset = (height % (CN_SOFT_SHELL_WINDOW * 2)) - (base_offset * 2);
-        if (offset < 0)
-        {
-            offset = base_offset;
-        }
-
-        uint64_t scratchpad = CN_SOFT_SHELL_MEMORY + (static_cast<uint64_t>(offset) * CN_SOFT_SHELL_PAD_MULTIPLIER);
-        scratchpad = (static_cast<uint64_t>(scratchpad / 128)) * 128;
-        uint64_t iterations = CN_SOFT_SHELL_ITER + (static_cast<uint64_t>(offset) * CN_SOFT_SHELL_ITER_MULTIPLIER);
+        uint64_t scratchpad, iterations;
+        cn_soft_shell_parameters(height, scratchpad, iterations);
         uint64_t pagesize = scratchpad;
 
         cn_slow_hash(data, length, reinterpret_cast<char *>(&hash), 1, 1, 0, pagesize, scratchpad, iterations);
@@ -357,21 +384,89 @@ namespace Crypto
 
     inline void cn_soft_shell_slow_hash_v2(const void *data, size_t length, Hash &hash, uint64_t height)
     {
-        uint64_t base_offset = (height % CN_SOFT_SHELL_WINDOW);
-        int64_t offset = (height % (CN_SOFT_SHELL_WINDOW * 2)) - (base_offset * 2);
-        if (offset < 0)
-        {
-            offset = base_offset;
-        }
-
-        uint64_t scratchpad = CN_SOFT_SHELL_MEMORY + (static_cast<uint64_t>(offset) * CN_SOFT_SHELL_PAD_MULTIPLIER);
-        scratchpad = (static_cast<uint64_t>(scratchpad / 128)) * 128;
-        uint64_t iterations = CN_SOFT_SHELL_ITER + (static_cast<uint64_t>(offset) * CN_SOFT_SHELL_ITER_MULTIPLIER);
+        uint64_t scratchpad, iterations;
+        cn_soft_shell_parameters(height, scratchpad, iterations);
         uint64_t pagesize = scratchpad;
 
         cn_slow_hash(data, length, reinterpret_cast<char *>(&hash), 1, 2, 0, pagesize, scratchpad, iterations);
     }
 
+    // Batched CryptoNight, all inputs are hashed with the same parameters
+    inline void cn_slow_hash_batch(
+        const void *const *data,
+        const size_t *length,
+        size_t count,
+        Hash *hashes,
+        int light,
+        int variant,
+        uint64_t page_size,
+        uint64_t scratchpad,
+        uint64_t iterations)
+    {
+        cn_slow_hash_batch(
+            data,
+            length,
+            count,
+            reinterpret_cast<char(*)[HASH_SIZE]>(hashes),
+            light,
+            variant,
+            0,
+            page_size,
+            scratchpad,
+            iterations);
+    }
+
+    /* Owns the Argon2 block memory used for Chukwa so that it is allocated once and reused
+       across hashes, instead of being malloc'd and securely wiped for every hash. The inputs
+       are public block headers, so the wipe protects nothing. A context must only be used by
+       one thread at a time, threadContext() hands out one per thread. */
+    class ChukwaContext
+    {
+      public:
+        /* Sizes the memory up front for the given Argon2 memory cost (in KiB) and thread
+           count. With hugePages the memory is requested in huge pages where the platform
+           supports it, falling back to the heap otherwise. */
+        explicit ChukwaContext(
+            const size_t memory = CHUKWA_MEMORY_V2,
+            const size_t threads = CHUKWA_THREADS_V2,
+            const bool hugePages = false);
+
+        ~ChukwaContext();
+
+        ChukwaContext(const ChukwaContext &) = delete;
+
+        ChukwaContext &operator=(const ChukwaContext &) = delete;
+
+        /* Returns false if Argon2 rejected the parameters or the memory could not be grown */
+        bool hash(
+            const void *data,
+            size_t length,
+            Hash &hash,
+            const size_t iterations,
+            const size_t memory,
+            const size_t threads);
+
+        bool hash_v1(const void *data, size_t length, Hash &hash);
+
+        bool hash_v2(const void *data, size_t length, Hash &hash);
+
+        /* The calling thread's context, created on first use and sized for Chukwa v2 */
+        static ChukwaContext &threadContext();
+
+      private:
+        bool reserve(const size_t bytes);
+
+        void release();
+
+        uint8_t *m_memory = nullptr;
+
+        size_t m_size = 0;
+
+        bool m_hugePages;
+
+        bool m_mapped = false;
+    };
+
     inline void chukwa_slow_hash_base(
         const void *data,
         size_t length,
@@ -380,23 +475,7 @@ namespace Crypto
         const size_t memory,
         const size_t threads)
     {
-        uint8_t salt[CHUKWA_SALTLEN];
-        memcpy(salt, data, sizeof(salt));
-
-        /* If this is the first time we've called this hash function then
-           we need to have the Argon2 library check to see if any of the
-           available CPU instruction sets are going to help us out */
-        if (!argon2_optimization_selected)
-        {
-            /* Call the library quick benchmark test to set which CPU
-               instruction sets will be used */
-            argon2_select_impl(NULL, NULL);
-
-            argon2_optimization_selected = true;
-        }
-
-        argon2id_hash_raw(
-            iterations, memory, threads, data, length, salt, CHUKWA_SALTLEN, hash.data, CHUKWA_HASHLEN);
+        ChukwaContext::threadContext().hash(data, length, hash, iterations, memory, threads);
     }
 
     inline void chukwa_slow_hash_v1(const void *data, size_t length, Hash &hash)
@@ -420,6 +499,24 @@ namespace Crypto
             reinterpret_cast<const char(*)[HASH_SIZE]>(hashes), count, reinterpret_cast<char(*)[HASH_SIZE]>(branch));
     }
 
+    inline void tree_hash_with_scratch(const Hash *hashes, size_t count, Hash *scratch, Hash &root_hash)
+    {
+        tree_hash_with_scratch(
+            reinterpret_cast<const char(*)[HASH_SIZE]>(hashes),
+            count,
+            reinterpret_cast<char(*)[HASH_SIZE]>(scratch),
+            reinterpret_cast<char *>(&root_hash));
+    }
+
+    inline void tree_branch_with_scratch(const Hash *hashes, size_t count, Hash *scratch, Hash *branch)
+    {
+        tree_branch_with_scratch(
+            reinterpret_cast<const char(*)[HASH_SIZE]>(hashes),
+            count,
+            reinterpret_cast<char(*)[HASH_SIZE]>(scratch),
+            reinterpret_cast<char(*)[HASH_SIZE]>(branch));
+    }
+
     inline void
         tree_hash_from_branch(const Hash *branch, size_t depth, const Hash &leaf, const void *path, Hash &root_hash)
     {
@@ -4,6 +4,7 @@
 #ifndef KECCAK_H
 #define KECCAK_H
 
+#include <stddef.h>
 #include <stdint.h>
 #include <string.h>
 
@@ -11,16 +12,48 @@
 #define KECCAK_ROUNDS 24
 #endif
 
+// the number of states that keccakf_multi updates
+#define KECCAK_MAX_STATES 8
+
+// keccakf_multi uses AVX2 or AVX-512 when the processor supports them, unless KECCAK_NO_SIMD is defined
+#if !defined(KECCAK_NO_SIMD) && defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define KECCAK_SIMD
+#endif
+
 #ifndef ROTL64
 #define ROTL64(x, y) (((x) << (y)) | ((x) >> (64 - (y))))
 #endif
 
+// the state of an incremental keccak hash
+typedef struct
+{
+    uint64_t st[25];
+    uint8_t buf[144];
+    size_t pos;
+    int rsiz;
+    int mdlen;
+} keccak_ctx;
+
 // compute a keccak hash (md) of given byte length from "in"
-int keccak(const uint8_t *in, int inlen, uint8_t *md, int mdlen);
+int keccak(const uint8_t *in, size_t inlen, uint8_t *md, int mdlen);
+
+// compute a keccak hash of given byte length from input passed to any number of keccak_update calls
+void keccak_init(keccak_ctx *ctx, int mdlen);
+
+void keccak_update(keccak_ctx *ctx, const uint8_t *in, size_t inlen);
+
+// write the hash to md, the context must be initialised again before it is reused
+void keccak_final(keccak_ctx *ctx, uint8_t *md);
 
 // update the state
 void keccakf(uint64_t st[25], int norounds);
 
-void keccak1600(const uint8_t *in, int inlen, uint8_t *md);
+// the number of states keccakf_multi updates in one permutation on this processor (1, 4 or 8)
+size_t keccakf_multi_ways(void);
+
+// update the first count (at most KECCAK_MAX_STATES) states, interleaved so that word i of state j is st[i][j]
+void keccakf_multi(uint64_t st[25][KECCAK_MAX_STATES], size_t count, int norounds);
+
+void keccak1600(const uint8_t *in, size_t inlen, uint8_t *md);
 
 #endif
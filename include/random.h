@@ -1,48 +1,72 @@
-// Copyright (c) 2019, The TurtleCoin Developers
+// Copyright (c) 2019-2020, The TurtleCoin Developers
+//
+// Please see the included LICENSE file for more information.
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <random>
+#include <vector>
 
 namespace Random
 {
-    /* Used to obtain a random seed */
-    static thread_local std::random_device device;
-
-    /* Generator, seeded with the random device */
-    static thread_local std::mt19937 gen(device());
-
-    /* The distribution to get numbers for - in this case, uint8_t */
-    static std::uniform_int_distribution<int> distribution {0, std::numeric_limits<uint8_t>::max()};
-
     /**
      * Generate n random bytes (uint8_t), and place them in *result. Result should be large
      * enough to contain the bytes.
+     *
+     * Every thread has its own ChaCha20 keystream generator, seeded from the OS, which
+     * produces its output a kilobyte at a time. Each kilobyte refill also replaces the
+     * key with keystream that is never handed out, and fresh OS entropy is mixed into it
+     * every megabyte, so earlier output can not be recovered from the state.
+     *
+     * The state is not reseeded across fork(). A child process carries on from its
+     * parent's key and buffered keystream, so the two produce the same bytes until the
+     * next reseed, and a process that forks should not rely on this in the child.
      */
-    inline void randomBytes(size_t n, uint8_t *result)
-    {
-        for (size_t i = 0; i < n; i++)
-        {
-            result[i] = distribution(gen);
-        }
-    }
+    void randomBytes(size_t n, uint8_t *result);
 
     /**
      * Generate n random bytes (uint8_t), and return them in a vector.
      */
     inline std::vector<uint8_t> randomBytes(size_t n)
     {
-        std::vector<uint8_t> result;
+        std::vector<uint8_t> result(n);
 
-        result.reserve(n);
+        randomBytes(n, result.data());
 
-        for (size_t i = 0; i < n; i++)
+        return result;
+    }
+
+    /**
+     * A UniformRandomBitGenerator drawing from the same keystream as randomBytes, to be
+     * used with the standard distributions and algorithms
+     */
+    class Generator
+    {
+      public:
+        typedef uint64_t result_type;
+
+        static constexpr result_type min()
         {
-            result.push_back(distribution(gen));
+            return std::numeric_limits<result_type>::min();
         }
 
-        return result;
-    }
+        static constexpr result_type max()
+        {
+            return std::numeric_limits<result_type>::max();
+        }
+
+        result_type operator()()
+        {
+            result_type result;
+
+            randomBytes(sizeof(result), reinterpret_cast<uint8_t *>(&result));
+
+            return result;
+        }
+    };
 
     /**
      * Generate a random value of the type specified, in the full range of the
@@ -50,6 +74,8 @@ namespace Random
      */
     template<typename T> T randomValue()
     {
+        Generator gen;
+
         std::uniform_int_distribution<T> distribution {std::numeric_limits<T>::min(), std::numeric_limits<T>::max()};
 
         return distribution(gen);
@@ -64,16 +90,18 @@ namespace Random
      */
     template<typename T> T randomValue(T min, T max)
     {
+        Generator gen;
+
         std::uniform_int_distribution<T> distribution {min, max};
         return distribution(gen);
     }
 
     /**
-     * Obtain the generator used internally. Helpful for passing to functions
-     * like std::shuffle.
+     * Obtain a generator drawing from the thread's keystream. Helpful for passing
+     * to functions like std::shuffle.
      */
-    inline std::mt19937 generator()
+    inline Generator generator()
     {
-        return gen;
+        return Generator();
     }
 } // namespace Random
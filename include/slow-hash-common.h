@@ -25,6 +25,9 @@
 #define INIT_SIZE_BLK 8
 #define INIT_SIZE_BYTE (INIT_SIZE_BLK * AES_BLOCK_SIZE)
 
+// Scratchpads up to this size are hashed four at a time by cn_slow_hash_batch, larger ones two at a time
+#define CN_SLOW_HASH_BATCH_SMALL_PAGE 524288
+
 extern void aesb_single_round(const uint8_t *in, uint8_t *out, const uint8_t *expandedKey);
 extern void aesb_pseudo_round(const uint8_t *in, uint8_t *out, const uint8_t *expandedKey);
 
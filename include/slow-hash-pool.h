@@ -0,0 +1,117 @@
+// Copyright (c) 2018-2020, The TurtleCoin Developers
+//
+// Please see the included LICENSE file for more information.
+
+#pragma once
+
+#include "hash.h"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Crypto
+{
+    /* Every proof-of-work algorithm that can be handed to the SlowHashPool */
+    enum class SlowHashAlgorithm
+    {
+        CN_V0,
+        CN_V1,
+        CN_V2,
+        CN_LITE_V0,
+        CN_LITE_V1,
+        CN_LITE_V2,
+        CN_DARK_V0,
+        CN_DARK_V1,
+        CN_DARK_V2,
+        CN_DARK_LITE_V0,
+        CN_DARK_LITE_V1,
+        CN_DARK_LITE_V2,
+        CN_TURTLE_V0,
+        CN_TURTLE_V1,
+        CN_TURTLE_V2,
+        CN_TURTLE_LITE_V0,
+        CN_TURTLE_LITE_V1,
+        CN_TURTLE_LITE_V2,
+        CN_SOFT_SHELL_V0,
+        CN_SOFT_SHELL_V1,
+        CN_SOFT_SHELL_V2,
+        CHUKWA_V1,
+        CHUKWA_V2
+    };
+
+    struct SlowHashJob
+    {
+        std::vector<uint8_t> blob;
+
+        SlowHashAlgorithm algorithm;
+
+        /* Only used by the soft shell variants */
+        uint64_t height;
+    };
+
+    /* Hashes a single blob with the given algorithm */
+    void slow_hash(const void *data, size_t length, SlowHashAlgorithm algorithm, uint64_t height, Hash &hash);
+
+    /* A fixed set of worker threads that verify proof-of-work hashes in bulk. Jobs
+       are split into chunks which the workers pull from a shared queue, so that
+       slow jobs do not hold up the rest of the batch. Each worker keeps its own
+       scratchpad for the lifetime of the pool. */
+    class SlowHashPool
+    {
+      public:
+        /* A threads value of 0 uses one worker per hardware thread. When pinThreads
+           is set (and supported by the platform) worker N is bound to CPU N. */
+        explicit SlowHashPool(size_t threads = 0, bool pinThreads = false);
+
+        /* Finishes every batch already queued, running its callback, before returning */
+        ~SlowHashPool();
+
+        SlowHashPool(const SlowHashPool &) = delete;
+
+        SlowHashPool &operator=(const SlowHashPool &) = delete;
+
+        /* Hashes every job, the results are in the same order as the jobs. A
+           chunkSize of 0 picks one that gives each worker several chunks. */
+        std::future<std::vector<Hash>> hash(std::vector<SlowHashJob> jobs, size_t chunkSize = 0);
+
+        /* As above, but the callback is invoked from a worker thread once every job is done */
+        void hash(
+            std::vector<SlowHashJob> jobs,
+            std::function<void(std::vector<Hash>)> callback,
+            size_t chunkSize = 0);
+
+        size_t threads() const;
+
+      private:
+        struct Batch;
+
+        struct Chunk
+        {
+            std::shared_ptr<Batch> batch;
+
+            size_t begin;
+
+            size_t end;
+        };
+
+        void enqueue(std::shared_ptr<Batch> batch, size_t chunkSize);
+
+        void worker(size_t index);
+
+        std::vector<std::thread> m_workers;
+
+        std::deque<Chunk> m_queue;
+
+        std::mutex m_mutex;
+
+        std::condition_variable m_haveWork;
+
+        bool m_stop = false;
+    };
+} // namespace Crypto
@@ -0,0 +1,70 @@
+// Copyright (c) 2018-2020, The TurtleCoin Developers
+//
+// Please see the included LICENSE file for more information.
+
+#pragma once
+
+#include <CryptoTypes.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Crypto
+{
+    /* Maps the public spend keys of a wallet container to their subwallet index. The
+       keys are kept in an open-addressing table with linear probing, where each slot is
+       only 8 bytes (a fingerprint of the key and its index), so a lookup usually touches
+       a single cache line before the one full key comparison. Compressed points are
+       uniformly distributed, so the key bytes are used directly as the hash. */
+    class SubwalletKeyIndex
+    {
+      public:
+        /* Returned by find when the key is not in the index */
+        static const size_t npos = SIZE_MAX;
+
+        SubwalletKeyIndex() = default;
+
+        /* Subwallet i is publicSpendKeys[i], even if a key appears more than once. find
+           then returns the first subwallet with the key. */
+        explicit SubwalletKeyIndex(const std::vector<PublicKey> &publicSpendKeys);
+
+        /* Adds the key as the next subwallet and returns its index. If the key is already
+           present nothing is added and the existing index is returned. */
+        size_t add(const PublicKey &publicSpendKey);
+
+        /* Makes room for count keys in total without further rehashing */
+        void reserve(const size_t count);
+
+        size_t find(const PublicKey &publicSpendKey) const;
+
+        bool contains(const PublicKey &publicSpendKey) const;
+
+        const PublicKey &operator[](const size_t index) const;
+
+        const std::vector<PublicKey> &keys() const;
+
+        size_t size() const;
+
+        bool empty() const;
+
+      private:
+        struct Slot
+        {
+            uint32_t fingerprint;
+
+            /* The subwallet index plus one, zero marks an empty slot */
+            uint32_t index;
+        };
+
+        /* Appends the key as the next subwallet whether or not it is already present */
+        size_t insert(const PublicKey &publicSpendKey);
+
+        void rehash(const size_t slotCount);
+
+        std::vector<PublicKey> m_keys;
+
+        std::vector<Slot> m_slots;
+
+        size_t m_mask = 0;
+    };
+} // namespace Crypto
@@ -0,0 +1,59 @@
+// Copyright (c) 2018-2020, The TurtleCoin Developers
+//
+// Please see the included LICENSE file for more information.
+
+#pragma once
+
+#include <CryptoTypes.h>
+#include <cstddef>
+#include <vector>
+
+namespace Crypto
+{
+    /* Builds the tree_hash of a list of leaves that grows one hash at a time, such as the
+       transactions of a block template. Alongside the leaves it keeps the root of every
+       complete, aligned subtree of them (about one extra hash per leaf), which appending a
+       leaf extends with amortised O(1) hashes.
+
+       The tree_hash pairs the last 2 * (n - cnt) leaves from the end, where cnt is the
+       largest power of two below n, so appending a leaf moves every one of those pairs.
+       root() reuses each cached subtree the new shape still contains and only hashes the
+       rest: O(log n) hashes when n is a power of two or just above one, and no more than
+       recomputing the tree in the worst case. */
+    class TreeHashAccumulator
+    {
+      public:
+        TreeHashAccumulator() = default;
+
+        explicit TreeHashAccumulator(const std::vector<Hash> &leaves);
+
+        void append(const Hash &leaf);
+
+        void append(const Hash *leaves, const size_t count);
+
+        /* Makes room for count leaves in total */
+        void reserve(const size_t count);
+
+        void clear();
+
+        /* The same root as tree_hash over every leaf appended so far, there must be at least one */
+        Hash root() const;
+
+        const std::vector<Hash> &leaves() const;
+
+        size_t size() const;
+
+        bool empty() const;
+
+      private:
+        /* The root of the 2^level leaves starting at first */
+        Hash leafRange(const size_t level, const size_t first) const;
+
+        /* Node index of the given level of the tree over cnt slots, where the first
+           rawSlots slots are leaves and the rest are the hashes of pairs of leaves */
+        Hash slotNode(const size_t level, const size_t index, const size_t rawSlots) const;
+
+        /* m_levels[0] is the leaves, m_levels[k][i] is the root of leaves [i * 2^k, (i + 1) * 2^k) */
+        std::vector<std::vector<Hash>> m_levels;
+    };
+} // namespace Crypto
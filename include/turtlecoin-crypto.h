@@ -28,6 +28,130 @@ extern "C"
 
     namespace Core
     {
+        /* The binary counterpart of Cryptography below, for callers that already hold keys and
+           hashes in their binary form. Arguments are taken by reference and results are written
+           to output parameters, so nothing is parsed, formatted or allocated on the way to the
+           primitive. Every hex method of Cryptography with a counterpart here is an adapter over
+           it. The slow hashes are already available in this form in hash.h. */
+        class BinaryCryptography
+        {
+          public:
+            /* Hashing Methods */
+            static void cn_fast_hash(const void *data, const size_t length, Crypto::Hash &hash);
+
+            static void tree_hash(const Crypto::Hash *hashes, const size_t count, Crypto::Hash &hash);
+
+            /* branch must have room for tree_depth(count) hashes */
+            static void tree_branch(const Crypto::Hash *hashes, const size_t count, Crypto::Hash *branch);
+
+            static void tree_hash_from_branch(
+                const Crypto::Hash *branches,
+                const size_t depth,
+                const Crypto::Hash &leaf,
+                const void *path,
+                Crypto::Hash &hash);
+
+            /* Crypto Methods */
+            static bool checkRingSignature(
+                const Crypto::Hash &prefixHash,
+                const Crypto::KeyImage &keyImage,
+                const Crypto::PublicKey *publicKeys,
+                const Crypto::Signature *signatures,
+                const size_t count);
+
+            static void generatePrivateViewKeyFromPrivateSpendKey(
+                const Crypto::SecretKey &privateSpendKey,
+                Crypto::SecretKey &privateViewKey);
+
+            static void generateViewKeysFromPrivateSpendKey(
+                const Crypto::SecretKey &privateSpendKey,
+                Crypto::SecretKey &privateViewKey,
+                Crypto::PublicKey &publicViewKey);
+
+            static void generateKeys(Crypto::SecretKey &privateKey, Crypto::PublicKey &publicKey);
+
+            static bool checkKey(const Crypto::PublicKey &publicKey);
+
+            static bool secretKeyToPublicKey(const Crypto::SecretKey &privateKey, Crypto::PublicKey &publicKey);
+
+            static bool generateKeyDerivation(
+                const Crypto::PublicKey &publicKey,
+                const Crypto::SecretKey &privateKey,
+                Crypto::KeyDerivation &derivation);
+
+            static bool generateKeyDerivationScalar(
+                const Crypto::PublicKey &publicKey,
+                const Crypto::SecretKey &privateKey,
+                const uint64_t outputIndex,
+                Crypto::EllipticCurveScalar &derivationScalar);
+
+            static void derivationToScalar(
+                const Crypto::KeyDerivation &derivation,
+                const uint64_t outputIndex,
+                Crypto::EllipticCurveScalar &derivationScalar);
+
+            static bool derivePublicKey(
+                const Crypto::KeyDerivation &derivation,
+                const uint64_t outputIndex,
+                const Crypto::PublicKey &publicKey,
+                Crypto::PublicKey &derivedKey);
+
+            static bool derivePublicKey(
+                const Crypto::EllipticCurveScalar &derivationScalar,
+                const Crypto::PublicKey &publicKey,
+                Crypto::PublicKey &derivedKey);
+
+            static void deriveSecretKey(
+                const Crypto::KeyDerivation &derivation,
+                const uint64_t outputIndex,
+                const Crypto::SecretKey &privateKey,
+                Crypto::SecretKey &derivedKey);
+
+            static void deriveSecretKey(
+                const Crypto::EllipticCurveScalar &derivationScalar,
+                const Crypto::SecretKey &privateKey,
+                Crypto::SecretKey &derivedKey);
+
+            static bool underivePublicKey(
+                const Crypto::KeyDerivation &derivation,
+                const uint64_t outputIndex,
+                const Crypto::PublicKey &derivedKey,
+                Crypto::PublicKey &publicKey);
+
+            static void generateSignature(
+                const Crypto::Hash &prefixHash,
+                const Crypto::PublicKey &publicKey,
+                const Crypto::SecretKey &privateKey,
+                Crypto::Signature &signature);
+
+            static bool checkSignature(
+                const Crypto::Hash &prefixHash,
+                const Crypto::PublicKey &publicKey,
+                const Crypto::Signature &signature);
+
+            static void generateKeyImage(
+                const Crypto::PublicKey &publicKey,
+                const Crypto::SecretKey &privateKey,
+                Crypto::KeyImage &keyImage);
+
+            static void scalarmultKey(
+                const Crypto::KeyImage &keyImageA,
+                const Crypto::KeyImage &keyImageB,
+                Crypto::KeyImage &keyImage);
+
+            static void hashToEllipticCurve(const Crypto::Hash &hash, Crypto::PublicKey &ellipticCurve);
+
+            static void scReduce32(Crypto::EllipticCurveScalar &scalar);
+
+            static void hashToScalar(const void *data, const size_t length, Crypto::EllipticCurveScalar &scalar);
+
+            static bool generateDeterministicSubwalletKeys(
+                const Crypto::SecretKey &basePrivateKey,
+                const uint64_t walletIndex,
+                Crypto::SecretKey &privateKey,
+                Crypto::PublicKey &publicKey);
+        };
+
         class Cryptography
         {
           public:
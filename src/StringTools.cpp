@@ -5,9 +5,18 @@
 
 #include "StringTools.h"
 
+#include <cstring>
 #include <fstream>
 #include <iomanip>
 
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define HEX_X86_SIMD
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define HEX_NEON
+#include <arm_neon.h>
+#endif
+
 namespace Common
 {
     namespace
@@ -29,6 +38,284 @@ namespace Common
             0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
             0xff, 0xff, 0xff, 0xff};
 
+        const char hexDigits[] = "0123456789abcdef";
+
+        /* Decodes the hex characters of text[0, 2 * size) into data[0, size), returns false on
+           any invalid character */
+        bool decodeHexScalar(const char *text, uint64_t size, uint8_t *data)
+        {
+            uint8_t invalid = 0;
+
+            for (uint64_t i = 0; i < size; ++i)
+            {
+                const uint8_t high = characterValues[static_cast<unsigned char>(text[i << 1])];
+
+                const uint8_t low = characterValues[static_cast<unsigned char>(text[(i << 1) + 1])];
+
+                invalid |= high | low;
+
+                data[i] = high << 4 | low;
+            }
+
+            return invalid <= 0x0f;
+        }
+
+        void encodeHexScalar(const uint8_t *data, uint64_t size, char *text)
+        {
+            for (uint64_t i = 0; i < size; ++i)
+            {
+                text[i << 1] = hexDigits[data[i] >> 4];
+                text[(i << 1) + 1] = hexDigits[data[i] & 15];
+            }
+        }
+
+        typedef bool (*HexDecoder)(const char *, uint64_t, uint8_t *);
+
+        typedef void (*HexEncoder)(const uint8_t *, uint64_t, char *);
+
+#if defined(HEX_X86_SIMD)
+        /* The value of each of the 16 characters, with 0xff in every byte if any of them is
+           not a hex digit. Digits are c - '0' <= 9 and letters are (c | 0x20) - 'a' <= 5 as
+           unsigned bytes, so every other character lands above both bounds. */
+        __attribute__((target("sse4.1"))) inline __m128i hexValues128(const __m128i chars, __m128i &invalid)
+        {
+            const __m128i digits = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+
+            const __m128i letters = _mm_sub_epi8(_mm_or_si128(chars, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+
+            const __m128i isDigit = _mm_cmpeq_epi8(_mm_min_epu8(digits, _mm_set1_epi8(9)), digits);
+
+            const __m128i isLetter = _mm_cmpeq_epi8(_mm_min_epu8(letters, _mm_set1_epi8(5)), letters);
+
+            invalid = _mm_or_si128(invalid, _mm_andnot_si128(_mm_or_si128(isDigit, isLetter), _mm_set1_epi8(-1)));
+
+            return _mm_blendv_epi8(_mm_add_epi8(letters, _mm_set1_epi8(10)), digits, isDigit);
+        }
+
+        __attribute__((target("sse4.1"))) bool decodeHexSse41(const char *text, uint64_t size, uint8_t *data)
+        {
+            __m128i invalid = _mm_setzero_si128();
+
+            uint64_t i = 0;
+
+            for (; i + 8 <= size; i += 8)
+            {
+                const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i *>(text + (i << 1)));
+
+                const __m128i values = hexValues128(chars, invalid);
+
+                /* Each pair of characters becomes high * 16 + low in a 16 bit lane */
+                const __m128i bytes = _mm_maddubs_epi16(values, _mm_set1_epi16(0x0110));
+
+                _mm_storel_epi64(reinterpret_cast<__m128i *>(data + i), _mm_packus_epi16(bytes, bytes));
+            }
+
+            return _mm_testz_si128(invalid, invalid) && decodeHexScalar(text + (i << 1), size - i, data + i);
+        }
+
+        __attribute__((target("sse4.1"))) void encodeHexSse41(const uint8_t *data, uint64_t size, char *text)
+        {
+            const __m128i digits = _mm_loadu_si128(reinterpret_cast<const __m128i *>(hexDigits));
+
+            uint64_t i = 0;
+
+            for (; i + 16 <= size; i += 16)
+            {
+                const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+
+                const __m128i high =
+                    _mm_shuffle_epi8(digits, _mm_and_si128(_mm_srli_epi16(bytes, 4), _mm_set1_epi8(15)));
+
+                const __m128i low = _mm_shuffle_epi8(digits, _mm_and_si128(bytes, _mm_set1_epi8(15)));
+
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(text + (i << 1)), _mm_unpacklo_epi8(high, low));
+
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(text + (i << 1) + 16), _mm_unpackhi_epi8(high, low));
+            }
+
+            encodeHexScalar(data + i, size - i, text + (i << 1));
+        }
+
+        __attribute__((target("avx2"))) bool decodeHexAvx2(const char *text, uint64_t size, uint8_t *data)
+        {
+            __m256i invalid = _mm256_setzero_si256();
+
+            uint64_t i = 0;
+
+            for (; i + 16 <= size; i += 16)
+            {
+                const __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(text + (i << 1)));
+
+                const __m256i digits = _mm256_sub_epi8(chars, _mm256_set1_epi8('0'));
+
+                const __m256i letters =
+                    _mm256_sub_epi8(_mm256_or_si256(chars, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+
+                const __m256i isDigit = _mm256_cmpeq_epi8(_mm256_min_epu8(digits, _mm256_set1_epi8(9)), digits);
+
+                const __m256i isLetter = _mm256_cmpeq_epi8(_mm256_min_epu8(letters, _mm256_set1_epi8(5)), letters);
+
+                invalid = _mm256_or_si256(
+                    invalid, _mm256_andnot_si256(_mm256_or_si256(isDigit, isLetter), _mm256_set1_epi8(-1)));
+
+                const __m256i values =
+                    _mm256_blendv_epi8(_mm256_add_epi8(letters, _mm256_set1_epi8(10)), digits, isDigit);
+
+                const __m256i bytes = _mm256_maddubs_epi16(values, _mm256_set1_epi16(0x0110));
+
+                /* The pack works within each 128 bit lane, so gather the low 8 bytes of both lanes */
+                const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(bytes, bytes), 0x08);
+
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(data + i), _mm256_castsi256_si128(packed));
+            }
+
+            return _mm256_testz_si256(invalid, invalid) && decodeHexSse41(text + (i << 1), size - i, data + i);
+        }
+
+        __attribute__((target("avx2"))) void encodeHexAvx2(const uint8_t *data, uint64_t size, char *text)
+        {
+            const __m256i digits =
+                _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i *>(hexDigits)));
+
+            uint64_t i = 0;
+
+            for (; i + 32 <= size; i += 32)
+            {
+                const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+
+                const __m256i high =
+                    _mm256_shuffle_epi8(digits, _mm256_and_si256(_mm256_srli_epi16(bytes, 4), _mm256_set1_epi8(15)));
+
+                const __m256i low = _mm256_shuffle_epi8(digits, _mm256_and_si256(bytes, _mm256_set1_epi8(15)));
+
+                /* The unpacks interleave within each 128 bit lane, so the halves are swapped back in order */
+                const __m256i first = _mm256_unpacklo_epi8(high, low);
+
+                const __m256i second = _mm256_unpackhi_epi8(high, low);
+
+                _mm256_storeu_si256(
+                    reinterpret_cast<__m256i *>(text + (i << 1)), _mm256_permute2x128_si256(first, second, 0x20));
+
+                _mm256_storeu_si256(
+                    reinterpret_cast<__m256i *>(text + (i << 1) + 32), _mm256_permute2x128_si256(first, second, 0x31));
+            }
+
+            encodeHexSse41(data + i, size - i, text + (i << 1));
+        }
+#elif defined(HEX_NEON)
+        bool decodeHexNeon(const char *text, uint64_t size, uint8_t *data)
+        {
+            uint8x16_t invalid = vdupq_n_u8(0);
+
+            uint64_t i = 0;
+
+            for (; i + 16 <= size; i += 16)
+            {
+                /* Splits the even (high) and odd (low) characters of the 32 */
+                const uint8x16x2_t chars = vld2q_u8(reinterpret_cast<const uint8_t *>(text + (i << 1)));
+
+                uint8x16_t values[2];
+
+                for (int j = 0; j < 2; j++)
+                {
+                    const uint8x16_t digits = vsubq_u8(chars.val[j], vdupq_n_u8('0'));
+
+                    const uint8x16_t letters = vsubq_u8(vorrq_u8(chars.val[j], vdupq_n_u8(0x20)), vdupq_n_u8('a'));
+
+                    const uint8x16_t isDigit = vcleq_u8(digits, vdupq_n_u8(9));
+
+                    const uint8x16_t isLetter = vcleq_u8(letters, vdupq_n_u8(5));
+
+                    invalid = vorrq_u8(invalid, vmvnq_u8(vorrq_u8(isDigit, isLetter)));
+
+                    values[j] = vbslq_u8(isDigit, digits, vaddq_u8(letters, vdupq_n_u8(10)));
+                }
+
+                vst1q_u8(data + i, vorrq_u8(vshlq_n_u8(values[0], 4), values[1]));
+            }
+
+            return vmaxvq_u8(invalid) == 0 && decodeHexScalar(text + (i << 1), size - i, data + i);
+        }
+
+        void encodeHexNeon(const uint8_t *data, uint64_t size, char *text)
+        {
+            const uint8x16_t digits = vld1q_u8(reinterpret_cast<const uint8_t *>(hexDigits));
+
+            uint64_t i = 0;
+
+            for (; i + 16 <= size; i += 16)
+            {
+                const uint8x16_t bytes = vld1q_u8(data + i);
+
+                uint8x16x2_t chars;
+
+                chars.val[0] = vqtbl1q_u8(digits, vshrq_n_u8(bytes, 4));
+
+                chars.val[1] = vqtbl1q_u8(digits, vandq_u8(bytes, vdupq_n_u8(15)));
+
+                vst2q_u8(reinterpret_cast<uint8_t *>(text + (i << 1)), chars);
+            }
+
+            encodeHexScalar(data + i, size - i, text + (i << 1));
+        }
+#endif
+
+        HexDecoder selectHexDecoder()
+        {
+#if defined(HEX_X86_SIMD)
+            if (__builtin_cpu_supports("avx2"))
+            {
+                return decodeHexAvx2;
+            }
+
+            if (__builtin_cpu_supports("sse4.1"))
+            {
+                return decodeHexSse41;
+            }
+#elif defined(HEX_NEON)
+            return decodeHexNeon;
+#endif
+
+            return decodeHexScalar;
+        }
+
+        HexEncoder selectHexEncoder()
+        {
+#if defined(HEX_X86_SIMD)
+            if (__builtin_cpu_supports("avx2"))
+            {
+                return encodeHexAvx2;
+            }
+
+            if (__builtin_cpu_supports("sse4.1"))
+            {
+                return encodeHexSse41;
+            }
+#elif defined(HEX_NEON)
+            return encodeHexNeon;
+#endif
+
+            return encodeHexScalar;
+        }
+    }
+
+    bool decodeHex(const char *text, uint64_t size, void *data)
+    {
+        static const HexDecoder decoder = selectHexDecoder();
+
+        if ((size & 1) != 0)
+        {
+            return false;
+        }
+
+        return decoder(text, size >> 1, static_cast<uint8_t *>(data));
+    }
+
+    void encodeHex(const void *data, uint64_t size, char *text)
+    {
+        static const HexEncoder encoder = selectHexEncoder();
+
+        encoder(static_cast<const uint8_t *>(data), size, text);
     }
 
     std::string asString(const void *data, uint64_t size)
@@ -82,9 +369,9 @@ namespace Common
             throw std::runtime_error("fromHex: invalid buffer size");
         }
 
-        for (uint64_t i = 0; i<text.size()>> 1; ++i)
+        if (!decodeHex(text.data(), text.size(), data))
         {
-            static_cast<uint8_t *>(data)[i] = fromHex(text[i << 1]) << 4 | fromHex(text[(i << 1) + 1]);
+            throw std::runtime_error("fromHex: invalid character");
         }
 
         return text.size() >> 1;
@@ -102,23 +389,9 @@ namespace Common
             return false;
         }
 
-        for (uint64_t i = 0; i<text.size()>> 1; ++i)
+        if (!decodeHex(text.data(), text.size(), data))
         {
-            uint8_t value1;
-
-            if (!fromHex(text[i << 1], value1))
-            {
-                return false;
-            }
-
-            uint8_t value2;
-
-            if (!fromHex(text[(i << 1) + 1], value2))
-            {
-                return false;
-            }
-
-            static_cast<uint8_t *>(data)[i] = value1 << 4 | value2;
+            return false;
         }
 
         size = text.size() >> 1;
@@ -133,9 +406,10 @@ namespace Common
         }
 
         std::vector<uint8_t> data(text.size() >> 1);
-        for (uint64_t i = 0; i < data.size(); ++i)
+
+        if (!decodeHex(text.data(), text.size(), data.data()))
         {
-            data[i] = fromHex(text[i << 1]) << 4 | fromHex(text[(i << 1) + 1]);
+            throw std::runtime_error("fromHex: invalid character");
         }
 
         return data;
@@ -148,23 +422,15 @@ namespace Common
             return false;
         }
 
-        for (uint64_t i = 0; i<text.size()>> 1; ++i)
-        {
-            uint8_t value1;
+        const auto offset = data.size();
 
-            if (!fromHex(text[i << 1], value1))
-            {
-                return false;
-            }
-
-            uint8_t value2;
+        data.resize(offset + (text.size() >> 1));
 
-            if (!fromHex(text[(i << 1) + 1], value2))
-            {
-                return false;
-            }
+        if (!decodeHex(text.data(), text.size(), data.data() + offset))
+        {
+            data.resize(offset);
 
-            data.push_back(value1 << 4 | value2);
+            return false;
         }
 
         return true;
@@ -172,44 +438,30 @@ namespace Common
 
     std::string toHex(const void *data, uint64_t size)
     {
-        std::string text;
-        for (uint64_t i = 0; i < size; ++i)
-        {
-            text += "0123456789abcdef"[static_cast<const uint8_t *>(data)[i] >> 4];
-            text += "0123456789abcdef"[static_cast<const uint8_t *>(data)[i] & 15];
-        }
+        std::string text(size << 1, '\0');
+
+        encodeHex(data, size, &text[0]);
 
         return text;
     }
 
     void toHex(const void *data, uint64_t size, std::string &text)
     {
-        for (uint64_t i = 0; i < size; ++i)
-        {
-            text += "0123456789abcdef"[static_cast<const uint8_t *>(data)[i] >> 4];
-            text += "0123456789abcdef"[static_cast<const uint8_t *>(data)[i] & 15];
-        }
+        const auto offset = text.size();
+
+        text.resize(offset + (size << 1));
+
+        encodeHex(data, size, &text[offset]);
     }
 
     std::string toHex(const std::vector<uint8_t> &data)
     {
-        std::string text;
-        for (uint64_t i = 0; i < data.size(); ++i)
-        {
-            text += "0123456789abcdef"[data[i] >> 4];
-            text += "0123456789abcdef"[data[i] & 15];
-        }
-
-        return text;
+        return toHex(data.data(), data.size());
     }
 
     void toHex(const std::vector<uint8_t> &data, std::string &text)
     {
-        for (uint64_t i = 0; i < data.size(); ++i)
-        {
-            text += "0123456789abcdef"[data[i] >> 4];
-            text += "0123456789abcdef"[data[i] & 15];
-        }
+        toHex(data.data(), data.size(), text);
     }
 
     std::string extract(std::string &text, char delimiter)
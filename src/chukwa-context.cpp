@@ -0,0 +1,178 @@
+// Copyright (c) 2018-2020, The TurtleCoin Developers
+//
+// Please see the included LICENSE file for more information.
+
+#include "hash.h"
+
+#include <cstdlib>
+#include <mutex>
+
+#if defined(_MSC_VER) || defined(__MINGW32__)
+#include <malloc.h>
+#else
+#include <sys/mman.h>
+#endif
+
+namespace Crypto
+{
+    /* Argon2 blocks are 1KiB, aligning them to a cache line keeps each one in as few lines as possible */
+    static const size_t CHUKWA_MEMORY_ALIGNMENT = 64;
+
+    static const size_t CHUKWA_HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+    static std::once_flag argon2_selection;
+
+    const char *select_argon2_optimization(const char *implementation)
+    {
+        std::call_once(argon2_selection, [implementation]() {
+            const char *forced = implementation != nullptr ? implementation : std::getenv("ARGON2_IMPL");
+
+            /* Otherwise run the library's quick benchmark to pick which CPU instruction sets to use */
+            if (forced == nullptr || argon2_force_impl(forced) != 0)
+            {
+                argon2_select_impl(NULL, NULL);
+            }
+        });
+
+        return argon2_selected_impl_name();
+    }
+
+    ChukwaContext::ChukwaContext(const size_t memory, const size_t threads, const bool hugePages):
+        m_hugePages(hugePages)
+    {
+        reserve(argon2_memory_size(static_cast<uint32_t>(memory), static_cast<uint32_t>(threads)));
+    }
+
+    ChukwaContext::~ChukwaContext()
+    {
+        release();
+    }
+
+    bool ChukwaContext::hash(
+        const void *data,
+        size_t length,
+        Hash &hash,
+        const size_t iterations,
+        const size_t memory,
+        const size_t threads)
+    {
+        select_argon2_optimization();
+
+        uint8_t salt[CHUKWA_SALTLEN];
+        memcpy(salt, data, sizeof(salt));
+
+        const size_t memorySize = argon2_memory_size(static_cast<uint32_t>(memory), static_cast<uint32_t>(threads));
+
+        if (!reserve(memorySize))
+        {
+            return false;
+        }
+
+        /* The same parameters argon2id_hash_raw uses, except for the memory handling */
+        argon2_context context = {};
+
+        context.out = hash.data;
+        context.outlen = CHUKWA_HASHLEN;
+        context.pwd = static_cast<uint8_t *>(const_cast<void *>(data));
+        context.pwdlen = static_cast<uint32_t>(length);
+        context.salt = salt;
+        context.saltlen = CHUKWA_SALTLEN;
+        context.t_cost = static_cast<uint32_t>(iterations);
+        context.m_cost = static_cast<uint32_t>(memory);
+        context.lanes = static_cast<uint32_t>(threads);
+        context.threads = static_cast<uint32_t>(threads);
+        context.version = ARGON2_VERSION_NUMBER;
+        context.flags = ARGON2_FLAG_NO_CLEAR_MEMORY;
+
+        return argon2_ctx_mem(&context, Argon2_id, m_memory, memorySize) == ARGON2_OK;
+    }
+
+    bool ChukwaContext::hash_v1(const void *data, size_t length, Hash &hash)
+    {
+        return this->hash(data, length, hash, CHUKWA_ITERS_V1, CHUKWA_MEMORY_V1, CHUKWA_THREADS_V1);
+    }
+
+    bool ChukwaContext::hash_v2(const void *data, size_t length, Hash &hash)
+    {
+        return this->hash(data, length, hash, CHUKWA_ITERS_V2, CHUKWA_MEMORY_V2, CHUKWA_THREADS_V2);
+    }
+
+    ChukwaContext &ChukwaContext::threadContext()
+    {
+        thread_local ChukwaContext context;
+
+        return context;
+    }
+
+    bool ChukwaContext::reserve(const size_t bytes)
+    {
+        if (m_memory != nullptr && m_size >= bytes)
+        {
+            return true;
+        }
+
+        release();
+
+#if !defined(_MSC_VER) && !defined(__MINGW32__) && defined(MAP_HUGETLB)
+        if (m_hugePages)
+        {
+            const size_t size = (bytes + CHUKWA_HUGE_PAGE_SIZE - 1) / CHUKWA_HUGE_PAGE_SIZE * CHUKWA_HUGE_PAGE_SIZE;
+
+            void *memory = mmap(0, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+
+            if (memory != MAP_FAILED)
+            {
+                m_memory = static_cast<uint8_t *>(memory);
+
+                m_size = size;
+
+                m_mapped = true;
+
+                return true;
+            }
+        }
+#endif
+
+#if defined(_MSC_VER) || defined(__MINGW32__)
+        m_memory = static_cast<uint8_t *>(_aligned_malloc(bytes, CHUKWA_MEMORY_ALIGNMENT));
+#else
+        void *memory = nullptr;
+
+        if (posix_memalign(&memory, CHUKWA_MEMORY_ALIGNMENT, bytes) == 0)
+        {
+            m_memory = static_cast<uint8_t *>(memory);
+        }
+#endif
+
+        m_size = m_memory != nullptr ? bytes : 0;
+
+        return m_memory != nullptr;
+    }
+
+    void ChukwaContext::release()
+    {
+        if (m_memory == nullptr)
+        {
+            return;
+        }
+
+#if !defined(_MSC_VER) && !defined(__MINGW32__)
+        if (m_mapped)
+        {
+            munmap(m_memory, m_size);
+        }
+        else
+        {
+            free(m_memory);
+        }
+#else
+        _aligned_free(m_memory);
+#endif
+
+        m_memory = nullptr;
+
+        m_size = 0;
+
+        m_mapped = false;
+    }
+} // namespace Crypto
@@ -5,15 +5,18 @@
 //
 // Please see the included LICENSE file for more information.
 
-#ifndef __FreeBSD__
-#include <alloca.h>
-#endif
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
+#include <list>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 #if defined(_MSC_VER)
@@ -33,12 +36,35 @@ namespace Crypto
 #include "keccak.h"
     }
 
+    /* How many scalars random_scalars reduces from a single read of the keystream */
+    static const size_t RANDOM_SCALAR_BATCH = 16;
+
+    static inline void random_scalars(EllipticCurveScalar *res, size_t count)
+    {
+        unsigned char tmp[RANDOM_SCALAR_BATCH][64];
+
+        while (count > 0)
+        {
+            const size_t batch = std::min(count, RANDOM_SCALAR_BATCH);
+
+            Random::randomBytes(sizeof(tmp[0]) * batch, tmp[0]);
+
+            sc_batch_reduce(tmp, batch);
+
+            for (size_t i = 0; i < batch; i++)
+            {
+                memcpy(&res[i], tmp[i], 32);
+            }
+
+            res += batch;
+
+            count -= batch;
+        }
+    }
+
     static inline void random_scalar(EllipticCurveScalar &res)
     {
-        unsigned char tmp[64];
-        Random::randomBytes(64, tmp);
-        sc_reduce(tmp);
-        memcpy(&res, tmp, 32);
+        random_scalars(&res, 1);
     }
 
     static inline void hash_to_scalar(const void *data, size_t length, EllipticCurveScalar &res)
@@ -57,6 +83,25 @@ namespace Crypto
         hash_to_scalar(data, length, res);
     }
 
+    void crypto_ops::randomScalar(EllipticCurveScalar &scalar)
+    {
+        random_scalar(scalar);
+    }
+
+    void crypto_ops::randomScalars(EllipticCurveScalar *scalars, const size_t count)
+    {
+        random_scalars(scalars, count);
+    }
+
+    std::vector<EllipticCurveScalar> crypto_ops::randomScalars(const size_t count)
+    {
+        std::vector<EllipticCurveScalar> scalars(count);
+
+        random_scalars(scalars.data(), count);
+
+        return scalars;
+    }
+
     void crypto_ops::generate_keys(PublicKey &pub, SecretKey &sec)
     {
         ge_p3 point;
@@ -130,6 +175,62 @@ namespace Crypto
         return true;
     }
 
+    struct PrecomputedPoint::Tables
+    {
+        ge_p3 point;
+
+        ge_cached cached;
+
+        ge_fixed_base multiples;
+    };
+
+    PrecomputedPoint::PrecomputedPoint(const PublicKey &key): m_key(key)
+    {
+        std::shared_ptr<Tables> tables = std::make_shared<Tables>();
+
+        if (ge_frombytes_vartime(&tables->point, reinterpret_cast<const unsigned char *>(&key)) != 0)
+        {
+            return;
+        }
+
+        ge_p3_to_cached(&tables->cached, &tables->point);
+
+        ge_fixed_base_precomp(tables->multiples, &tables->point);
+
+        m_tables = tables;
+    }
+
+    bool PrecomputedPoint::valid() const
+    {
+        return m_tables != nullptr;
+    }
+
+    const PublicKey &PrecomputedPoint::key() const
+    {
+        return m_key;
+    }
+
+    bool crypto_ops::generate_key_derivation(
+        const PrecomputedPoint &key1,
+        const SecretKey &key2,
+        KeyDerivation &derivation)
+    {
+        ge_p3 point;
+        ge_p2 point2;
+        ge_p1p1 point3;
+        assert(sc_check(reinterpret_cast<const unsigned char *>(&key2)) == 0);
+        if (!key1.valid())
+        {
+            return false;
+        }
+        ge_scalarmult_fixed_base(&point, reinterpret_cast<const unsigned char *>(&key2), key1.m_tables->multiples);
+        ge_p3_to_p2(&point2, &point);
+        ge_mul8(&point3, &point2);
+        ge_p1p1_to_p2(&point2, &point3);
+        ge_tobytes(reinterpret_cast<unsigned char *>(&derivation), &point2);
+        return true;
+    }
+
     void
         crypto_ops::derivation_to_scalar(const KeyDerivation &derivation, size_t output_index, EllipticCurveScalar &res)
     {
@@ -200,6 +301,36 @@ namespace Crypto
         return true;
     }
 
+    bool crypto_ops::derive_public_key(
+        const KeyDerivation &derivation,
+        size_t output_index,
+        const PrecomputedPoint &base,
+        PublicKey &derived_key)
+    {
+        EllipticCurveScalar derivationScalar;
+        derivation_to_scalar(derivation, output_index, derivationScalar);
+        return derive_public_key(derivationScalar, base, derived_key);
+    }
+
+    bool crypto_ops::derive_public_key(
+        const EllipticCurveScalar &derivationScalar,
+        const PrecomputedPoint &base,
+        PublicKey &derived_key)
+    {
+        ge_p3 point2;
+        ge_p1p1 point4;
+        ge_p2 point5;
+        if (!base.valid())
+        {
+            return false;
+        }
+        ge_scalarmult_base(&point2, reinterpret_cast<const unsigned char *>(&derivationScalar));
+        ge_add(&point4, &point2, &base.m_tables->cached);
+        ge_p1p1_to_p2(&point5, &point4);
+        ge_tobytes(reinterpret_cast<unsigned char *>(&derived_key), &point5);
+        return true;
+    }
+
     bool crypto_ops::derive_public_key(
         const KeyDerivation &derivation,
         size_t output_index,
@@ -347,6 +478,19 @@ namespace Crypto
     }
 
 
+    bool crypto_ops::is_output_for(
+        const KeyDerivation &derivation,
+        size_t output_index,
+        const PublicKey &derived_key,
+        const PrecomputedPoint &base)
+    {
+        /* Hs(D || i)G + B == P is the same check as P - Hs(D || i)G == B, but skips the
+           square root that decompressing P would need */
+        PublicKey expected;
+        return derive_public_key(derivation, output_index, base, expected) && expected == derived_key;
+    }
+
+
     struct s_comm
     {
         Hash h;
@@ -418,6 +562,76 @@ namespace Crypto
         return sc_isnonzero(reinterpret_cast<unsigned char *>(&c)) == 0;
     }
 
+    /* Calls func(i) for every i in [0, count), spread over the given number of threads */
+    template<typename F> static void parallel_for(const size_t count, size_t threads, F func)
+    {
+        threads = std::min(threads, count);
+
+        if (threads <= 1)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                func(i);
+            }
+
+            return;
+        }
+
+        std::atomic<size_t> next(0);
+
+        auto work = [&]() {
+            for (size_t i = next++; i < count; i = next++)
+            {
+                func(i);
+            }
+        };
+
+        std::vector<std::thread> workers;
+
+        for (size_t i = 1; i < threads; i++)
+        {
+            workers.emplace_back(work);
+        }
+
+        work();
+
+        for (auto &worker : workers)
+        {
+            worker.join();
+        }
+    }
+
+    /* How many key pairs generate_keys_batch compresses with a single inversion */
+    static const size_t KEYS_BATCH_SIZE = GE_P2_TOBYTES_BATCH;
+
+    void crypto_ops::generate_keys_batch(
+        const size_t count,
+        PublicKey *publicKeys,
+        SecretKey *secretKeys,
+        const size_t threads)
+    {
+        parallel_for((count + KEYS_BATCH_SIZE - 1) / KEYS_BATCH_SIZE, threads, [&](const size_t batch) {
+            const size_t begin = batch * KEYS_BATCH_SIZE;
+
+            const size_t length = std::min(KEYS_BATCH_SIZE, count - begin);
+
+            ge_p2 points[KEYS_BATCH_SIZE];
+
+            random_scalars(reinterpret_cast<EllipticCurveScalar *>(secretKeys + begin), length);
+
+            for (size_t i = 0; i < length; i++)
+            {
+                ge_p3 point;
+
+                ge_scalarmult_base(&point, reinterpret_cast<const unsigned char *>(&secretKeys[begin + i]));
+
+                ge_p3_to_p2(&points[i], &point);
+            }
+
+            ge_p2_tobytes_batch(reinterpret_cast<unsigned char(*)[32]>(publicKeys + begin), points, length);
+        });
+    }
+
     static void hash_to_ec(const PublicKey &key, ge_p3 &res)
     {
         Hash h;
@@ -429,6 +643,267 @@ namespace Crypto
         ge_p1p1_to_p3(&res, &point2);
     }
 
+    /* The decompressed forms of a ring member, shared by every ring it appears in */
+    struct ring_member_points
+    {
+        ge_p3 point;
+
+        ge_p3 hashed;
+
+        bool valid;
+    };
+
+    /* The cache behind crypto_ops::setRingMemberCacheSize. Keys are spread over a number
+       of shards, each with its own lock and least recently used list, so that threads
+       checking different rings rarely wait on one another */
+    class RingMemberCache
+    {
+      public:
+        bool enabled() const
+        {
+            return m_capacity.load(std::memory_order_relaxed) != 0;
+        }
+
+        bool get(const PublicKey &key, ring_member_points &points)
+        {
+            Shard &shard = shardOf(key);
+
+            std::lock_guard<std::mutex> lock(shard.mutex);
+
+            const auto it = shard.index.find(key);
+
+            if (it == shard.index.end())
+            {
+                m_misses.fetch_add(1, std::memory_order_relaxed);
+
+                return false;
+            }
+
+            shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+
+            points = it->second->second;
+
+            m_hits.fetch_add(1, std::memory_order_relaxed);
+
+            return true;
+        }
+
+        void put(const PublicKey &key, const ring_member_points &points)
+        {
+            Shard &shard = shardOf(key);
+
+            std::lock_guard<std::mutex> lock(shard.mutex);
+
+            if (shard.capacity == 0 || shard.index.count(key) != 0)
+            {
+                return;
+            }
+
+            shard.entries.emplace_front(key, points);
+
+            shard.index.emplace(key, shard.entries.begin());
+
+            shard.evict();
+        }
+
+        /* The capacity is split exactly between the shards, so the cache never holds more
+           than capacity entries. Small caches use fewer shards, down to a single one, so
+           that every shard keeps enough entries for its LRU order to be meaningful */
+        void resize(const size_t capacity)
+        {
+            const size_t shardCount =
+                std::max<size_t>(1, std::min(capacity / MIN_SHARD_ENTRIES, static_cast<size_t>(SHARDS)));
+
+            std::unique_lock<std::mutex> locks[SHARDS];
+
+            for (size_t i = 0; i < SHARDS; i++)
+            {
+                locks[i] = std::unique_lock<std::mutex>(m_shards[i].mutex);
+            }
+
+            /* Keys change shard along with the shard count, so take every entry out, the
+               least recently used of each shard first, and put them back afterwards */
+            std::vector<std::pair<PublicKey, ring_member_points>> entries;
+
+            if (shardCount != m_shardCount.load(std::memory_order_relaxed))
+            {
+                for (auto &shard : m_shards)
+                {
+                    entries.insert(entries.end(), shard.entries.rbegin(), shard.entries.rend());
+
+                    shard.entries.clear();
+
+                    shard.index.clear();
+                }
+            }
+
+            for (size_t i = 0; i < SHARDS; i++)
+            {
+                m_shards[i].capacity =
+                    i < shardCount ? capacity / shardCount + (i < capacity % shardCount ? 1 : 0) : 0;
+            }
+
+            m_shardCount.store(shardCount, std::memory_order_relaxed);
+
+            m_capacity.store(capacity, std::memory_order_relaxed);
+
+            for (const auto &entry : entries)
+            {
+                Shard &shard = m_shards[shardIndex(entry.first, shardCount)];
+
+                shard.entries.push_front(entry);
+
+                shard.index.emplace(entry.first, shard.entries.begin());
+            }
+
+            for (auto &shard : m_shards)
+            {
+                shard.evict();
+            }
+        }
+
+        void clear()
+        {
+            for (auto &shard : m_shards)
+            {
+                std::lock_guard<std::mutex> lock(shard.mutex);
+
+                shard.entries.clear();
+
+                shard.index.clear();
+            }
+
+            m_hits.store(0, std::memory_order_relaxed);
+
+            m_misses.store(0, std::memory_order_relaxed);
+        }
+
+        RingMemberCacheStats stats()
+        {
+            RingMemberCacheStats stats;
+
+            stats.hits = m_hits.load(std::memory_order_relaxed);
+
+            stats.misses = m_misses.load(std::memory_order_relaxed);
+
+            stats.capacity = m_capacity.load(std::memory_order_relaxed);
+
+            for (auto &shard : m_shards)
+            {
+                std::lock_guard<std::mutex> lock(shard.mutex);
+
+                stats.size += shard.entries.size();
+            }
+
+            return stats;
+        }
+
+      private:
+        static const size_t SHARDS = 16;
+
+        /* A cache is only split into another shard for every this many entries */
+        static const size_t MIN_SHARD_ENTRIES = 64;
+
+        struct Shard
+        {
+            typedef std::list<std::pair<PublicKey, ring_member_points>> Entries;
+
+            std::mutex mutex;
+
+            Entries entries;
+
+            std::unordered_map<PublicKey, Entries::iterator> index;
+
+            size_t capacity = 0;
+
+            void evict()
+            {
+                while (entries.size() > capacity)
+                {
+                    index.erase(entries.back().first);
+
+                    entries.pop_back();
+                }
+            }
+        };
+
+        static size_t shardIndex(const PublicKey &key, const size_t shardCount)
+        {
+            /* std::hash<PublicKey> buckets on the leading bytes, so pick the shard from the
+               trailing ones to keep the keys of a shard spread over its buckets */
+            return reinterpret_cast<const unsigned char *>(&key)[30] % shardCount;
+        }
+
+        /* A lookup racing a resize may pick a shard by the old count. That costs at most a
+           miss, and an entry put into a shard beyond the new count is refused, as the shard
+           is left with no capacity */
+        Shard &shardOf(const PublicKey &key)
+        {
+            return m_shards[shardIndex(key, m_shardCount.load(std::memory_order_relaxed))];
+        }
+
+        Shard m_shards[SHARDS];
+
+        std::atomic<size_t> m_shardCount {1};
+
+        std::atomic<size_t> m_capacity {0};
+
+        std::atomic<uint64_t> m_hits {0};
+
+        std::atomic<uint64_t> m_misses {0};
+    };
+
+    static RingMemberCache &ring_member_cache()
+    {
+        static RingMemberCache cache;
+
+        return cache;
+    }
+
+    /* Decompresses a ring member and hashes it to the curve, going through the ring member
+       cache when it is enabled. Returns false if the key is not a valid point, in which
+       case member.hashed is left unset */
+    static bool load_ring_member(const PublicKey &key, ring_member_points &member)
+    {
+        RingMemberCache &cache = ring_member_cache();
+
+        const bool cached = cache.enabled();
+
+        if (cached && cache.get(key, member))
+        {
+            return member.valid;
+        }
+
+        member.valid = ge_frombytes_vartime(&member.point, reinterpret_cast<const unsigned char *>(&key)) == 0;
+
+        if (member.valid)
+        {
+            hash_to_ec(key, member.hashed);
+        }
+
+        if (cached)
+        {
+            cache.put(key, member);
+        }
+
+        return member.valid;
+    }
+
+    void crypto_ops::setRingMemberCacheSize(const size_t capacity)
+    {
+        ring_member_cache().resize(capacity);
+    }
+
+    RingMemberCacheStats crypto_ops::getRingMemberCacheStats()
+    {
+        return ring_member_cache().stats();
+    }
+
+    void crypto_ops::clearRingMemberCache()
+    {
+        ring_member_cache().clear();
+    }
+
     KeyImage crypto_ops::scalarmultKey(const KeyImage &P, const KeyImage &a)
     {
         ge_p3 A;
@@ -458,7 +933,21 @@ namespace Crypto
         ge_p3 point;
         ge_p2 point2;
         assert(sc_check(reinterpret_cast<const unsigned char *>(&sec)) == 0);
-        hash_to_ec(pub, point);
+
+        /* A wallet generates the key image of an output again whenever it spends or rescans
+           it, so go through the ring member cache if it is on. Only the hash is needed, and
+           it is computed directly for keys that are not valid points */
+        ring_member_points member;
+
+        if (ring_member_cache().enabled() && load_ring_member(pub, member))
+        {
+            point = member.hashed;
+        }
+        else
+        {
+            hash_to_ec(pub, point);
+        }
+
         ge_scalarmult(&point2, reinterpret_cast<const unsigned char *>(&sec), &point);
         ge_tobytes(reinterpret_cast<unsigned char *>(&image), &point2);
     }
@@ -497,7 +986,14 @@ namespace Crypto
         ge_dsmp image_pre;
         Crypto::EllipticCurveScalar sum, h;
 
-        rs_comm *const buf = reinterpret_cast<rs_comm *>(alloca(rs_comm_size(publicKeys.size())));
+        /* Both buffers grow with the ring, which callers such as the Node addon take straight
+           from their input, so they live on the heap rather than the stack */
+        std::vector<uint8_t> bufStorage(rs_comm_size(publicKeys.size()));
+
+        rs_comm *const buf = reinterpret_cast<rs_comm *>(bufStorage.data());
+
+        /* The a and b points of every ring member, encoded together once the loop is done */
+        std::vector<ge_p2> points(2 * publicKeys.size());
 
         if (ge_frombytes_vartime(&image_unp, reinterpret_cast<const unsigned char *>(&keyImage)) != 0)
         {
@@ -510,49 +1006,43 @@ namespace Crypto
 
         buf->h = prefixHash;
 
+        /* The c and r of every decoy are random, so draw them all from the keystream at once */
+        random_scalars(reinterpret_cast<EllipticCurveScalar *>(signatures.data()), 2 * signatures.size());
+
         for (size_t i = 0; i < publicKeys.size(); i++)
         {
-            ge_p2 tmp2;
             ge_p3 tmp3;
 
             if (i == realOutput)
             {
+                signatures[i] = Signature();
                 ge_scalarmult_base(&tmp3, reinterpret_cast<const unsigned char *>(&k));
-                ge_p3_tobytes(reinterpret_cast<unsigned char *>(&buf->ab[i].a), &tmp3);
+                ge_p3_to_p2(&points[2 * i], &tmp3);
                 hash_to_ec(publicKeys[i], tmp3);
-                ge_scalarmult(&tmp2, reinterpret_cast<const unsigned char *>(&k), &tmp3);
-                ge_tobytes(reinterpret_cast<unsigned char *>(&buf->ab[i].b), &tmp2);
+                ge_scalarmult(&points[2 * i + 1], reinterpret_cast<const unsigned char *>(&k), &tmp3);
             }
             else
             {
-                random_scalar(reinterpret_cast<EllipticCurveScalar &>(signatures[i]));
-                random_scalar(
-                    *reinterpret_cast<EllipticCurveScalar *>(reinterpret_cast<unsigned char *>(&signatures[i]) + 32));
+                ring_member_points member;
 
-                if (ge_frombytes_vartime(&tmp3, reinterpret_cast<const unsigned char *>(&publicKeys[i])) != 0)
+                if (!load_ring_member(publicKeys[i], member))
                 {
                     return false;
                 }
 
                 ge_double_scalarmult_base_vartime(
-                    &tmp2,
+                    &points[2 * i],
                     reinterpret_cast<unsigned char *>(&signatures[i]),
-                    &tmp3,
+                    &member.point,
                     reinterpret_cast<unsigned char *>(&signatures[i]) + 32);
 
-                ge_tobytes(reinterpret_cast<unsigned char *>(&buf->ab[i].a), &tmp2);
-
-                hash_to_ec(publicKeys[i], tmp3);
-
                 ge_double_scalarmult_precomp_vartime(
-                    &tmp2,
+                    &points[2 * i + 1],
                     reinterpret_cast<unsigned char *>(&signatures[i]) + 32,
-                    &tmp3,
+                    &member.hashed,
                     reinterpret_cast<unsigned char *>(&signatures[i]),
                     image_pre);
 
-                ge_tobytes(reinterpret_cast<unsigned char *>(&buf->ab[i].b), &tmp2);
-
                 sc_add(
                     reinterpret_cast<unsigned char *>(&sum),
                     reinterpret_cast<unsigned char *>(&sum),
@@ -560,6 +1050,8 @@ namespace Crypto
             }
         }
 
+        ge_p2_tobytes_batch(reinterpret_cast<unsigned char(*)[32]>(buf->ab), points.data(), 2 * publicKeys.size());
+
         hash_to_scalar(buf, rs_comm_size(publicKeys.size()), h);
 
         sc_sub(
@@ -631,6 +1123,21 @@ namespace Crypto
         const KeyImage &image,
         const std::vector<PublicKey> pubs,
         const std::vector<Signature> signatures)
+    {
+        if (pubs.size() != signatures.size())
+        {
+            return false;
+        }
+
+        return checkRingSignature(prefix_hash, image, pubs.data(), signatures.data(), pubs.size());
+    }
+
+    bool crypto_ops::checkRingSignature(
+        const Hash &prefix_hash,
+        const KeyImage &image,
+        const PublicKey *pubs,
+        const Signature *signatures,
+        const size_t count)
     {
         ge_p3 image_unp;
 
@@ -638,7 +1145,12 @@ namespace Crypto
 
         EllipticCurveScalar sum, h;
 
-        rs_comm *const buf = reinterpret_cast<rs_comm *>(alloca(rs_comm_size(pubs.size())));
+        std::vector<uint8_t> bufStorage(rs_comm_size(count));
+
+        rs_comm *const buf = reinterpret_cast<rs_comm *>(bufStorage.data());
+
+        /* The a and b points of every ring member, encoded together once the loop is done */
+        std::vector<ge_p2> points(2 * count);
 
         if (ge_frombytes_vartime(&image_unp, reinterpret_cast<const unsigned char *>(&image)) != 0)
         {
@@ -656,10 +1168,9 @@ namespace Crypto
 
         buf->h = prefix_hash;
 
-        for (size_t i = 0; i < pubs.size(); i++)
+        for (size_t i = 0; i < count; i++)
         {
-            ge_p2 tmp2;
-            ge_p3 tmp3;
+            ring_member_points member;
 
             if (sc_check(reinterpret_cast<const unsigned char *>(&signatures[i])) != 0
                 || sc_check(reinterpret_cast<const unsigned char *>(&signatures[i]) + 32) != 0)
@@ -667,37 +1178,109 @@ namespace Crypto
                 return false;
             }
 
-            if (ge_frombytes_vartime(&tmp3, reinterpret_cast<const unsigned char *>(&pubs[i])) != 0)
+            if (!load_ring_member(pubs[i], member))
             {
                 return false;
             }
 
             ge_double_scalarmult_base_vartime(
-                &tmp2,
+                &points[2 * i],
                 reinterpret_cast<const unsigned char *>(&signatures[i]),
-                &tmp3,
+                &member.point,
                 reinterpret_cast<const unsigned char *>(&signatures[i]) + 32);
 
-            ge_tobytes(reinterpret_cast<unsigned char *>(&buf->ab[i].a), &tmp2);
-
-            hash_to_ec(pubs[i], tmp3);
-
             ge_double_scalarmult_precomp_vartime(
-                &tmp2,
+                &points[2 * i + 1],
                 reinterpret_cast<const unsigned char *>(&signatures[i]) + 32,
-                &tmp3,
+                &member.hashed,
                 reinterpret_cast<const unsigned char *>(&signatures[i]),
                 image_pre);
 
-            ge_tobytes(reinterpret_cast<unsigned char *>(&buf->ab[i].b), &tmp2);
-
             sc_add(
                 reinterpret_cast<unsigned char *>(&sum),
                 reinterpret_cast<unsigned char *>(&sum),
                 reinterpret_cast<const unsigned char *>(&signatures[i]));
         }
 
-        hash_to_scalar(buf, rs_comm_size(pubs.size()), h);
+        ge_p2_tobytes_batch(reinterpret_cast<unsigned char(*)[32]>(buf->ab), points.data(), 2 * count);
+
+        hash_to_scalar(buf, rs_comm_size(count), h);
+
+        sc_sub(
+            reinterpret_cast<unsigned char *>(&h),
+            reinterpret_cast<unsigned char *>(&h),
+            reinterpret_cast<unsigned char *>(&sum));
+
+        return sc_isnonzero(reinterpret_cast<unsigned char *>(&h)) == 0;
+    }
+
+    /* Same as checkRingSignature, but the ring members have already been decompressed
+       and hashed to the curve. members[i] holds the points of check.publicKeys[i] */
+    static bool check_ring_signature(const RingSignatureCheck &check, const ring_member_points *const *members)
+    {
+        ge_p3 image_unp;
+
+        ge_dsmp image_pre;
+
+        EllipticCurveScalar sum, h;
+
+        const size_t count = check.publicKeys.size();
+
+        if (count == 0 || check.signatures.size() != count)
+        {
+            return false;
+        }
+
+        std::vector<uint8_t> bufStorage(rs_comm_size(count));
+
+        rs_comm *const buf = reinterpret_cast<rs_comm *>(bufStorage.data());
+
+        std::vector<ge_p2> points(2 * count);
+
+        if (ge_frombytes_vartime(&image_unp, reinterpret_cast<const unsigned char *>(&check.keyImage)) != 0)
+        {
+            return false;
+        }
+
+        ge_dsm_precomp(image_pre, &image_unp);
+
+        if (ge_check_subgroup_precomp_vartime(image_pre) != 0)
+        {
+            return false;
+        }
+
+        sc_0(reinterpret_cast<unsigned char *>(&sum));
+
+        buf->h = check.prefixHash;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            const unsigned char *signature = reinterpret_cast<const unsigned char *>(&check.signatures[i]);
+
+            if (sc_check(signature) != 0 || sc_check(signature + 32) != 0)
+            {
+                return false;
+            }
+
+            if (!members[i]->valid)
+            {
+                return false;
+            }
+
+            ge_double_scalarmult_base_vartime(&points[2 * i], signature, &members[i]->point, signature + 32);
+
+            ge_double_scalarmult_precomp_vartime(
+                &points[2 * i + 1], signature + 32, &members[i]->hashed, signature, image_pre);
+
+            sc_add(
+                reinterpret_cast<unsigned char *>(&sum),
+                reinterpret_cast<unsigned char *>(&sum),
+                signature);
+        }
+
+        ge_p2_tobytes_batch(reinterpret_cast<unsigned char(*)[32]>(buf->ab), points.data(), 2 * count);
+
+        hash_to_scalar(buf, rs_comm_size(count), h);
 
         sc_sub(
             reinterpret_cast<unsigned char *>(&h),
@@ -707,6 +1290,241 @@ namespace Crypto
         return sc_isnonzero(reinterpret_cast<unsigned char *>(&h)) == 0;
     }
 
+    bool crypto_ops::checkRingSignatures(
+        const std::vector<RingSignatureCheck> &checks,
+        std::vector<bool> &results,
+        const size_t threads)
+    {
+        /* Ring members are frequently reused as decoys across the inputs of a block,
+           so collect the unique ones and do the expensive decompression and hash_to_ec
+           only once for each of them */
+        std::unordered_map<PublicKey, size_t> uniqueIndexes;
+
+        std::vector<const PublicKey *> uniqueKeys;
+
+        std::vector<size_t> memberIndexes;
+
+        for (const auto &check : checks)
+        {
+            for (const auto &key : check.publicKeys)
+            {
+                const auto inserted = uniqueIndexes.emplace(key, uniqueKeys.size());
+
+                if (inserted.second)
+                {
+                    uniqueKeys.push_back(&key);
+                }
+
+                memberIndexes.push_back(inserted.first->second);
+            }
+        }
+
+        std::vector<ring_member_points> points(uniqueKeys.size());
+
+        parallel_for(uniqueKeys.size(), threads, [&](const size_t i) { load_ring_member(*uniqueKeys[i], points[i]); });
+
+        std::vector<const ring_member_points *> members(memberIndexes.size());
+
+        std::vector<size_t> offsets(checks.size());
+
+        for (size_t i = 0, offset = 0; i < checks.size(); offset += checks[i].publicKeys.size(), i++)
+        {
+            offsets[i] = offset;
+
+            for (size_t j = 0; j < checks[i].publicKeys.size(); j++)
+            {
+                members[offset + j] = &points[memberIndexes[offset + j]];
+            }
+        }
+
+        /* std::vector<bool> packs its elements, so the threads write to bytes instead */
+        std::vector<uint8_t> valid(checks.size());
+
+        parallel_for(checks.size(), threads, [&](const size_t i) {
+            valid[i] = check_ring_signature(checks[i], members.data() + offsets[i]);
+        });
+
+        results.assign(valid.begin(), valid.end());
+
+        return std::all_of(valid.begin(), valid.end(), [](const uint8_t v) { return v != 0; });
+    }
+
+    bool crypto_ops::checkRingSignatures(const std::vector<RingSignatureCheck> &checks, const size_t threads)
+    {
+        std::vector<bool> results;
+
+        return checkRingSignatures(checks, results, threads);
+    }
+
+    /* The number of transaction keys or outputs each scanning task handles, which
+       is also how many encodings share each field inversion in ge_p2_tobytes_batch */
+    static const size_t SCAN_BATCH_SIZE = GE_P2_TOBYTES_BATCH;
+
+    bool crypto_ops::scanTransactions(
+        const SecretKey &privateViewKey,
+        const SubwalletKeyIndex &publicSpendKeys,
+        const std::vector<TransactionOutputRecord> &records,
+        std::vector<OwnedOutput> &ownedOutputs,
+        const size_t threads)
+    {
+        ownedOutputs.clear();
+
+        if (sc_check(reinterpret_cast<const unsigned char *>(&privateViewKey)) != 0)
+        {
+            return false;
+        }
+
+        /* Every output of a transaction shares its public key, so only decompress it and
+           generate the key derivation once */
+        std::unordered_map<PublicKey, size_t> txKeyIndexes;
+
+        std::vector<const PublicKey *> txKeys;
+
+        std::vector<size_t> recordTxKeys(records.size());
+
+        for (size_t i = 0; i < records.size(); i++)
+        {
+            const auto inserted = txKeyIndexes.emplace(records[i].txPublicKey, txKeys.size());
+
+            if (inserted.second)
+            {
+                txKeys.push_back(&records[i].txPublicKey);
+            }
+
+            recordTxKeys[i] = inserted.first->second;
+        }
+
+        std::vector<KeyDerivation> derivations(txKeys.size());
+
+        std::vector<uint8_t> validDerivations(txKeys.size());
+
+        parallel_for((txKeys.size() + SCAN_BATCH_SIZE - 1) / SCAN_BATCH_SIZE, threads, [&](const size_t batch) {
+            const size_t begin = batch * SCAN_BATCH_SIZE;
+
+            const size_t count = std::min(SCAN_BATCH_SIZE, txKeys.size() - begin);
+
+            ge_p2 points[SCAN_BATCH_SIZE];
+
+            for (size_t i = 0; i < count; i++)
+            {
+                ge_p3 point;
+                ge_p1p1 point2;
+
+                validDerivations[begin + i] =
+                    ge_frombytes_vartime(&point, reinterpret_cast<const unsigned char *>(txKeys[begin + i])) == 0;
+
+                if (!validDerivations[begin + i])
+                {
+                    /* Keep the batch inversion away from a zero Z */
+                    ge_p2_0(&points[i]);
+
+                    continue;
+                }
+
+                ge_scalarmult(&points[i], reinterpret_cast<const unsigned char *>(&privateViewKey), &point);
+                ge_mul8(&point2, &points[i]);
+                ge_p1p1_to_p2(&points[i], &point2);
+            }
+
+            ge_p2_tobytes_batch(reinterpret_cast<unsigned char(*)[32]>(&derivations[begin]), points, count);
+        });
+
+        const size_t batches = (records.size() + SCAN_BATCH_SIZE - 1) / SCAN_BATCH_SIZE;
+
+        std::vector<std::vector<OwnedOutput>> found(batches);
+
+        parallel_for(batches, threads, [&](const size_t batch) {
+            const size_t begin = batch * SCAN_BATCH_SIZE;
+
+            const size_t count = std::min(SCAN_BATCH_SIZE, records.size() - begin);
+
+            /* Every entry up to count is written below, but gcc can not see that through the
+               early continue, so start from zero to keep the build free of warnings */
+            ge_p2 points[SCAN_BATCH_SIZE] = {};
+
+            EllipticCurveScalar scalars[SCAN_BATCH_SIZE];
+
+            PublicKey spendKeys[SCAN_BATCH_SIZE];
+
+            bool valid[SCAN_BATCH_SIZE];
+
+            for (size_t i = 0; i < count; i++)
+            {
+                const auto &record = records[begin + i];
+
+                const size_t txKey = recordTxKeys[begin + i];
+
+                ge_p3 point1;
+                ge_p3 point2;
+                ge_cached point3;
+                ge_p1p1 point4;
+
+                valid[i] = validDerivations[txKey]
+                           && ge_frombytes_vartime(&point1, reinterpret_cast<const unsigned char *>(&record.outputKey))
+                                  == 0;
+
+                if (!valid[i])
+                {
+                    ge_p2_0(&points[i]);
+
+                    continue;
+                }
+
+                /* P - Hs(8aR || i)G, which is our spend key if the output is ours */
+                derivation_to_scalar(derivations[txKey], record.outputIndex, scalars[i]);
+                ge_scalarmult_base(&point2, reinterpret_cast<unsigned char *>(&scalars[i]));
+                ge_p3_to_cached(&point3, &point2);
+                ge_sub(&point4, &point1, &point3);
+                ge_p1p1_to_p2(&points[i], &point4);
+            }
+
+            ge_p2_tobytes_batch(reinterpret_cast<unsigned char(*)[32]>(spendKeys), points, count);
+
+            for (size_t i = 0; i < count; i++)
+            {
+                if (!valid[i])
+                {
+                    continue;
+                }
+
+                const size_t subwalletIndex = publicSpendKeys.find(spendKeys[i]);
+
+                if (subwalletIndex != SubwalletKeyIndex::npos)
+                {
+                    found[batch].push_back({begin + i, subwalletIndex, scalars[i]});
+                }
+            }
+        });
+
+        for (const auto &outputs : found)
+        {
+            ownedOutputs.insert(ownedOutputs.end(), outputs.begin(), outputs.end());
+        }
+
+        return true;
+    }
+
+    bool crypto_ops::scanTransactions(
+        const SecretKey &privateViewKey,
+        const std::vector<PublicKey> &publicSpendKeys,
+        const std::vector<TransactionOutputRecord> &records,
+        std::vector<OwnedOutput> &ownedOutputs,
+        const size_t threads)
+    {
+        return scanTransactions(privateViewKey, SubwalletKeyIndex(publicSpendKeys), records, ownedOutputs, threads);
+    }
+
+    bool crypto_ops::scanTransactions(
+        const SecretKey &privateViewKey,
+        const PublicKey &publicSpendKey,
+        const std::vector<TransactionOutputRecord> &records,
+        std::vector<OwnedOutput> &ownedOutputs,
+        const size_t threads)
+    {
+        return scanTransactions(
+            privateViewKey, SubwalletKeyIndex(std::vector<PublicKey> {publicSpendKey}), records, ownedOutputs, threads);
+    }
+
     void crypto_ops::generateViewFromSpend(const Crypto::SecretKey &spend, Crypto::SecretKey &viewSecret)
     {
         /* If we don't need the pub key */
@@ -732,41 +1550,83 @@ namespace Crypto
         uint64_t subwalletIndex,
         Crypto::SecretKey &subSpend)
     {
-        /* Set the iterations for key stretching to the subwallet index number */
-        const uint64_t iterations = subwalletIndex;
-
-        /* Convert the subwallet index number into a binary arrary for ease of
-           appending to the key as the salt */
-        std::vector<uint8_t> subwalletSalt(8);
-
-        std::memcpy(subwalletSalt.data(), &subwalletIndex, sizeof(subwalletIndex));
+        /* The key is stretched by hashing (key || subwalletIndex) subwalletIndex times. That
+           40 byte input always fits in a single Keccak block, so the padded block is laid out
+           in the state directly rather than going through cn_fast_hash each iteration. */
+        uint64_t key[4];
 
-        /* Set up our temporary key as 32 byte key + 8 byte wallet index */
-        std::vector<uint8_t> tmpKey(40);
+        std::memcpy(key, baseSpend.data, sizeof(key));
 
-        /* Copy our base key into the vector */
-        std::copy(std::begin(baseSpend.data), std::end(baseSpend.data), tmpKey.begin());
+        /* Set the iterations for key stretching to the subwallet index number */
+        const uint64_t iterations = subwalletIndex;
 
-        /* Loop through the iteration count and stretch this key */
         for (uint64_t i = 0; i < iterations; i++)
         {
-            /* Copy our wallet index on to the end of the temporary key vector
-               to salt the input to the hashing method */
-            std::copy(subwalletSalt.begin(), subwalletSalt.end(), tmpKey.begin() + 32);
+            uint64_t state[25] = {key[0], key[1], key[2], key[3], subwalletIndex};
+
+            /* Keccak padding: 0x01 after the input and 0x80 in the last byte of the block */
+            state[5] = 0x01;
 
-            /* Hash the binary array */
-            Hash h;
+            state[HASH_DATA_AREA / 8 - 1] = 0x8000000000000000;
 
-            cn_fast_hash(tmpKey.data(), tmpKey.size(), h);
+            keccakf(state, KECCAK_ROUNDS);
 
-            /* Copy the hash back into the tmpKey vector */
-            std::copy(std::begin(h.data), std::end(h.data), tmpKey.begin());
+            std::memcpy(key, state, sizeof(key));
         }
 
-        std::copy(tmpKey.begin(), tmpKey.begin() + 32, subSpend.data);
+        std::memcpy(subSpend.data, key, sizeof(key));
 
         /* Run the resulting key through scalar reduction to make sure we have a good
            private key that is returned to the caller */
         sc_reduce32(reinterpret_cast<unsigned char *>(&subSpend.data));
     }
+
+    bool crypto_ops::generate_deterministic_subwallet_keys(
+        const SecretKey &basePrivate,
+        const uint64_t firstSubwalletIndex,
+        const size_t count,
+        std::vector<SecretKey> &subwalletPrivates,
+        std::vector<PublicKey> &subwalletPublics,
+        SubwalletKeysCheckpoint *checkpoint,
+        const size_t threads)
+    {
+        subwalletPrivates.resize(count);
+
+        subwalletPublics.resize(count);
+
+        std::atomic<bool> success(true);
+
+        parallel_for(count, threads, [&](const size_t i) {
+            if (!generate_deterministic_subwallet_keys(
+                    basePrivate, firstSubwalletIndex + i, subwalletPrivates[i], subwalletPublics[i]))
+            {
+                success = false;
+            }
+        });
+
+        if (checkpoint != nullptr)
+        {
+            checkpoint->nextSubwalletIndex = firstSubwalletIndex + count;
+        }
+
+        return success;
+    }
+
+    bool crypto_ops::generate_deterministic_subwallet_keys(
+        const SecretKey &basePrivate,
+        SubwalletKeysCheckpoint &checkpoint,
+        const size_t count,
+        std::vector<SecretKey> &subwalletPrivates,
+        std::vector<PublicKey> &subwalletPublics,
+        const size_t threads)
+    {
+        return generate_deterministic_subwallet_keys(
+            basePrivate,
+            checkpoint.nextSubwalletIndex,
+            count,
+            subwalletPrivates,
+            subwalletPublics,
+            &checkpoint,
+            threads);
+    }
 } // namespace Crypto
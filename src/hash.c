@@ -29,7 +29,11 @@ void hash_permutation(union hash_state *state)
 
 void hash_process(union hash_state *state, const uint8_t *buf, size_t count)
 {
-    keccak1600(buf, (int)count, (uint8_t *)state);
+    keccak_ctx ctx;
+
+    keccak_init(&ctx, sizeof(*state));
+    keccak_update(&ctx, buf, count);
+    keccak_final(&ctx, state->b);
 }
 
 void cn_fast_hash(const void *data, size_t length, char *hash)
@@ -38,3 +42,110 @@ void cn_fast_hash(const void *data, size_t length, char *hash)
     hash_process(&state, data, length);
     memcpy(hash, &state, HASH_SIZE);
 }
+
+void cn_fast_hash_iov(const struct hash_iovec *iov, size_t count, char *hash)
+{
+    union hash_state state;
+    keccak_ctx ctx;
+    size_t i;
+
+    keccak_init(&ctx, sizeof(state));
+
+    for (i = 0; i < count; i++)
+    {
+        keccak_update(&ctx, iov[i].data, iov[i].length);
+    }
+
+    keccak_final(&ctx, state.b);
+    memcpy(hash, &state, HASH_SIZE);
+}
+
+void cn_fast_hash_batch(const void *const *data, const size_t *length, size_t count, char (*hashes)[HASH_SIZE])
+{
+    uint64_t st[25][KECCAK_MAX_STATES];
+    uint8_t temp[HASH_DATA_AREA];
+    const size_t ways = keccakf_multi_ways();
+    size_t first, lanes, lane, block, blocks, i;
+
+    /* Without a multi-way permutation on this processor, or with only one message to hash,
+       there is nothing to interleave */
+    if (ways == 1 || count == 1)
+    {
+        for (i = 0; i < count; i++)
+        {
+            cn_fast_hash(data[i], length[i], hashes[i]);
+        }
+
+        return;
+    }
+
+    for (first = 0; first < count; first += lanes)
+    {
+        lanes = count - first < KECCAK_MAX_STATES ? count - first : KECCAK_MAX_STATES;
+
+        /* Every message takes one permutation per full block, plus one for the padded final block */
+        blocks = 0;
+
+        for (lane = 0; lane < lanes; lane++)
+        {
+            const size_t needed = length[first + lane] / HASH_DATA_AREA + 1;
+
+            blocks = needed > blocks ? needed : blocks;
+        }
+
+        memset(st, 0, sizeof(st));
+
+        for (block = 0; block < blocks; block++)
+        {
+            for (lane = 0; lane < lanes; lane++)
+            {
+                const uint8_t *message = data[first + lane];
+                const size_t offset = block * HASH_DATA_AREA;
+                const size_t len = length[first + lane];
+
+                /* A message that is already absorbed is permuted along with the
+                   rest, but its hash was copied out after its final block */
+                if (offset > len)
+                {
+                    continue;
+                }
+
+                if (len - offset >= HASH_DATA_AREA)
+                {
+                    memcpy(temp, message + offset, HASH_DATA_AREA);
+                }
+                else
+                {
+                    memcpy(temp, message + offset, len - offset);
+                    temp[len - offset] = 1;
+                    memset(temp + len - offset + 1, 0, HASH_DATA_AREA - (len - offset) - 1);
+                    temp[HASH_DATA_AREA - 1] |= 0x80;
+                }
+
+                for (i = 0; i < HASH_DATA_AREA / 8; i++)
+                {
+                    uint64_t word;
+
+                    memcpy(&word, temp + i * 8, sizeof(word));
+
+                    st[i][lane] ^= SWAP64LE(word);
+                }
+            }
+
+            keccakf_multi(st, lanes, KECCAK_ROUNDS);
+
+            for (lane = 0; lane < lanes; lane++)
+            {
+                if (length[first + lane] / HASH_DATA_AREA == block)
+                {
+                    for (i = 0; i < HASH_SIZE / 8; i++)
+                    {
+                        const uint64_t word = SWAP64LE(st[i][lane]);
+
+                        memcpy(hashes[first + lane] + i * 8, &word, sizeof(word));
+                    }
+                }
+            }
+        }
+    }
+}
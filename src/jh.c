@@ -427,17 +427,21 @@ static void E8(hashState *state)
 static void F8(hashState *state)
 {
     uint64 i;
+    uint64 m[8];
+
+    /*load the message block through memcpy, reading it through a uint64 pointer violates strict aliasing*/
+    memcpy(m, state->buffer, sizeof(m));
 
     /*xor the 512-bit message with the fist half of the 1024-bit hash state*/
     for (i = 0; i < 8; i++)
-        state->x[i >> 1][i & 1] ^= ((uint64 *)state->buffer)[i];
+        state->x[i >> 1][i & 1] ^= m[i];
 
     /*the bijective function E8 */
     E8(state);
 
     /*xor the 512-bit message with the second half of the 1024-bit hash state*/
     for (i = 0; i < 8; i++)
-        state->x[(8 + i) >> 1][(8 + i) & 1] ^= ((uint64 *)state->buffer)[i];
+        state->x[(8 + i) >> 1][(8 + i) & 1] ^= m[i];
 }
 
 /*before hashing a message, initialize the hash state as H0 */
@@ -6,6 +6,10 @@
 
 #include "hash-ops.h"
 
+#if defined(KECCAK_SIMD)
+#include <immintrin.h>
+#endif
+
 const uint64_t keccakf_rndc[24] = {0x0000000000000001, 0x0000000000008082, 0x800000000000808a, 0x8000000080008000,
                                    0x000000000000808b, 0x0000000080000001, 0x8000000080008081, 0x8000000000008009,
                                    0x000000000000008a, 0x0000000000000088, 0x0000000080008009, 0x000000008000000a,
@@ -13,100 +17,224 @@ const uint64_t keccakf_rndc[24] = {0x0000000000000001, 0x0000000000008082, 0x800
                                    0x8000000000008002, 0x8000000000000080, 0x000000000000800a, 0x800000008000000a,
                                    0x8000000080008081, 0x8000000000008080, 0x0000000080000001, 0x8000000080008008};
 
-const int keccakf_rotc[24] = {1,  3,  6,  10, 15, 21, 28, 36, 45, 55, 2,  14,
-                              27, 41, 56, 8,  25, 43, 62, 18, 39, 61, 20, 44};
-
-const int keccakf_piln[24] = {10, 7, 11, 17, 18, 3, 5, 16, 8, 21, 24, 4, 15, 23, 19, 13, 12, 2, 20, 14, 22, 9, 6, 1};
+#define KECCAKF_NAME keccakf_1
+#define KECCAKF_T uint64_t
+#define KECCAKF_XOR(a, b) ((a) ^ (b))
+#define KECCAKF_ANDN(a, b) (~(a) & (b))
+#define KECCAKF_ROL(a, n) ROTL64(a, n)
+#define KECCAKF_LOAD(st, i) ((st)[i])
+#define KECCAKF_STORE(st, i, a) ((st)[i] = (a))
+#define KECCAKF_RC(i) keccakf_rndc[i]
+#define KECCAKF_TARGET
+#include "keccakf-template.h"
+#undef KECCAKF_NAME
+#undef KECCAKF_T
+#undef KECCAKF_XOR
+#undef KECCAKF_ANDN
+#undef KECCAKF_ROL
+#undef KECCAKF_LOAD
+#undef KECCAKF_STORE
+#undef KECCAKF_RC
+#undef KECCAKF_TARGET
 
 // update the state with given number of rounds
 
 void keccakf(uint64_t st[25], int rounds)
 {
-    int i, j, round;
-    uint64_t t, bc[5];
+    keccakf_1(st, rounds);
+}
 
-    for (round = 0; round < rounds; round++)
+#if defined(KECCAK_SIMD)
+
+/* Each word of the interleaved states is loaded for four (AVX2) or all eight (AVX-512) states at once, only
+   these functions are compiled for the wider instruction sets so that keccakf_multi can fall back to keccakf_1 */
+
+#define KECCAKF_NAME keccakf_avx2
+#define KECCAKF_T __m256i
+#define KECCAKF_XOR(a, b) _mm256_xor_si256(a, b)
+#define KECCAKF_ANDN(a, b) _mm256_andnot_si256(a, b)
+#define KECCAKF_ROL(a, n) _mm256_or_si256(_mm256_slli_epi64(a, n), _mm256_srli_epi64(a, 64 - (n)))
+#define KECCAKF_LOAD(st, i) _mm256_loadu_si256((const __m256i *)((st) + (i) * KECCAK_MAX_STATES))
+#define KECCAKF_STORE(st, i, a) _mm256_storeu_si256((__m256i *)((st) + (i) * KECCAK_MAX_STATES), a)
+#define KECCAKF_RC(i) _mm256_set1_epi64x((long long)keccakf_rndc[i])
+#define KECCAKF_TARGET __attribute__((target("avx2")))
+#include "keccakf-template.h"
+#undef KECCAKF_NAME
+#undef KECCAKF_T
+#undef KECCAKF_XOR
+#undef KECCAKF_ANDN
+#undef KECCAKF_ROL
+#undef KECCAKF_LOAD
+#undef KECCAKF_STORE
+#undef KECCAKF_RC
+#undef KECCAKF_TARGET
+
+#define KECCAKF_NAME keccakf_avx512
+#define KECCAKF_T __m512i
+#define KECCAKF_XOR(a, b) _mm512_xor_si512(a, b)
+#define KECCAKF_ANDN(a, b) _mm512_andnot_si512(a, b)
+#define KECCAKF_ROL(a, n) _mm512_rol_epi64(a, n)
+#define KECCAKF_LOAD(st, i) _mm512_loadu_si512((const void *)((st) + (i) * KECCAK_MAX_STATES))
+#define KECCAKF_STORE(st, i, a) _mm512_storeu_si512((void *)((st) + (i) * KECCAK_MAX_STATES), a)
+#define KECCAKF_RC(i) _mm512_set1_epi64((long long)keccakf_rndc[i])
+#define KECCAKF_TARGET __attribute__((target("avx512f")))
+#include "keccakf-template.h"
+#undef KECCAKF_NAME
+#undef KECCAKF_T
+#undef KECCAKF_XOR
+#undef KECCAKF_ANDN
+#undef KECCAKF_ROL
+#undef KECCAKF_LOAD
+#undef KECCAKF_STORE
+#undef KECCAKF_RC
+#undef KECCAKF_TARGET
+
+#endif
+
+size_t keccakf_multi_ways(void)
+{
+#if defined(KECCAK_SIMD)
+    if (__builtin_cpu_supports("avx512f"))
     {
-        // Theta
-        for (i = 0; i < 5; i++)
-            bc[i] = st[i] ^ st[i + 5] ^ st[i + 10] ^ st[i + 15] ^ st[i + 20];
+        return 8;
+    }
 
-        for (i = 0; i < 5; i++)
-        {
-            t = bc[(i + 4) % 5] ^ ROTL64(bc[(i + 1) % 5], 1);
-            for (j = 0; j < 25; j += 5)
-                st[j + i] ^= t;
-        }
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return 4;
+    }
+#endif
 
-        // Rho Pi
-        t = st[1];
-        for (i = 0; i < 24; i++)
-        {
-            j = keccakf_piln[i];
-            bc[0] = st[j];
-            st[j] = ROTL64(t, keccakf_rotc[i]);
-            t = bc[0];
-        }
+    return 1;
+}
+
+// update the first count of the interleaved states with given number of rounds
 
-        //  Chi
-        for (j = 0; j < 25; j += 5)
+void keccakf_multi(uint64_t st[25][KECCAK_MAX_STATES], size_t count, int rounds)
+{
+    uint64_t single[25];
+    size_t i, j;
+
+#if defined(KECCAK_SIMD)
+    const size_t ways = keccakf_multi_ways();
+
+    if (ways == 8)
+    {
+        keccakf_avx512(&st[0][0], rounds);
+        return;
+    }
+
+    if (ways == 4)
+    {
+        keccakf_avx2(&st[0][0], rounds);
+
+        if (count > 4)
         {
-            for (i = 0; i < 5; i++)
-                bc[i] = st[j + i];
-            for (i = 0; i < 5; i++)
-                st[j + i] ^= (~bc[(i + 1) % 5]) & bc[(i + 2) % 5];
+            keccakf_avx2(&st[0][4], rounds);
         }
 
-        //  Iota
-        st[0] ^= keccakf_rndc[round];
+        return;
+    }
+#endif
+
+    for (j = 0; j < count; j++)
+    {
+        for (i = 0; i < 25; i++)
+            single[i] = st[i][j];
+
+        keccakf_1(single, rounds);
+
+        for (i = 0; i < 25; i++)
+            st[i][j] = single[i];
     }
 }
 
 // compute a keccak hash (md) of given byte length from "in"
 typedef uint64_t state_t[25];
 
-int keccak(const uint8_t *in, int inlen, uint8_t *md, int mdlen)
+int keccak(const uint8_t *in, size_t inlen, uint8_t *md, int mdlen)
+{
+    keccak_ctx ctx;
+
+    keccak_init(&ctx, mdlen);
+    keccak_update(&ctx, in, inlen);
+    keccak_final(&ctx, md);
+
+    return 0;
+}
+
+// xor one block of input into the state and permute it
+
+static void keccak_absorb(uint64_t st[25], const uint8_t *in, int rsizw)
 {
-    state_t st;
-    uint8_t temp[144];
-    int i, rsiz, rsizw;
+    uint64_t word;
+    int i;
+
+    for (i = 0; i < rsizw; i++)
+    {
+        memcpy(&word, in + i * 8, sizeof(word));
+        st[i] ^= word;
+    }
 
+    keccakf(st, KECCAK_ROUNDS);
+}
 
+void keccak_init(keccak_ctx *ctx, int mdlen)
+{
     /* for some reason the enum from hash-ops.h is not valid here when
        compiling - is this a C vs C++ thing? Anyhow, lets just redefine it for
        now. */
 
     const int HASH_DATA_AREA = 136;
 
-    rsiz = sizeof(state_t) == mdlen ? HASH_DATA_AREA : 200 - 2 * mdlen;
-    rsizw = rsiz / 8;
+    memset(ctx->st, 0, sizeof(ctx->st));
+    ctx->pos = 0;
+    ctx->rsiz = sizeof(state_t) == mdlen ? HASH_DATA_AREA : 200 - 2 * mdlen;
+    ctx->mdlen = mdlen;
+}
 
-    memset(st, 0, sizeof(st));
+void keccak_update(keccak_ctx *ctx, const uint8_t *in, size_t inlen)
+{
+    const size_t rsiz = (size_t)ctx->rsiz;
 
-    for (; inlen >= rsiz; inlen -= rsiz, in += rsiz)
+    // top up a partial block left by an earlier update first
+    if (ctx->pos > 0)
     {
-        for (i = 0; i < rsizw; i++)
-            st[i] ^= ((uint64_t *)in)[i];
-        keccakf(st, KECCAK_ROUNDS);
+        const size_t take = inlen < rsiz - ctx->pos ? inlen : rsiz - ctx->pos;
+
+        memcpy(ctx->buf + ctx->pos, in, take);
+        ctx->pos += take;
+        in += take;
+        inlen -= take;
+
+        if (ctx->pos < rsiz)
+            return;
+
+        keccak_absorb(ctx->st, ctx->buf, ctx->rsiz / 8);
+        ctx->pos = 0;
     }
 
-    // last block and padding
-    memcpy(temp, in, inlen);
-    temp[inlen++] = 1;
-    memset(temp + inlen, 0, rsiz - inlen);
-    temp[rsiz - 1] |= 0x80;
+    // whole blocks are absorbed straight from the input
+    for (; inlen >= rsiz; inlen -= rsiz, in += rsiz)
+        keccak_absorb(ctx->st, in, ctx->rsiz / 8);
 
-    for (i = 0; i < rsizw; i++)
-        st[i] ^= ((uint64_t *)temp)[i];
+    memcpy(ctx->buf, in, inlen);
+    ctx->pos = inlen;
+}
 
-    keccakf(st, KECCAK_ROUNDS);
+void keccak_final(keccak_ctx *ctx, uint8_t *md)
+{
+    // last block and padding
+    ctx->buf[ctx->pos++] = 1;
+    memset(ctx->buf + ctx->pos, 0, ctx->rsiz - ctx->pos);
+    ctx->buf[ctx->rsiz - 1] |= 0x80;
 
-    memcpy(md, st, mdlen);
+    keccak_absorb(ctx->st, ctx->buf, ctx->rsiz / 8);
 
-    return 0;
+    memcpy(md, ctx->st, ctx->mdlen);
 }
 
-void keccak1600(const uint8_t *in, int inlen, uint8_t *md)
+void keccak1600(const uint8_t *in, size_t inlen, uint8_t *md)
 {
     keccak(in, inlen, md, sizeof(state_t));
 }
@@ -0,0 +1,161 @@
+// Copyright (c) 2020, The TurtleCoin Developers
+//
+// Please see the included LICENSE file for more information.
+
+/*
+The body of a fully unrolled Keccak-f[1600] permutation. It is included once for
+each lane type by defining:
+
+    KECCAKF_NAME             the name of the function to emit
+    KECCAKF_T                the type of one lane of the state (or one lane of N states)
+    KECCAKF_XOR(a, b)        a ^ b
+    KECCAKF_ANDN(a, b)       ~a & b
+    KECCAKF_ROL(a, n)        a rotated left by n (0 < n < 64)
+    KECCAKF_LOAD(st, i)      loads word i of the state(s) at st
+    KECCAKF_STORE(st, i, a)  stores a as word i of the state(s) at st
+    KECCAKF_RC(i)            the round constant i broadcast to a lane
+    KECCAKF_TARGET           any attributes (such as the target instruction set) of the function
+
+The state is kept in locals for all of the rounds, and theta, rho and pi are
+fused so that each round touches every lane exactly once before chi.
+*/
+
+static inline KECCAKF_TARGET void KECCAKF_NAME(uint64_t *st, int rounds)
+{
+    KECCAKF_T a00, a01, a02, a03, a04;
+    KECCAKF_T a05, a06, a07, a08, a09;
+    KECCAKF_T a10, a11, a12, a13, a14;
+    KECCAKF_T a15, a16, a17, a18, a19;
+    KECCAKF_T a20, a21, a22, a23, a24;
+    KECCAKF_T b00, b01, b02, b03, b04;
+    KECCAKF_T b05, b06, b07, b08, b09;
+    KECCAKF_T b10, b11, b12, b13, b14;
+    KECCAKF_T b15, b16, b17, b18, b19;
+    KECCAKF_T b20, b21, b22, b23, b24;
+    KECCAKF_T c0, c1, c2, c3, c4, d0, d1, d2, d3, d4;
+    int round;
+
+    a00 = KECCAKF_LOAD(st, 0);
+    a01 = KECCAKF_LOAD(st, 1);
+    a02 = KECCAKF_LOAD(st, 2);
+    a03 = KECCAKF_LOAD(st, 3);
+    a04 = KECCAKF_LOAD(st, 4);
+    a05 = KECCAKF_LOAD(st, 5);
+    a06 = KECCAKF_LOAD(st, 6);
+    a07 = KECCAKF_LOAD(st, 7);
+    a08 = KECCAKF_LOAD(st, 8);
+    a09 = KECCAKF_LOAD(st, 9);
+    a10 = KECCAKF_LOAD(st, 10);
+    a11 = KECCAKF_LOAD(st, 11);
+    a12 = KECCAKF_LOAD(st, 12);
+    a13 = KECCAKF_LOAD(st, 13);
+    a14 = KECCAKF_LOAD(st, 14);
+    a15 = KECCAKF_LOAD(st, 15);
+    a16 = KECCAKF_LOAD(st, 16);
+    a17 = KECCAKF_LOAD(st, 17);
+    a18 = KECCAKF_LOAD(st, 18);
+    a19 = KECCAKF_LOAD(st, 19);
+    a20 = KECCAKF_LOAD(st, 20);
+    a21 = KECCAKF_LOAD(st, 21);
+    a22 = KECCAKF_LOAD(st, 22);
+    a23 = KECCAKF_LOAD(st, 23);
+    a24 = KECCAKF_LOAD(st, 24);
+
+    for (round = 0; round < rounds; round++)
+    {
+        /* Theta */
+        c0 = KECCAKF_XOR(KECCAKF_XOR(KECCAKF_XOR(a00, a05), KECCAKF_XOR(a10, a15)), a20);
+        c1 = KECCAKF_XOR(KECCAKF_XOR(KECCAKF_XOR(a01, a06), KECCAKF_XOR(a11, a16)), a21);
+        c2 = KECCAKF_XOR(KECCAKF_XOR(KECCAKF_XOR(a02, a07), KECCAKF_XOR(a12, a17)), a22);
+        c3 = KECCAKF_XOR(KECCAKF_XOR(KECCAKF_XOR(a03, a08), KECCAKF_XOR(a13, a18)), a23);
+        c4 = KECCAKF_XOR(KECCAKF_XOR(KECCAKF_XOR(a04, a09), KECCAKF_XOR(a14, a19)), a24);
+        d0 = KECCAKF_XOR(c4, KECCAKF_ROL(c1, 1));
+        d1 = KECCAKF_XOR(c0, KECCAKF_ROL(c2, 1));
+        d2 = KECCAKF_XOR(c1, KECCAKF_ROL(c3, 1));
+        d3 = KECCAKF_XOR(c2, KECCAKF_ROL(c4, 1));
+        d4 = KECCAKF_XOR(c3, KECCAKF_ROL(c0, 1));
+
+        /* Rho and Pi */
+        b00 = KECCAKF_XOR(a00, d0);
+        b10 = KECCAKF_ROL(KECCAKF_XOR(a01, d1), 1);
+        b20 = KECCAKF_ROL(KECCAKF_XOR(a02, d2), 62);
+        b05 = KECCAKF_ROL(KECCAKF_XOR(a03, d3), 28);
+        b15 = KECCAKF_ROL(KECCAKF_XOR(a04, d4), 27);
+        b16 = KECCAKF_ROL(KECCAKF_XOR(a05, d0), 36);
+        b01 = KECCAKF_ROL(KECCAKF_XOR(a06, d1), 44);
+        b11 = KECCAKF_ROL(KECCAKF_XOR(a07, d2), 6);
+        b21 = KECCAKF_ROL(KECCAKF_XOR(a08, d3), 55);
+        b06 = KECCAKF_ROL(KECCAKF_XOR(a09, d4), 20);
+        b07 = KECCAKF_ROL(KECCAKF_XOR(a10, d0), 3);
+        b17 = KECCAKF_ROL(KECCAKF_XOR(a11, d1), 10);
+        b02 = KECCAKF_ROL(KECCAKF_XOR(a12, d2), 43);
+        b12 = KECCAKF_ROL(KECCAKF_XOR(a13, d3), 25);
+        b22 = KECCAKF_ROL(KECCAKF_XOR(a14, d4), 39);
+        b23 = KECCAKF_ROL(KECCAKF_XOR(a15, d0), 41);
+        b08 = KECCAKF_ROL(KECCAKF_XOR(a16, d1), 45);
+        b18 = KECCAKF_ROL(KECCAKF_XOR(a17, d2), 15);
+        b03 = KECCAKF_ROL(KECCAKF_XOR(a18, d3), 21);
+        b13 = KECCAKF_ROL(KECCAKF_XOR(a19, d4), 8);
+        b14 = KECCAKF_ROL(KECCAKF_XOR(a20, d0), 18);
+        b24 = KECCAKF_ROL(KECCAKF_XOR(a21, d1), 2);
+        b09 = KECCAKF_ROL(KECCAKF_XOR(a22, d2), 61);
+        b19 = KECCAKF_ROL(KECCAKF_XOR(a23, d3), 56);
+        b04 = KECCAKF_ROL(KECCAKF_XOR(a24, d4), 14);
+
+        /* Chi */
+        a00 = KECCAKF_XOR(b00, KECCAKF_ANDN(b01, b02));
+        a01 = KECCAKF_XOR(b01, KECCAKF_ANDN(b02, b03));
+        a02 = KECCAKF_XOR(b02, KECCAKF_ANDN(b03, b04));
+        a03 = KECCAKF_XOR(b03, KECCAKF_ANDN(b04, b00));
+        a04 = KECCAKF_XOR(b04, KECCAKF_ANDN(b00, b01));
+        a05 = KECCAKF_XOR(b05, KECCAKF_ANDN(b06, b07));
+        a06 = KECCAKF_XOR(b06, KECCAKF_ANDN(b07, b08));
+        a07 = KECCAKF_XOR(b07, KECCAKF_ANDN(b08, b09));
+        a08 = KECCAKF_XOR(b08, KECCAKF_ANDN(b09, b05));
+        a09 = KECCAKF_XOR(b09, KECCAKF_ANDN(b05, b06));
+        a10 = KECCAKF_XOR(b10, KECCAKF_ANDN(b11, b12));
+        a11 = KECCAKF_XOR(b11, KECCAKF_ANDN(b12, b13));
+        a12 = KECCAKF_XOR(b12, KECCAKF_ANDN(b13, b14));
+        a13 = KECCAKF_XOR(b13, KECCAKF_ANDN(b14, b10));
+        a14 = KECCAKF_XOR(b14, KECCAKF_ANDN(b10, b11));
+        a15 = KECCAKF_XOR(b15, KECCAKF_ANDN(b16, b17));
+        a16 = KECCAKF_XOR(b16, KECCAKF_ANDN(b17, b18));
+        a17 = KECCAKF_XOR(b17, KECCAKF_ANDN(b18, b19));
+        a18 = KECCAKF_XOR(b18, KECCAKF_ANDN(b19, b15));
+        a19 = KECCAKF_XOR(b19, KECCAKF_ANDN(b15, b16));
+        a20 = KECCAKF_XOR(b20, KECCAKF_ANDN(b21, b22));
+        a21 = KECCAKF_XOR(b21, KECCAKF_ANDN(b22, b23));
+        a22 = KECCAKF_XOR(b22, KECCAKF_ANDN(b23, b24));
+        a23 = KECCAKF_XOR(b23, KECCAKF_ANDN(b24, b20));
+        a24 = KECCAKF_XOR(b24, KECCAKF_ANDN(b20, b21));
+
+        /* Iota */
+        a00 = KECCAKF_XOR(a00, KECCAKF_RC(round));
+    }
+
+    KECCAKF_STORE(st, 0, a00);
+    KECCAKF_STORE(st, 1, a01);
+    KECCAKF_STORE(st, 2, a02);
+    KECCAKF_STORE(st, 3, a03);
+    KECCAKF_STORE(st, 4, a04);
+    KECCAKF_STORE(st, 5, a05);
+    KECCAKF_STORE(st, 6, a06);
+    KECCAKF_STORE(st, 7, a07);
+    KECCAKF_STORE(st, 8, a08);
+    KECCAKF_STORE(st, 9, a09);
+    KECCAKF_STORE(st, 10, a10);
+    KECCAKF_STORE(st, 11, a11);
+    KECCAKF_STORE(st, 12, a12);
+    KECCAKF_STORE(st, 13, a13);
+    KECCAKF_STORE(st, 14, a14);
+    KECCAKF_STORE(st, 15, a15);
+    KECCAKF_STORE(st, 16, a16);
+    KECCAKF_STORE(st, 17, a17);
+    KECCAKF_STORE(st, 18, a18);
+    KECCAKF_STORE(st, 19, a19);
+    KECCAKF_STORE(st, 20, a20);
+    KECCAKF_STORE(st, 21, a21);
+    KECCAKF_STORE(st, 22, a22);
+    KECCAKF_STORE(st, 23, a23);
+    KECCAKF_STORE(st, 24, a24);
+}
@@ -1,22 +1,198 @@
-// Copyright (c) 2019, The TurtleCoin Developers
+// Copyright (c) 2019-2020, The TurtleCoin Developers
+//
+// Please see the included LICENSE file for more information.
 
 #include "random.h"
 
+#include "chacha20.h"
+
+#include <algorithm>
+#include <cstring>
 #include <random>
 
-/* Used to obtain a random seed */
-static std::random_device random_device;
+namespace
+{
+    /* How many blocks of keystream are generated at a time */
+    const size_t BUFFER_BLOCKS = 16;
 
-/* Generator, seeded with the random device */
-static std::mt19937 gen(random_device());
+    /* How many bytes of output are produced before OS entropy is mixed into the key */
+    const uint64_t RESEED_INTERVAL = 1 << 20;
 
-/* The distribution to get numbers for - in this case, uint8_t */
-static std::uniform_int_distribution<int> distribution {0, std::numeric_limits<uint8_t>::max()};
+    inline uint32_t rotl32(const uint32_t value, const int count)
+    {
+        return (value << count) | (value >> (32 - count));
+    }
 
-void generate_random_bytes(size_t n, uint8_t *result)
+    inline void quarter_round(uint32_t &a, uint32_t &b, uint32_t &c, uint32_t &d)
+    {
+        a += b;
+        d = rotl32(d ^ a, 16);
+        c += d;
+        b = rotl32(b ^ c, 12);
+        a += b;
+        d = rotl32(d ^ a, 8);
+        c += d;
+        b = rotl32(b ^ c, 7);
+    }
+
+    /* The per thread generator behind Random::randomBytes. Each refill encrypts a buffer
+       worth of blocks under the current key, then takes the first 32 bytes of it as the
+       next key ("fast key erasure"). Handed out bytes are wiped from the buffer. */
+    class ChaCha20Generator
+    {
+      public:
+        ChaCha20Generator(): m_position(sizeof(m_buffer)), m_sinceReseed(0)
+        {
+            std::fill(m_key, m_key + Random::CHACHA20_KEY_WORDS, 0);
+
+            reseed();
+        }
+
+        ~ChaCha20Generator()
+        {
+            wipe(m_key, sizeof(m_key));
+
+            wipe(m_buffer, sizeof(m_buffer));
+        }
+
+        void read(uint8_t *result, size_t n)
+        {
+            while (n > 0)
+            {
+                if (m_position == sizeof(m_buffer))
+                {
+                    refill();
+                }
+
+                const size_t chunk = std::min(n, sizeof(m_buffer) - m_position);
+
+                std::memcpy(result, m_buffer + m_position, chunk);
+
+                wipe(m_buffer + m_position, chunk);
+
+                m_position += chunk;
+
+                result += chunk;
+
+                n -= chunk;
+            }
+        }
+
+      private:
+        static void wipe(void *data, const size_t length)
+        {
+            volatile uint8_t *bytes = static_cast<volatile uint8_t *>(data);
+
+            for (size_t i = 0; i < length; i++)
+            {
+                bytes[i] = 0;
+            }
+        }
+
+        void reseed()
+        {
+            std::random_device device;
+
+            for (auto &word : m_key)
+            {
+                word ^= static_cast<uint32_t>(device());
+            }
+
+            m_sinceReseed = 0;
+        }
+
+        void refill()
+        {
+            if (m_sinceReseed >= RESEED_INTERVAL)
+            {
+                reseed();
+            }
+
+            for (size_t i = 0; i < BUFFER_BLOCKS; i++)
+            {
+                Random::chacha20_block(m_key, i, 0, m_buffer + i * Random::CHACHA20_BLOCK_SIZE);
+            }
+
+            std::memcpy(m_key, m_buffer, sizeof(m_key));
+
+            wipe(m_buffer, sizeof(m_key));
+
+            m_position = sizeof(m_key);
+
+            m_sinceReseed += sizeof(m_buffer) - sizeof(m_key);
+        }
+
+        uint32_t m_key[Random::CHACHA20_KEY_WORDS];
+
+        uint8_t m_buffer[BUFFER_BLOCKS * Random::CHACHA20_BLOCK_SIZE];
+
+        size_t m_position;
+
+        uint64_t m_sinceReseed;
+    };
+} // namespace
+
+namespace Random
 {
-    for (size_t i = 0; i < n; i++)
+    void chacha20_block(
+        const uint32_t key[CHACHA20_KEY_WORDS],
+        const uint64_t counter,
+        const uint64_t nonce,
+        uint8_t *out)
     {
-        result[i] = distribution(gen);
+        const uint32_t input[16] = {0x61707865,
+                                    0x3320646e,
+                                    0x79622d32,
+                                    0x6b206574,
+                                    key[0],
+                                    key[1],
+                                    key[2],
+                                    key[3],
+                                    key[4],
+                                    key[5],
+                                    key[6],
+                                    key[7],
+                                    static_cast<uint32_t>(counter),
+                                    static_cast<uint32_t>(counter >> 32),
+                                    static_cast<uint32_t>(nonce),
+                                    static_cast<uint32_t>(nonce >> 32)};
+
+        uint32_t x[16];
+
+        std::copy(input, input + 16, x);
+
+        for (int i = 0; i < 10; i++)
+        {
+            quarter_round(x[0], x[4], x[8], x[12]);
+            quarter_round(x[1], x[5], x[9], x[13]);
+            quarter_round(x[2], x[6], x[10], x[14]);
+            quarter_round(x[3], x[7], x[11], x[15]);
+            quarter_round(x[0], x[5], x[10], x[15]);
+            quarter_round(x[1], x[6], x[11], x[12]);
+            quarter_round(x[2], x[7], x[8], x[13]);
+            quarter_round(x[3], x[4], x[9], x[14]);
+        }
+
+        for (size_t i = 0; i < 16; i++)
+        {
+            const uint32_t word = x[i] + input[i];
+
+            out[4 * i] = static_cast<uint8_t>(word);
+            out[4 * i + 1] = static_cast<uint8_t>(word >> 8);
+            out[4 * i + 2] = static_cast<uint8_t>(word >> 16);
+            out[4 * i + 3] = static_cast<uint8_t>(word >> 24);
+        }
     }
+
+    void randomBytes(size_t n, uint8_t *result)
+    {
+        static thread_local ChaCha20Generator generator;
+
+        generator.read(result, n);
+    }
+} // namespace Random
+
+void generate_random_bytes(size_t n, uint8_t *result)
+{
+    Random::randomBytes(n, result);
 }
@@ -12,18 +12,6 @@
 
 #include "slow-hash-common.h"
 
-void slow_hash_allocate_state(void)
-{
-    // Do nothing, this is just to maintain compatibility with the upgraded slow-hash.c
-    return;
-}
-
-void slow_hash_free_state(void)
-{
-    // As above
-    return;
-}
-
 #if defined(__GNUC__)
 #define RDATA_ALIGN16 __attribute__((aligned(16)))
 #define STATIC static
@@ -225,32 +213,6 @@ STATIC INLINE void
     }
 }
 
-#ifdef FORCE_USE_HEAP
-STATIC INLINE void *aligned_malloc(size_t size, size_t align)
-{
-    void *result;
-#ifdef _MSC_VER
-    result = _aligned_malloc(size, align);
-#else /* _MSC_VER */
-    if (posix_memalign(&result, align, size))
-    {
-        result = NULL;
-    }
-#endif /* _MSC_VER */
-
-    return result;
-}
-
-STATIC INLINE void aligned_free(void *ptr)
-{
-#ifdef _MSC_VER
-    _aligned_free(ptr);
-#else /*_MSC_VER */
-    free(ptr);
-#endif /* _MSC_VER */
-}
-#endif /* FORCE_USE_HEAP */
-
 void cn_slow_hash(
     const void *data,
     size_t length,
@@ -273,7 +235,8 @@ void cn_slow_hash(
     RDATA_ALIGN16 uint8_t hp_state[page_size];
 #else /* FORCE_USE_HEAP */
 #pragma message("warning: ACTIVATING FORCE_USE_HEAP IN aarch64 + crypto in slow-hash-arm.c")
-    uint8_t *hp_state = (uint8_t *)aligned_malloc(page_size, 16);
+    /* The scratchpad is owned by the calling thread and survives between calls */
+    uint8_t *hp_state = slow_hash_allocate_state(page_size);
 #endif /* FORCE_USE_HEAP */
 
     uint8_t text[INIT_SIZE_BYTE];
@@ -362,10 +325,6 @@ void cn_slow_hash(
     memcpy(state.init, text, INIT_SIZE_BYTE);
     hash_permutation(&state.hs);
     extra_hashes[state.hs.b[0] & 3](&state, 200, hash);
-
-#ifdef FORCE_USE_HEAP
-    aligned_free(hp_state);
-#endif /*FORCE_USE_HEAP */
 }
 
 #else /* defined(__aarch64__) && defined(__ARM_FEATURE_CRYPTO) */
@@ -531,7 +490,8 @@ void cn_slow_hash(
     uint8_t long_state[page_size];
 #else /* FORCE_USE_HEAP */
 #pragma message("warning: ACTIVATING FORCE_USE_HEAP IN aarch64 && !crypto in slow-hash.c")
-    uint8_t *long_state = (uint8_t *)malloc(page_size);
+    /* The scratchpad is owned by the calling thread and survives between calls */
+    uint8_t *long_state = slow_hash_allocate_state(page_size);
 #endif /* FORCE_USE_HEAP */
 
     if (prehashed)
@@ -621,12 +581,34 @@ void cn_slow_hash(
     memcpy(state.init, text, INIT_SIZE_BYTE);
     hash_permutation(&state.hs);
     extra_hashes[state.hs.b[0] & 3](&state, 200, hash);
-
-#ifdef FORCE_USE_HEAP
-    free(long_state);
-#endif /* FORCE_USE_HEAP */
 }
 
 #endif /* defined(__aarch64__) && defined(__ARM_FEATURE_CRYPTO) */
 
+/**
+ * @brief computes the CryptoNight hash of many inputs that share the same parameters
+ *
+ * This platform has no interleaved kernel, so the inputs are simply hashed one
+ * at a time. The results are identical to calling cn_slow_hash on each input.
+ */
+void cn_slow_hash_batch(
+    const void *const *data,
+    const size_t *length,
+    size_t count,
+    char (*hashes)[HASH_SIZE],
+    int light,
+    int variant,
+    int prehashed,
+    uint64_t page_size,
+    uint64_t scratchpad,
+    uint64_t iterations)
+{
+    size_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        cn_slow_hash(data[i], length[i], hashes[i], light, variant, prehashed, page_size, scratchpad, iterations);
+    }
+}
+
 #endif
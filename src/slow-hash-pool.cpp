@@ -0,0 +1,334 @@
+// Copyright (c) 2018-2020, The TurtleCoin Developers
+//
+// Please see the included LICENSE file for more information.
+
+#include "slow-hash-pool.h"
+
+#include <atomic>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace Crypto
+{
+    struct SlowHashPool::Batch
+    {
+        std::vector<SlowHashJob> jobs;
+
+        std::vector<Hash> results;
+
+        /* How many jobs have yet to be hashed */
+        std::atomic<size_t> remaining;
+
+        std::function<void(std::vector<Hash>)> done;
+    };
+
+    /* Fills in the cn_slow_hash parameters of a CryptoNight algorithm, returns
+       false if the algorithm is not a CryptoNight variant */
+    static bool cn_parameters(
+        const SlowHashAlgorithm algorithm,
+        const uint64_t height,
+        int &light,
+        int &variant,
+        uint64_t &pageSize,
+        uint64_t &scratchpad,
+        uint64_t &iterations)
+    {
+        switch (algorithm)
+        {
+            case SlowHashAlgorithm::CN_V0:
+            case SlowHashAlgorithm::CN_V1:
+            case SlowHashAlgorithm::CN_V2:
+                light = 0;
+                variant = static_cast<int>(algorithm) - static_cast<int>(SlowHashAlgorithm::CN_V0);
+                pageSize = CN_PAGE_SIZE;
+                scratchpad = CN_SCRATCHPAD;
+                iterations = CN_ITERATIONS;
+                return true;
+            case SlowHashAlgorithm::CN_LITE_V0:
+            case SlowHashAlgorithm::CN_LITE_V1:
+            case SlowHashAlgorithm::CN_LITE_V2:
+                light = 1;
+                variant = static_cast<int>(algorithm) - static_cast<int>(SlowHashAlgorithm::CN_LITE_V0);
+                pageSize = CN_LITE_PAGE_SIZE;
+                scratchpad = CN_LITE_SCRATCHPAD;
+                iterations = CN_LITE_ITERATIONS;
+                return true;
+            case SlowHashAlgorithm::CN_DARK_V0:
+            case SlowHashAlgorithm::CN_DARK_V1:
+            case SlowHashAlgorithm::CN_DARK_V2:
+                light = 0;
+                variant = static_cast<int>(algorithm) - static_cast<int>(SlowHashAlgorithm::CN_DARK_V0);
+                pageSize = CN_DARK_PAGE_SIZE;
+                scratchpad = CN_DARK_SCRATCHPAD;
+                iterations = CN_DARK_ITERATIONS;
+                return true;
+            case SlowHashAlgorithm::CN_DARK_LITE_V0:
+            case SlowHashAlgorithm::CN_DARK_LITE_V1:
+            case SlowHashAlgorithm::CN_DARK_LITE_V2:
+                light = 1;
+                variant = static_cast<int>(algorithm) - static_cast<int>(SlowHashAlgorithm::CN_DARK_LITE_V0);
+                pageSize = CN_DARK_PAGE_SIZE;
+                scratchpad = CN_DARK_SCRATCHPAD;
+                iterations = CN_DARK_ITERATIONS;
+                return true;
+            case SlowHashAlgorithm::CN_TURTLE_V0:
+            case SlowHashAlgorithm::CN_TURTLE_V1:
+            case SlowHashAlgorithm::CN_TURTLE_V2:
+                light = 0;
+                variant = static_cast<int>(algorithm) - static_cast<int>(SlowHashAlgorithm::CN_TURTLE_V0);
+                pageSize = CN_TURTLE_PAGE_SIZE;
+                scratchpad = CN_TURTLE_SCRATCHPAD;
+                iterations = CN_TURTLE_ITERATIONS;
+                return true;
+            case SlowHashAlgorithm::CN_TURTLE_LITE_V0:
+            case SlowHashAlgorithm::CN_TURTLE_LITE_V1:
+            case SlowHashAlgorithm::CN_TURTLE_LITE_V2:
+                light = 1;
+                variant = static_cast<int>(algorithm) - static_cast<int>(SlowHashAlgorithm::CN_TURTLE_LITE_V0);
+                pageSize = CN_TURTLE_PAGE_SIZE;
+                scratchpad = CN_TURTLE_SCRATCHPAD;
+                iterations = CN_TURTLE_ITERATIONS;
+                return true;
+            case SlowHashAlgorithm::CN_SOFT_SHELL_V0:
+            case SlowHashAlgorithm::CN_SOFT_SHELL_V1:
+            case SlowHashAlgorithm::CN_SOFT_SHELL_V2:
+                light = 1;
+                variant = static_cast<int>(algorithm) - static_cast<int>(SlowHashAlgorithm::CN_SOFT_SHELL_V0);
+                cn_soft_shell_parameters(height, scratchpad, iterations);
+                pageSize = scratchpad;
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    void slow_hash(const void *data, size_t length, SlowHashAlgorithm algorithm, uint64_t height, Hash &hash)
+    {
+        int light, variant;
+
+        uint64_t pageSize, scratchpad, iterations;
+
+        if (cn_parameters(algorithm, height, light, variant, pageSize, scratchpad, iterations))
+        {
+            cn_slow_hash(
+                data, length, reinterpret_cast<char *>(&hash), light, variant, 0, pageSize, scratchpad, iterations);
+        }
+        else if (algorithm == SlowHashAlgorithm::CHUKWA_V1)
+        {
+            chukwa_slow_hash_v1(data, length, hash);
+        }
+        else
+        {
+            chukwa_slow_hash_v2(data, length, hash);
+        }
+    }
+
+    SlowHashPool::SlowHashPool(size_t threads, bool pinThreads)
+    {
+        const size_t cpus = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+
+        if (threads == 0)
+        {
+            threads = cpus;
+        }
+
+        for (size_t i = 0; i < threads; i++)
+        {
+            m_workers.emplace_back(&SlowHashPool::worker, this, i);
+
+#if defined(__linux__)
+            if (pinThreads)
+            {
+                cpu_set_t cpuset;
+
+                CPU_ZERO(&cpuset);
+
+                CPU_SET(i % cpus, &cpuset);
+
+                pthread_setaffinity_np(m_workers.back().native_handle(), sizeof(cpu_set_t), &cpuset);
+            }
+#endif
+        }
+    }
+
+    SlowHashPool::~SlowHashPool()
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+
+            m_stop = true;
+        }
+
+        m_haveWork.notify_all();
+
+        for (auto &worker : m_workers)
+        {
+            worker.join();
+        }
+    }
+
+    std::future<std::vector<Hash>> SlowHashPool::hash(std::vector<SlowHashJob> jobs, size_t chunkSize)
+    {
+        auto promise = std::make_shared<std::promise<std::vector<Hash>>>();
+
+        auto future = promise->get_future();
+
+        hash(
+            std::move(jobs), [promise](std::vector<Hash> results) { promise->set_value(std::move(results)); }, chunkSize);
+
+        return future;
+    }
+
+    void SlowHashPool::hash(
+        std::vector<SlowHashJob> jobs,
+        std::function<void(std::vector<Hash>)> callback,
+        size_t chunkSize)
+    {
+        auto batch = std::make_shared<Batch>();
+
+        batch->results.resize(jobs.size());
+
+        batch->remaining = jobs.size();
+
+        batch->jobs = std::move(jobs);
+
+        batch->done = std::move(callback);
+
+        enqueue(batch, chunkSize);
+    }
+
+    size_t SlowHashPool::threads() const
+    {
+        return m_workers.size();
+    }
+
+    void SlowHashPool::enqueue(std::shared_ptr<Batch> batch, size_t chunkSize)
+    {
+        const size_t count = batch->jobs.size();
+
+        /* Aim for a handful of chunks per worker so that the load evens out
+           when some jobs (e.g. full CryptoNight vs. Turtle) take longer */
+        if (chunkSize == 0)
+        {
+            chunkSize = std::max<size_t>(count / (m_workers.size() * 4), 1);
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+
+            for (size_t begin = 0; begin < count; begin += chunkSize)
+            {
+                m_queue.push_back({batch, begin, std::min(begin + chunkSize, count)});
+            }
+
+            /* An empty batch still gets a chunk, so that its callback runs on a worker too */
+            if (count == 0)
+            {
+                m_queue.push_back({batch, 0, 0});
+            }
+        }
+
+        m_haveWork.notify_all();
+    }
+
+    void SlowHashPool::worker(size_t index)
+    {
+        while (true)
+        {
+            Chunk chunk;
+
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+
+                m_haveWork.wait(lock, [this] { return m_stop || !m_queue.empty(); });
+
+                /* Batches already queued are finished before the workers exit, so that
+                   every callback still runs when the pool is destroyed */
+                if (m_queue.empty())
+                {
+                    break;
+                }
+
+                chunk = std::move(m_queue.front());
+
+                m_queue.pop_front();
+            }
+
+            const auto &jobs = chunk.batch->jobs;
+
+            std::vector<const void *> data;
+
+            std::vector<size_t> lengths;
+
+            size_t i = chunk.begin;
+
+            while (i < chunk.end)
+            {
+                int light, variant;
+
+                uint64_t pageSize, scratchpad, iterations;
+
+                if (!cn_parameters(
+                        jobs[i].algorithm, jobs[i].height, light, variant, pageSize, scratchpad, iterations))
+                {
+                    slow_hash(
+                        jobs[i].blob.data(),
+                        jobs[i].blob.size(),
+                        jobs[i].algorithm,
+                        jobs[i].height,
+                        chunk.batch->results[i]);
+
+                    i++;
+
+                    continue;
+                }
+
+                /* Gather the run of jobs that share the same parameters so that
+                   they can go through the interleaved batch kernel together */
+                size_t end = i + 1;
+
+                while (end < chunk.end && jobs[end].algorithm == jobs[i].algorithm
+                       && (jobs[end].height == jobs[i].height
+                           || jobs[i].algorithm < SlowHashAlgorithm::CN_SOFT_SHELL_V0))
+                {
+                    end++;
+                }
+
+                data.clear();
+
+                lengths.clear();
+
+                for (size_t j = i; j < end; j++)
+                {
+                    data.push_back(jobs[j].blob.data());
+
+                    lengths.push_back(jobs[j].blob.size());
+                }
+
+                cn_slow_hash_batch(
+                    data.data(),
+                    lengths.data(),
+                    end - i,
+                    reinterpret_cast<char(*)[HASH_SIZE]>(&chunk.batch->results[i]),
+                    light,
+                    variant,
+                    0,
+                    pageSize,
+                    scratchpad,
+                    iterations);
+
+                i = end;
+            }
+
+            if (chunk.batch->remaining.fetch_sub(chunk.end - chunk.begin) == chunk.end - chunk.begin)
+            {
+                chunk.batch->done(std::move(chunk.batch->results));
+            }
+        }
+
+        slow_hash_thread_teardown();
+    }
+} // namespace Crypto
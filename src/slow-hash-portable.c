@@ -14,18 +14,6 @@
 
 #include "slow-hash-common.h"
 
-void slow_hash_allocate_state(void)
-{
-    // Do nothing, this is just to maintain compatibility with the upgraded slow-hash.c
-    return;
-}
-
-void slow_hash_free_state(void)
-{
-    // As above
-    return;
-}
-
 #if defined(__GNUC__)
 #define RDATA_ALIGN16 __attribute__((aligned(16)))
 #define STATIC static
@@ -144,7 +132,8 @@ void cn_slow_hash(
     uint8_t long_state[page_size];
 #else /* FORCE_USE_HEAP */
 #pragma message("warning: ACTIVATING FORCE_USE_HEAP IN slow-hash-portable.c")
-    uint8_t *long_state = (uint8_t *)malloc(page_size);
+    /* The scratchpad is owned by the calling thread and survives between calls */
+    uint8_t *long_state = slow_hash_allocate_state(page_size);
 #endif /* FORCE_USE_HEAP */
 
     if (prehashed)
@@ -235,10 +224,32 @@ void cn_slow_hash(
     hash_permutation(&state.hs);
     extra_hashes[state.hs.b[0] & 3](&state, 200, hash);
     oaes_free((OAES_CTX **)&aes_ctx);
+}
 
-#ifdef FORCE_USE_HEAP
-    free(long_state);
-#endif /* FORCE_USE_HEAP */
+/**
+ * @brief computes the CryptoNight hash of many inputs that share the same parameters
+ *
+ * This platform has no interleaved kernel, so the inputs are simply hashed one
+ * at a time. The results are identical to calling cn_slow_hash on each input.
+ */
+void cn_slow_hash_batch(
+    const void *const *data,
+    const size_t *length,
+    size_t count,
+    char (*hashes)[HASH_SIZE],
+    int light,
+    int variant,
+    int prehashed,
+    uint64_t page_size,
+    uint64_t scratchpad,
+    uint64_t iterations)
+{
+    size_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        cn_slow_hash(data[i], length[i], hashes[i], light, variant, prehashed, page_size, scratchpad, iterations);
+    }
 }
 
 #endif
@@ -0,0 +1,183 @@
+// Parts of this file are originally copyright (c) 2012-2013 The Cryptonote developers
+// Copyright (c) 2014-2018, The Monero Project
+// Copyright (c) 2014-2018, The Aeon Project
+// Copyright (c) 2018-2019, The TurtleCoin Developers
+//
+// Please see the included LICENSE file for more information.
+
+/* This file contains the per-thread scratchpad arena shared by all of the
+   CryptoNight slow-hash implementations (x86, ARM, and portable) */
+
+#include "hash-ops.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#if defined(_MSC_VER) || defined(__MINGW32__)
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sys/mman.h>
+#endif
+
+#if defined(_MSC_VER)
+#define THREADV __declspec(thread)
+#else
+#define THREADV __thread
+#endif
+
+/* The scratchpad lives for as long as the thread does and is only ever grown,
+   so that it is always large enough for the biggest variant requested so far */
+static THREADV uint8_t *hp_state = NULL;
+static THREADV uint64_t hp_size = 0;
+static THREADV int hp_allocated = 0;
+
+#if defined(_MSC_VER) || defined(__MINGW32__)
+static BOOL SetLockPagesPrivilege(HANDLE hProcess, BOOL bEnable)
+{
+    struct
+    {
+        DWORD count;
+        LUID_AND_ATTRIBUTES privilege[1];
+    } info;
+
+    HANDLE token;
+
+    if (!OpenProcessToken(hProcess, TOKEN_ADJUST_PRIVILEGES, &token))
+    {
+        return FALSE;
+    }
+
+    info.count = 1;
+    info.privilege[0].Attributes = bEnable ? SE_PRIVILEGE_ENABLED : 0;
+
+    if (!LookupPrivilegeValue(NULL, SE_LOCK_MEMORY_NAME, &(info.privilege[0].Luid)))
+    {
+        return FALSE;
+    }
+
+    if (!AdjustTokenPrivileges(token, FALSE, (PTOKEN_PRIVILEGES)&info, 0, NULL, NULL))
+    {
+        return FALSE;
+    }
+
+    if (GetLastError() != ERROR_SUCCESS)
+    {
+        return FALSE;
+    }
+
+    CloseHandle(token);
+
+    return TRUE;
+}
+#else
+static pthread_key_t hp_key;
+static pthread_once_t hp_key_once = PTHREAD_ONCE_INIT;
+
+/* Releases the scratchpad of a thread that exits without calling slow_hash_thread_teardown */
+static void slow_hash_thread_exit(void *unused)
+{
+    (void)unused;
+
+    slow_hash_free_state();
+}
+
+static void slow_hash_make_key(void)
+{
+    pthread_key_create(&hp_key, slow_hash_thread_exit);
+}
+#endif
+
+/**
+ * @brief frees the scratchpad allocated by slow_hash_allocate_state
+ */
+
+void slow_hash_free_state(void)
+{
+    if (hp_state == NULL)
+    {
+        return;
+    }
+
+    if (!hp_allocated)
+    {
+        free(hp_state);
+    }
+    else
+    {
+#if defined(_MSC_VER) || defined(__MINGW32__)
+        VirtualFree(hp_state, 0, MEM_RELEASE);
+#else
+        munmap(hp_state, hp_size);
+#endif
+    }
+
+    hp_state = NULL;
+    hp_size = 0;
+    hp_allocated = 0;
+}
+
+/**
+ * @brief returns the calling thread's scratchpad, making sure it holds at least page_size bytes
+ *
+ * The first call on a thread (or a call asking for a larger scratchpad than any
+ * before it) tries to allocate the buffer using OS support for huge pages to
+ * reduce TLB misses during the random accesses to the scratch buffer, falling
+ * back to the heap. Every other call simply hands back the existing buffer so
+ * that no system calls or page faults are paid for on a per-hash basis.
+ *
+ * @param page_size the number of bytes the caller requires
+ * @return a 16-byte aligned pointer to the scratchpad or NULL if allocation failed
+ */
+
+uint8_t *slow_hash_allocate_state(uint64_t page_size)
+{
+    if (hp_state != NULL && hp_size >= page_size)
+    {
+        return hp_state;
+    }
+
+    slow_hash_free_state();
+
+#if defined(_MSC_VER) || defined(__MINGW32__)
+    SetLockPagesPrivilege(GetCurrentProcess(), TRUE);
+    hp_state = (uint8_t *)VirtualAlloc(NULL, page_size, MEM_LARGE_PAGES | MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+#else
+    pthread_once(&hp_key_once, slow_hash_make_key);
+    pthread_setspecific(hp_key, &hp_key);
+
+#if defined(__APPLE__) || defined(__FreeBSD__) || defined(__OpenBSD__) || defined(__DragonFly__) \
+    || defined(__NetBSD__) || defined(__EMSCRIPTEN__)
+    hp_state = mmap(0, page_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0);
+#else
+    hp_state = mmap(0, page_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+#endif
+
+    if (hp_state == MAP_FAILED)
+    {
+        hp_state = NULL;
+    }
+#endif
+
+    hp_allocated = 1;
+
+    if (hp_state == NULL)
+    {
+        hp_allocated = 0;
+        hp_state = (uint8_t *)malloc(page_size);
+    }
+
+    hp_size = (hp_state != NULL) ? page_size : 0;
+
+    return hp_state;
+}
+
+void slow_hash_thread_init(uint64_t page_size)
+{
+    slow_hash_allocate_state(page_size);
+}
+
+void slow_hash_thread_teardown(void)
+{
+    slow_hash_free_state();
+}
@@ -34,7 +34,6 @@
 #define RDATA_ALIGN16 __attribute__((aligned(16)))
 #endif
 #else
-#include <sys/mman.h>
 #include <wmmintrin.h>
 #define STATIC static
 #define INLINE inline
@@ -108,15 +107,6 @@
     _b1 = _b;                                                   \
     _b = _c;
 
-#if defined(_MSC_VER)
-#define THREADV __declspec(thread)
-#else
-#define THREADV __thread
-#endif
-
-THREADV uint8_t *hp_state = NULL;
-THREADV int hp_allocated = 0;
-
 #if defined(_MSC_VER)
 #define cpuid(info, x) __cpuidex(info, x, 0)
 #else
@@ -356,118 +346,6 @@ STATIC INLINE void
     }
 }
 
-#if defined(_MSC_VER) || defined(__MINGW32__)
-BOOL SetLockPagesPrivilege(HANDLE hProcess, BOOL bEnable)
-{
-    struct
-    {
-        DWORD count;
-        LUID_AND_ATTRIBUTES privilege[1];
-    } info;
-
-    HANDLE token;
-
-    if (!OpenProcessToken(hProcess, TOKEN_ADJUST_PRIVILEGES, &token))
-    {
-        return FALSE;
-    }
-
-    info.count = 1;
-    info.privilege[0].Attributes = bEnable ? SE_PRIVILEGE_ENABLED : 0;
-
-    if (!LookupPrivilegeValue(NULL, SE_LOCK_MEMORY_NAME, &(info.privilege[0].Luid)))
-    {
-        return FALSE;
-    }
-
-    if (!AdjustTokenPrivileges(token, FALSE, (PTOKEN_PRIVILEGES)&info, 0, NULL, NULL))
-    {
-        return FALSE;
-    }
-
-    if (GetLastError() != ERROR_SUCCESS)
-    {
-        return FALSE;
-    }
-
-    CloseHandle(token);
-
-    return TRUE;
-}
-#endif
-
-/**
- * @brief allocate the 2MB scratch buffer using OS support for huge pages, if available
- *
- * This function tries to allocate the 2MB scratch buffer using a single
- * 2MB "huge page" (instead of the usual 4KB page sizes) to reduce TLB misses
- * during the random accesses to the scratch buffer.  This is one of the
- * important speed optimizations needed to make CryptoNight faster.
- *
- * No parameters.  Updates a thread-local pointer, hp_state, to point to
- * the allocated buffer.
- */
-
-void slow_hash_allocate_state(uint64_t page_size)
-{
-    if (hp_state != NULL)
-    {
-        return;
-    }
-
-#if defined(_MSC_VER) || defined(__MINGW32__)
-    SetLockPagesPrivilege(GetCurrentProcess(), TRUE);
-    hp_state = (uint8_t *)VirtualAlloc(hp_state, page_size, MEM_LARGE_PAGES | MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
-#else
-#if defined(__APPLE__) || defined(__FreeBSD__) || defined(__OpenBSD__) || defined(__DragonFly__) || defined(__NetBSD__)
-    hp_state = mmap(0, page_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, 0, 0);
-#else
-    hp_state = mmap(0, page_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, 0, 0);
-#endif
-
-    if (hp_state == MAP_FAILED)
-    {
-        hp_state = NULL;
-    }
-#endif
-
-    hp_allocated = 1;
-
-    if (hp_state == NULL)
-    {
-        hp_allocated = 0;
-        hp_state = (uint8_t *)malloc(page_size);
-    }
-}
-
-/**
- *@brief frees the state allocated by slow_hash_allocate_state
- */
-
-void slow_hash_free_state(uint64_t page_size)
-{
-    if (hp_state == NULL)
-    {
-        return;
-    }
-
-    if (!hp_allocated)
-    {
-        free(hp_state);
-    }
-    else
-    {
-#if defined(_MSC_VER) || defined(__MINGW32__)
-        VirtualFree(hp_state, 0, MEM_RELEASE);
-#else
-        munmap(hp_state, page_size);
-#endif
-    }
-
-    hp_state = NULL;
-    hp_allocated = 0;
-}
-
 /**
  * @brief the hash function implementing CryptoNight, used for the Monero proof-of-work
  *
@@ -532,7 +410,8 @@ void cn_slow_hash(
     static void (*const extra_hashes[4])(const void *, size_t, char *) = {
         hash_extra_blake, hash_extra_groestl, hash_extra_jh, hash_extra_skein};
 
-    slow_hash_allocate_state(page_size);
+    /* The scratchpad is owned by the calling thread and survives between calls */
+    uint8_t *hp_state = slow_hash_allocate_state(page_size);
 
     /* CryptoNight Step 1:  Use Keccak1600 to initialize the 'state' (and 'text') buffers from the data. */
     if (prehashed)
@@ -651,7 +530,255 @@ void cn_slow_hash(
     memcpy(state.init, text, INIT_SIZE_BYTE);
     hash_permutation(&state.hs);
     extra_hashes[state.hs.b[0] & 3](&state, 200, hash);
-    slow_hash_free_state(page_size);
+}
+
+/* The state carried by one lane of the interleaved batch kernel below */
+typedef struct
+{
+    RDATA_ALIGN16 uint64_t a[2];
+    RDATA_ALIGN16 uint64_t b[4];
+    RDATA_ALIGN16 uint64_t c[2];
+    __m128i _b, _b1;
+    uint64_t division_result;
+    uint64_t sqrt_result;
+    uint64_t tweak1_2;
+    uint8_t *hp_state;
+    union cn_slow_hash_state state;
+} cn_slow_hash_lane;
+
+/**
+ * @brief CryptoNight steps 1 and 2 for a single lane of a batch
+ *
+ * Hashes the input with Keccak1600 and expands the result into the lane's
+ * scratchpad using hardware AES.
+ */
+
+STATIC INLINE void cn_slow_hash_lane_init(
+    cn_slow_hash_lane *lane,
+    const void *data,
+    size_t length,
+    int variant,
+    int prehashed,
+    uint64_t init_rounds)
+{
+    RDATA_ALIGN16 uint8_t expandedKey[240];
+    uint8_t text[INIT_SIZE_BYTE];
+    union cn_slow_hash_state state;
+    uint64_t *b = lane->b;
+    size_t i;
+
+    if (prehashed)
+    {
+        memcpy(&state.hs, data, length);
+    }
+    else
+    {
+        hash_process(&state.hs, data, length);
+    }
+
+    memcpy(text, state.init, INIT_SIZE_BYTE);
+
+    VARIANT1_INIT64();
+    VARIANT2_INIT64();
+
+    aes_expand_key(state.hs.b, expandedKey);
+
+    for (i = 0; i < init_rounds; i++)
+    {
+        aes_pseudo_round(text, text, expandedKey, INIT_SIZE_BLK);
+        memcpy(&lane->hp_state[i * INIT_SIZE_BYTE], text, INIT_SIZE_BYTE);
+    }
+
+    U64(lane->a)[0] = U64(&state.k[0])[0] ^ U64(&state.k[32])[0];
+    U64(lane->a)[1] = U64(&state.k[0])[1] ^ U64(&state.k[32])[1];
+    U64(b)[0] = U64(&state.k[16])[0] ^ U64(&state.k[48])[0];
+    U64(b)[1] = U64(&state.k[16])[1] ^ U64(&state.k[48])[1];
+
+    lane->_b = _mm_load_si128(R128(b));
+    lane->_b1 = _mm_load_si128(R128(b) + 1);
+    lane->division_result = division_result;
+    lane->sqrt_result = sqrt_result;
+    lane->tweak1_2 = tweak1_2;
+
+    memcpy(&lane->state, &state, sizeof(state));
+}
+
+/**
+ * @brief a single iteration of CryptoNight step 3 for one lane of a batch
+ *
+ * This is the same pre_aes()/post_aes() round used by cn_slow_hash, lifted
+ * into a function so that the batch kernels can issue the rounds of several
+ * independent lanes back to back and let the CPU overlap their latencies.
+ */
+
+STATIC INLINE void
+    cn_slow_hash_lane_round(cn_slow_hash_lane *lane, int variant, size_t lightFlag, uint64_t TOTALBLOCKS)
+{
+    uint8_t *hp_state = lane->hp_state;
+    uint64_t *a = lane->a;
+    uint64_t *b = lane->b;
+    uint64_t *c = lane->c;
+    uint64_t division_result = lane->division_result;
+    uint64_t sqrt_result = lane->sqrt_result;
+    const uint64_t tweak1_2 = lane->tweak1_2;
+    __m128i _a, _c, _b = lane->_b, _b1 = lane->_b1;
+    uint64_t hi, lo;
+    uint64_t *p = NULL;
+    size_t j;
+
+    pre_aes();
+    _c = _mm_aesenc_si128(_c, _a);
+    post_aes();
+
+    lane->_b = _b;
+    lane->_b1 = _b1;
+    lane->division_result = division_result;
+    lane->sqrt_result = sqrt_result;
+}
+
+/**
+ * @brief CryptoNight steps 4 and 5 for a single lane of a batch
+ */
+
+STATIC INLINE void cn_slow_hash_lane_final(cn_slow_hash_lane *lane, uint64_t init_rounds, char *hash)
+{
+    RDATA_ALIGN16 uint8_t expandedKey[240];
+    uint8_t text[INIT_SIZE_BYTE];
+    size_t i;
+
+    static void (*const extra_hashes[4])(const void *, size_t, char *) = {
+        hash_extra_blake, hash_extra_groestl, hash_extra_jh, hash_extra_skein};
+
+    memcpy(text, lane->state.init, INIT_SIZE_BYTE);
+    aes_expand_key(&lane->state.hs.b[32], expandedKey);
+
+    for (i = 0; i < init_rounds; i++)
+    {
+        aes_pseudo_round_xor(text, text, expandedKey, &lane->hp_state[i * INIT_SIZE_BYTE], INIT_SIZE_BLK);
+    }
+
+    memcpy(lane->state.init, text, INIT_SIZE_BYTE);
+    hash_permutation(&lane->state.hs);
+    extra_hashes[lane->state.hs.b[0] & 3](&lane->state, 200, hash);
+}
+
+/**
+ * @brief hashes 2 or 4 inputs at once with their main loops interleaved
+ *
+ * Each lane gets its own page_size slice of the thread's scratchpad. The
+ * main loop is unrolled by hand for each supported lane count so that every
+ * iteration issues the independent scratchpad loads, AES rounds and multiplies
+ * of all lanes before waiting on any of them.
+ */
+
+STATIC INLINE void cn_slow_hash_lanes(
+    const void *const *data,
+    const size_t *length,
+    char (*hashes)[HASH_SIZE],
+    size_t lanes,
+    int light,
+    int variant,
+    int prehashed,
+    uint64_t page_size,
+    uint64_t scratchpad,
+    uint64_t iterations)
+{
+    uint64_t TOTALBLOCKS = (page_size / AES_BLOCK_SIZE);
+    uint64_t init_rounds = (scratchpad / INIT_SIZE_BYTE);
+    uint64_t aes_rounds = (iterations / 2);
+    size_t lightFlag = (light ? 2 : 1);
+
+    cn_slow_hash_lane lane[4];
+    uint8_t *hp_base = slow_hash_allocate_state(page_size * lanes);
+    size_t i, l;
+
+    for (l = 0; l < lanes; l++)
+    {
+        lane[l].hp_state = hp_base + (l * page_size);
+        cn_slow_hash_lane_init(&lane[l], data[l], length[l], variant, prehashed, init_rounds);
+    }
+
+    if (lanes == 4)
+    {
+        for (i = 0; i < aes_rounds; i++)
+        {
+            cn_slow_hash_lane_round(&lane[0], variant, lightFlag, TOTALBLOCKS);
+            cn_slow_hash_lane_round(&lane[1], variant, lightFlag, TOTALBLOCKS);
+            cn_slow_hash_lane_round(&lane[2], variant, lightFlag, TOTALBLOCKS);
+            cn_slow_hash_lane_round(&lane[3], variant, lightFlag, TOTALBLOCKS);
+        }
+    }
+    else
+    {
+        for (i = 0; i < aes_rounds; i++)
+        {
+            cn_slow_hash_lane_round(&lane[0], variant, lightFlag, TOTALBLOCKS);
+            cn_slow_hash_lane_round(&lane[1], variant, lightFlag, TOTALBLOCKS);
+        }
+    }
+
+    for (l = 0; l < lanes; l++)
+    {
+        cn_slow_hash_lane_final(&lane[l], init_rounds, hashes[l]);
+    }
+}
+
+/**
+ * @brief computes the CryptoNight hash of many inputs that share the same parameters
+ *
+ * The results are identical to calling cn_slow_hash on each input in turn.
+ * When hardware AES is available the inputs are processed in groups of four
+ * (for scratchpads of up to CN_SLOW_HASH_BATCH_SMALL_PAGE bytes, which fit in
+ * L2 together) or two with their main loops interleaved. Any remainder, and
+ * every input when only software AES is available, is hashed one at a time.
+ *
+ * @param data an array of count pointers to the data to hash
+ * @param length an array of count lengths in bytes of the data
+ * @param count the number of inputs
+ * @param hashes an array of count buffers in which the 256 bit hashes will be stored
+ */
+void cn_slow_hash_batch(
+    const void *const *data,
+    const size_t *length,
+    size_t count,
+    char (*hashes)[HASH_SIZE],
+    int light,
+    int variant,
+    int prehashed,
+    uint64_t page_size,
+    uint64_t scratchpad,
+    uint64_t iterations)
+{
+    size_t lanes = (page_size <= CN_SLOW_HASH_BATCH_SMALL_PAGE) ? 4 : 2;
+    size_t i = 0;
+
+    if (!force_software_aes() && check_aes_hw())
+    {
+        for (; count - i >= 2; i += lanes)
+        {
+            if (count - i < lanes)
+            {
+                lanes = 2;
+            }
+
+            cn_slow_hash_lanes(
+                &data[i],
+                &length[i],
+                &hashes[i],
+                lanes,
+                light,
+                variant,
+                prehashed,
+                page_size,
+                scratchpad,
+                iterations);
+        }
+    }
+
+    for (; i < count; i++)
+    {
+        cn_slow_hash(data[i], length[i], hashes[i], light, variant, prehashed, page_size, scratchpad, iterations);
+    }
 }
 
 #endif
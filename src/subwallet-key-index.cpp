@@ -0,0 +1,173 @@
+// Copyright (c) 2018-2020, The TurtleCoin Developers
+//
+// Please see the included LICENSE file for more information.
+
+#include "subwallet-key-index.h"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace Crypto
+{
+    const size_t SubwalletKeyIndex::npos;
+
+    static inline uint64_t key_bucket(const PublicKey &key)
+    {
+        uint64_t bucket;
+
+        std::memcpy(&bucket, key.data, sizeof(bucket));
+
+        return bucket;
+    }
+
+    static inline uint32_t key_fingerprint(const PublicKey &key)
+    {
+        uint32_t fingerprint;
+
+        std::memcpy(&fingerprint, key.data + sizeof(uint64_t), sizeof(fingerprint));
+
+        return fingerprint;
+    }
+
+    SubwalletKeyIndex::SubwalletKeyIndex(const std::vector<PublicKey> &publicSpendKeys)
+    {
+        reserve(publicSpendKeys.size());
+
+        /* Every key is appended, so that the indexes line up with publicSpendKeys */
+        for (const auto &key : publicSpendKeys)
+        {
+            insert(key);
+        }
+    }
+
+    size_t SubwalletKeyIndex::add(const PublicKey &publicSpendKey)
+    {
+        const size_t existing = find(publicSpendKey);
+
+        if (existing != npos)
+        {
+            return existing;
+        }
+
+        return insert(publicSpendKey);
+    }
+
+    size_t SubwalletKeyIndex::insert(const PublicKey &publicSpendKey)
+    {
+        if (m_keys.size() >= UINT32_MAX - 1)
+        {
+            throw std::length_error("SubwalletKeyIndex: too many keys");
+        }
+
+        /* Keep the load factor at or below one half so probe sequences stay short */
+        if ((m_keys.size() + 1) * 2 > m_slots.size())
+        {
+            rehash(m_slots.empty() ? 16 : m_slots.size() * 2);
+        }
+
+        m_keys.push_back(publicSpendKey);
+
+        const uint32_t fingerprint = key_fingerprint(publicSpendKey);
+
+        for (size_t i = key_bucket(publicSpendKey) & m_mask;; i = (i + 1) & m_mask)
+        {
+            if (m_slots[i].index == 0)
+            {
+                m_slots[i] = {fingerprint, static_cast<uint32_t>(m_keys.size())};
+
+                break;
+            }
+        }
+
+        return m_keys.size() - 1;
+    }
+
+    void SubwalletKeyIndex::reserve(const size_t count)
+    {
+        size_t slotCount = 16;
+
+        while (slotCount < count * 2)
+        {
+            slotCount *= 2;
+        }
+
+        if (slotCount > m_slots.size())
+        {
+            rehash(slotCount);
+        }
+
+        m_keys.reserve(count);
+    }
+
+    size_t SubwalletKeyIndex::find(const PublicKey &publicSpendKey) const
+    {
+        if (m_slots.empty())
+        {
+            return npos;
+        }
+
+        const uint32_t fingerprint = key_fingerprint(publicSpendKey);
+
+        for (size_t i = key_bucket(publicSpendKey) & m_mask;; i = (i + 1) & m_mask)
+        {
+            const Slot &slot = m_slots[i];
+
+            if (slot.index == 0)
+            {
+                return npos;
+            }
+
+            if (slot.fingerprint == fingerprint && m_keys[slot.index - 1] == publicSpendKey)
+            {
+                return slot.index - 1;
+            }
+        }
+    }
+
+    bool SubwalletKeyIndex::contains(const PublicKey &publicSpendKey) const
+    {
+        return find(publicSpendKey) != npos;
+    }
+
+    const PublicKey &SubwalletKeyIndex::operator[](const size_t index) const
+    {
+        return m_keys[index];
+    }
+
+    const std::vector<PublicKey> &SubwalletKeyIndex::keys() const
+    {
+        return m_keys;
+    }
+
+    size_t SubwalletKeyIndex::size() const
+    {
+        return m_keys.size();
+    }
+
+    bool SubwalletKeyIndex::empty() const
+    {
+        return m_keys.empty();
+    }
+
+    void SubwalletKeyIndex::rehash(const size_t slotCount)
+    {
+        m_slots.assign(slotCount, Slot {0, 0});
+
+        m_mask = slotCount - 1;
+
+        for (size_t index = 0; index < m_keys.size(); index++)
+        {
+            const PublicKey &key = m_keys[index];
+
+            for (size_t i = key_bucket(key) & m_mask;; i = (i + 1) & m_mask)
+            {
+                if (m_slots[i].index == 0)
+                {
+                    m_slots[i] = {key_fingerprint(key), static_cast<uint32_t>(index + 1)};
+
+                    break;
+                }
+            }
+        }
+    }
+} // namespace Crypto
@@ -0,0 +1,152 @@
+// Copyright (c) 2018-2020, The TurtleCoin Developers
+//
+// Please see the included LICENSE file for more information.
+
+#include "tree-hash-accumulator.h"
+
+#include "hash.h"
+
+#include <stdexcept>
+
+namespace Crypto
+{
+    static inline Hash hash_pair(const Hash &left, const Hash &right)
+    {
+        Hash pair[2] = {left, right};
+
+        return cn_fast_hash(pair, sizeof(pair));
+    }
+
+    TreeHashAccumulator::TreeHashAccumulator(const std::vector<Hash> &leaves)
+    {
+        append(leaves.data(), leaves.size());
+    }
+
+    void TreeHashAccumulator::append(const Hash &leaf)
+    {
+        if (m_levels.empty())
+        {
+            m_levels.emplace_back();
+        }
+
+        m_levels[0].push_back(leaf);
+
+        /* Close every subtree that this leaf completes */
+        for (size_t level = 0; m_levels[level].size() % 2 == 0; level++)
+        {
+            if (level + 1 == m_levels.size())
+            {
+                m_levels.emplace_back();
+            }
+
+            const auto &below = m_levels[level];
+
+            m_levels[level + 1].push_back(hash_pair(below[below.size() - 2], below[below.size() - 1]));
+        }
+    }
+
+    void TreeHashAccumulator::append(const Hash *leaves, const size_t count)
+    {
+        reserve(size() + count);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            append(leaves[i]);
+        }
+    }
+
+    void TreeHashAccumulator::reserve(const size_t count)
+    {
+        for (size_t level = 0; (count >> level) > 0; level++)
+        {
+            if (level == m_levels.size())
+            {
+                m_levels.emplace_back();
+            }
+
+            m_levels[level].reserve(count >> level);
+        }
+    }
+
+    void TreeHashAccumulator::clear()
+    {
+        m_levels.clear();
+    }
+
+    Hash TreeHashAccumulator::root() const
+    {
+        const size_t count = size();
+
+        if (count == 0)
+        {
+            throw std::logic_error("The tree hash of no leaves is undefined");
+        }
+
+        if (count == 1)
+        {
+            return m_levels[0][0];
+        }
+
+        /* cnt is the largest power of two below count, the first 2 * cnt - count slots are single leaves */
+        size_t depth = 0;
+
+        while ((size_t(1) << (depth + 1)) < count)
+        {
+            depth++;
+        }
+
+        const size_t cnt = size_t(1) << depth;
+
+        return slotNode(depth, 0, 2 * cnt - count);
+    }
+
+    Hash TreeHashAccumulator::leafRange(const size_t level, const size_t first) const
+    {
+        if (first % (size_t(1) << level) == 0)
+        {
+            return m_levels[level][first >> level];
+        }
+
+        const size_t half = size_t(1) << (level - 1);
+
+        return hash_pair(leafRange(level - 1, first), leafRange(level - 1, first + half));
+    }
+
+    Hash TreeHashAccumulator::slotNode(const size_t level, const size_t index, const size_t rawSlots) const
+    {
+        const size_t first = index << level;
+
+        const size_t last = (index + 1) << level;
+
+        /* Every slot is a leaf, so this is an aligned subtree of the leaves */
+        if (last <= rawSlots)
+        {
+            return m_levels[level][index];
+        }
+
+        /* Every slot is a pair, so this is the subtree of the 2^(level + 1) leaves from slot first */
+        if (first >= rawSlots)
+        {
+            return leafRange(level + 1, 2 * first - rawSlots);
+        }
+
+        return hash_pair(slotNode(level - 1, 2 * index, rawSlots), slotNode(level - 1, 2 * index + 1, rawSlots));
+    }
+
+    const std::vector<Hash> &TreeHashAccumulator::leaves() const
+    {
+        static const std::vector<Hash> none;
+
+        return m_levels.empty() ? none : m_levels[0];
+    }
+
+    size_t TreeHashAccumulator::size() const
+    {
+        return m_levels.empty() ? 0 : m_levels[0].size();
+    }
+
+    bool TreeHashAccumulator::empty() const
+    {
+        return size() == 0;
+    }
+} // namespace Crypto
@@ -26,7 +26,58 @@
 #include <string.h>
 #include <stdlib.h>
 
-void tree_hash(const char (*hashes)[HASH_SIZE], size_t count, char *root_hash)
+/* Each level is hashed this many pairs at a time through cn_fast_hash_batch */
+#define TREE_HASH_BATCH 64
+
+/* Above this many hashes of scratch space tree_hash and tree_branch take it from
+   the heap rather than the stack, which may be small on worker threads */
+#define TREE_HASH_STACK_LIMIT 512
+
+/* out[j] = H(in[2j] || in[2j + 1]) for every j below pairs, out may be the same buffer as in */
+static void tree_hash_pairs(const char (*in)[HASH_SIZE], size_t pairs, char (*out)[HASH_SIZE])
+{
+    const void *data[TREE_HASH_BATCH];
+    size_t length[TREE_HASH_BATCH];
+    char hashes[TREE_HASH_BATCH][HASH_SIZE];
+    size_t i, j, n;
+
+    for (j = 0; j < pairs; j += n)
+    {
+        n = pairs - j < TREE_HASH_BATCH ? pairs - j : TREE_HASH_BATCH;
+
+        for (i = 0; i < n; i++)
+        {
+            data[i] = in[2 * (j + i)];
+            length[i] = 2 * HASH_SIZE;
+        }
+
+        /* Every input of this chunk is read before any of its outputs are written, and
+           later chunks only read from 2 * (j + n) onwards, so hashing in place is safe */
+        cn_fast_hash_batch(data, length, n, hashes);
+        memcpy(out[j], hashes, n * HASH_SIZE);
+    }
+}
+
+size_t tree_hash_scratch_size(size_t count)
+{
+    size_t i;
+    size_t cnt = 1;
+    assert(count > 0);
+    for (i = sizeof(size_t) << 2; i > 0; i >>= 1)
+    {
+        if (cnt << i <= count)
+        {
+            cnt <<= i;
+        }
+    }
+    return cnt;
+}
+
+void tree_hash_with_scratch(
+    const char (*hashes)[HASH_SIZE],
+    size_t count,
+    char (*scratch)[HASH_SIZE],
+    char *root_hash)
 {
     assert(count > 0);
     if (count == 1)
@@ -39,30 +90,42 @@ void tree_hash(const char (*hashes)[HASH_SIZE], size_t count, char *root_hash)
     }
     else
     {
-        size_t i, j;
         size_t cnt = count - 1;
-        char(*ints)[HASH_SIZE];
+        size_t i;
         for (i = 1; i < 8 * sizeof(size_t); i <<= 1)
         {
             cnt |= cnt >> i;
         }
         cnt &= ~(cnt >> 1);
-        ints = alloca(cnt * HASH_SIZE);
-        memcpy(ints, hashes, (2 * cnt - count) * HASH_SIZE);
-        for (i = 2 * cnt - count, j = 2 * cnt - count; j < cnt; i += 2, ++j)
-        {
-            cn_fast_hash(hashes[i], 2 * HASH_SIZE, ints[j]);
-        }
-        assert(i == count);
+        memcpy(scratch, hashes, (2 * cnt - count) * HASH_SIZE);
+        tree_hash_pairs(hashes + 2 * cnt - count, count - cnt, scratch + 2 * cnt - count);
         while (cnt > 2)
         {
             cnt >>= 1;
-            for (i = 0, j = 0; j < cnt; i += 2, ++j)
-            {
-                cn_fast_hash(ints[i], 2 * HASH_SIZE, ints[j]);
-            }
+            tree_hash_pairs((const char(*)[HASH_SIZE])scratch, cnt, scratch);
         }
-        cn_fast_hash(ints[0], 2 * HASH_SIZE, root_hash);
+        cn_fast_hash(scratch[0], 2 * HASH_SIZE, root_hash);
+    }
+}
+
+void tree_hash(const char (*hashes)[HASH_SIZE], size_t count, char *root_hash)
+{
+    const size_t size = tree_hash_scratch_size(count);
+    char(*scratch)[HASH_SIZE];
+    if (size <= TREE_HASH_STACK_LIMIT)
+    {
+        scratch = alloca(size * HASH_SIZE);
+        tree_hash_with_scratch(hashes, count, scratch, root_hash);
+    }
+    else
+    {
+        scratch = malloc(size * HASH_SIZE);
+        if (scratch == NULL)
+        {
+            abort();
+        }
+        tree_hash_with_scratch(hashes, count, scratch, root_hash);
+        free(scratch);
     }
 }
 
@@ -82,40 +145,46 @@ size_t tree_depth(size_t count)
     return depth;
 }
 
-void tree_branch(const char (*hashes)[HASH_SIZE], size_t count, char (*branch)[HASH_SIZE])
+void tree_branch_with_scratch(
+    const char (*hashes)[HASH_SIZE],
+    size_t count,
+    char (*scratch)[HASH_SIZE],
+    char (*branch)[HASH_SIZE])
 {
-    size_t i, j;
-    size_t cnt = 1;
-    size_t depth = 0;
-    char(*ints)[HASH_SIZE];
-    assert(count > 0);
-    for (i = sizeof(size_t) << 2; i > 0; i >>= 1)
-    {
-        if (cnt << i <= count)
-        {
-            cnt <<= i;
-            depth += i;
-        }
-    }
+    size_t cnt = tree_hash_scratch_size(count);
+    size_t depth = tree_depth(count);
     assert(cnt == 1ULL << depth);
-    assert(depth == tree_depth(count));
-    ints = alloca((cnt - 1) * HASH_SIZE);
-    memcpy(ints, hashes + 1, (2 * cnt - count - 1) * HASH_SIZE);
-    for (i = 2 * cnt - count, j = 2 * cnt - count - 1; j < cnt - 1; i += 2, ++j)
-    {
-        cn_fast_hash(hashes[i], 2 * HASH_SIZE, ints[j]);
-    }
-    assert(i == count);
+    memcpy(scratch, hashes + 1, (2 * cnt - count - 1) * HASH_SIZE);
+    tree_hash_pairs(hashes + 2 * cnt - count, count - cnt, scratch + 2 * cnt - count - 1);
     while (depth > 0)
     {
         assert(cnt == 1ULL << depth);
         cnt >>= 1;
         --depth;
-        memcpy(branch[depth], ints[0], HASH_SIZE);
-        for (i = 1, j = 0; j < cnt - 1; i += 2, ++j)
+        memcpy(branch[depth], scratch[0], HASH_SIZE);
+        /* The pairs start from the second entry, so this level is written one entry behind what it reads */
+        tree_hash_pairs((const char(*)[HASH_SIZE])(scratch + 1), cnt - 1, scratch);
+    }
+}
+
+void tree_branch(const char (*hashes)[HASH_SIZE], size_t count, char (*branch)[HASH_SIZE])
+{
+    const size_t size = tree_hash_scratch_size(count);
+    char(*scratch)[HASH_SIZE];
+    if (size <= TREE_HASH_STACK_LIMIT)
+    {
+        scratch = alloca(size * HASH_SIZE);
+        tree_branch_with_scratch(hashes, count, scratch, branch);
+    }
+    else
+    {
+        scratch = malloc(size * HASH_SIZE);
+        if (scratch == NULL)
         {
-            cn_fast_hash(ints[i], 2 * HASH_SIZE, ints[j]);
+            abort();
         }
+        tree_branch_with_scratch(hashes, count, scratch, branch);
+        free(scratch);
     }
 }
 
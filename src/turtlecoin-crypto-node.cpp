@@ -2,6 +2,9 @@
 //
 // Please see the included LICENSE file for more information.
 
+#include <algorithm>
+#include <cstring>
+#include <functional>
 #include <nan.h>
 #include <turtlecoin-crypto.h>
 #include <v8.h>
@@ -106,167 +109,210 @@ inline v8::Local<v8::Array> toV8Array(const std::vector<std::string> &vector)
     return arr;
 }
 
-/*
- *
- * Core Cryptographic Operations
- *
- */
-void calculateMultisigPrivateKeys(const Nan::FunctionCallbackInfo<v8::Value> &info)
+struct KeyPairResult
 {
-    /* Setup our return object */
-    v8::Local<v8::Value> functionReturnValue = Nan::New("").ToLocalChecked();
+    std::string publicKey;
 
-    bool functionSuccess = false;
+    std::string secretKey;
+};
 
-    std::string privateSpendKey = getString(info, 0);
+struct PreparedRingSignaturesResult
+{
+    std::vector<std::string> signatures;
 
-    std::vector<std::string> keys = toStringVector(info, 1);
+    std::string key;
+};
 
-    if (!privateSpendKey.empty() && keys.size() != 0)
-    {
-        try
-        {
-            std::vector<std::string> multiSigKeys =
-                Core::Cryptography::calculateMultisigPrivateKeys(privateSpendKey, keys);
+inline v8::Local<v8::Value> toV8Value(const std::string &value)
+{
+    return Nan::New(value).ToLocalChecked();
+}
 
-            functionReturnValue = toV8Array(multiSigKeys);
+inline v8::Local<v8::Value> toV8Value(const std::vector<std::string> &value)
+{
+    return toV8Array(value);
+}
 
-            functionSuccess = true;
-        }
-        catch (const std::exception &)
-        {
-            functionSuccess = false;
-        }
-    }
+inline v8::Local<v8::Value> toV8Value(const std::vector<uint8_t> &value)
+{
+    return Nan::CopyBuffer(reinterpret_cast<const char *>(value.data()), value.size()).ToLocalChecked();
+}
 
-    info.GetReturnValue().Set(prepareResult(functionSuccess, functionReturnValue));
+inline v8::Local<v8::Value> toV8Value(const bool value)
+{
+    return Nan::New(value);
 }
 
-void calculateSharedPrivateKey(const Nan::FunctionCallbackInfo<v8::Value> &info)
+inline v8::Local<v8::Value> toV8Value(const uint32_t value)
 {
-    /* Setup our return object */
-    v8::Local<v8::Value> functionReturnValue = Nan::New("").ToLocalChecked();
+    return Nan::New(value);
+}
 
-    bool functionSuccess = false;
+inline v8::Local<v8::Value> toV8Value(const KeyPairResult &value)
+{
+    v8::Local<v8::Object> jsonObject = Nan::New<v8::Object>();
 
-    std::vector<std::string> keys = toStringVector(info, 0);
+    Nan::Set(jsonObject, Nan::New("publicKey").ToLocalChecked(), toV8Value(value.publicKey));
 
-    if (keys.size() != 0)
-    {
-        try
-        {
-            std::string result = Core::Cryptography::calculateSharedPrivateKey(keys);
+    Nan::Set(jsonObject, Nan::New("secretKey").ToLocalChecked(), toV8Value(value.secretKey));
 
-            functionReturnValue = Nan::New(result).ToLocalChecked();
+    return jsonObject;
+}
 
-            functionSuccess = true;
-        }
-        catch (const std::exception &)
-        {
-            functionSuccess = false;
-        }
-    }
+inline v8::Local<v8::Value> toV8Value(const PreparedRingSignaturesResult &value)
+{
+    v8::Local<v8::Object> jsonObject = Nan::New<v8::Object>();
 
-    info.GetReturnValue().Set(prepareResult(functionSuccess, functionReturnValue));
+    Nan::Set(jsonObject, Nan::New("signatures").ToLocalChecked(), toV8Value(value.signatures));
+
+    Nan::Set(jsonObject, Nan::New("key").ToLocalChecked(), toV8Value(value.key));
+
+    return jsonObject;
 }
 
-void calculateSharedPublicKey(const Nan::FunctionCallbackInfo<v8::Value> &info)
+/* A job fills in its result and returns whether it succeeded. Every method
+   reads and validates its arguments into a job, which the synchronous export
+   runs in place and the asynchronous export hands to the libuv threadpool, so
+   a job must only capture plain C++ values */
+template<typename T> using CryptoJob = std::function<bool(T &)>;
+
+/* Runs the job on the main thread and returns the result in [err, value] format */
+template<typename T> void runJob(const Nan::FunctionCallbackInfo<v8::Value> &info, const CryptoJob<T> &job)
 {
     /* Setup our return object */
     v8::Local<v8::Value> functionReturnValue = Nan::New("").ToLocalChecked();
 
     bool functionSuccess = false;
 
-    std::vector<std::string> keys = toStringVector(info, 0);
-
-    if (keys.size() != 0)
+    try
     {
-        try
-        {
-            std::string result = Core::Cryptography::calculateSharedPublicKey(keys);
+        T result;
 
-            functionReturnValue = Nan::New(result).ToLocalChecked();
+        if (job(result))
+        {
+            functionReturnValue = toV8Value(result);
 
             functionSuccess = true;
         }
-        catch (const std::exception &)
-        {
-            functionSuccess = false;
-        }
+    }
+    catch (const std::exception &)
+    {
+        functionSuccess = false;
     }
 
     info.GetReturnValue().Set(prepareResult(functionSuccess, functionReturnValue));
 }
 
-void prepareRingSignatures(const Nan::FunctionCallbackInfo<v8::Value> &info)
+/* The check methods never report an error: bad input simply fails the check,
+   so they return a plain boolean rather than [err, value] */
+void runCheck(const Nan::FunctionCallbackInfo<v8::Value> &info, const CryptoJob<bool> &job)
 {
-    /* Setup our return object */
-    v8::Local<v8::Object> jsonObject = Nan::New<v8::Object>();
+    bool result = false;
 
-    bool functionSuccess = false;
+    try
+    {
+        if (!job(result))
+        {
+            result = false;
+        }
+    }
+    catch (const std::exception &)
+    {
+        result = false;
+    }
 
-    std::string prefixHash = getString(info, 0);
+    info.GetReturnValue().Set(Nan::New(result));
+}
 
-    std::string keyImage = getString(info, 1);
+/*
+ *
+ * Core Cryptographic Operations
+ *
+ */
 
-    std::vector<std::string> publicKeys = toStringVector(info, 2);
+CryptoJob<std::vector<std::string>> calculateMultisigPrivateKeysJob(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    std::string privateSpendKey = getString(info, 0);
 
-    uint64_t realOutput = getUInt64(info, 3);
+    std::vector<std::string> keys = toStringVector(info, 1);
 
-    std::string k = getString(info, 4);
+    return [privateSpendKey, keys](std::vector<std::string> &multiSigKeys) {
+        if (privateSpendKey.empty() || keys.size() == 0)
+        {
+            return false;
+        }
 
-    if (!prefixHash.empty() && !keyImage.empty() && publicKeys.size() != 0)
-    {
-        try
+        multiSigKeys = Core::Cryptography::calculateMultisigPrivateKeys(privateSpendKey, keys);
+
+        return true;
+    };
+}
+
+CryptoJob<std::string> calculateSharedPrivateKeyJob(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    std::vector<std::string> keys = toStringVector(info, 0);
+
+    return [keys](std::string &result) {
+        if (keys.size() == 0)
         {
-            std::vector<std::string> signatures;
+            return false;
+        }
 
-            bool success = false;
+        result = Core::Cryptography::calculateSharedPrivateKey(keys);
 
-            if (k.empty())
-            {
-                success = Core::Cryptography::prepareRingSignatures(
-                    prefixHash, keyImage, publicKeys, realOutput, signatures, k);
-            }
-            else
-            {
-                success = Core::Cryptography::prepareRingSignatures(
-                    prefixHash, keyImage, publicKeys, realOutput, k, signatures);
-            }
+        return true;
+    };
+}
 
-            if (success)
-            {
-                v8::Local<v8::String> signaturesProp = Nan::New("signatures").ToLocalChecked();
+CryptoJob<std::string> calculateSharedPublicKeyJob(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    std::vector<std::string> keys = toStringVector(info, 0);
 
-                v8::Local<v8::String> randomScalarProp = Nan::New("key").ToLocalChecked();
+    return [keys](std::string &result) {
+        if (keys.size() == 0)
+        {
+            return false;
+        }
 
-                v8::Local<v8::Value> signaturesValue = toV8Array(signatures);
+        result = Core::Cryptography::calculateSharedPublicKey(keys);
 
-                v8::Local<v8::Value> randomScalarValue = Nan::New(k).ToLocalChecked();
+        return true;
+    };
+}
 
-                Nan::Set(jsonObject, signaturesProp, signaturesValue);
+CryptoJob<PreparedRingSignaturesResult> prepareRingSignaturesJob(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    std::string prefixHash = getString(info, 0);
 
-                Nan::Set(jsonObject, randomScalarProp, randomScalarValue);
+    std::string keyImage = getString(info, 1);
 
-                functionSuccess = true;
-            }
+    std::vector<std::string> publicKeys = toStringVector(info, 2);
+
+    uint64_t realOutput = getUInt64(info, 3);
+
+    std::string k = getString(info, 4);
+
+    return [prefixHash, keyImage, publicKeys, realOutput, k](PreparedRingSignaturesResult &result) {
+        if (prefixHash.empty() || keyImage.empty() || publicKeys.size() == 0)
+        {
+            return false;
         }
-        catch (const std::exception &)
+
+        result.key = k;
+
+        if (k.empty())
         {
-            functionSuccess = false;
+            return Core::Cryptography::prepareRingSignatures(
+                prefixHash, keyImage, publicKeys, realOutput, result.signatures, result.key);
         }
-    }
 
-    info.GetReturnValue().Set(prepareResult(functionSuccess, jsonObject));
+        return Core::Cryptography::prepareRingSignatures(
+            prefixHash, keyImage, publicKeys, realOutput, k, result.signatures);
+    };
 }
 
-void completeRingSignatures(const Nan::FunctionCallbackInfo<v8::Value> &info)
+CryptoJob<std::vector<std::string>> completeRingSignaturesJob(const Nan::FunctionCallbackInfo<v8::Value> &info)
 {
-    /* Setup our return object */
-    v8::Local<v8::Value> functionReturnValue = Nan::New("").ToLocalChecked();
-
-    bool functionSuccess = false;
-
     std::string transactionSecretKey = getString(info, 0);
 
     uint64_t realOutput = getUInt64(info, 1);
@@ -275,38 +321,23 @@ void completeRingSignatures(const Nan::FunctionCallbackInfo<v8::Value> &info)
 
     std::vector<std::string> signatures = toStringVector(info, 3);
 
-    if (!transactionSecretKey.empty() && !k.empty() && signatures.size() != 0)
-    {
-        try
-        {
-            bool success = Core::Cryptography::completeRingSignatures(transactionSecretKey, realOutput, k, signatures);
-
-            if (success)
-            {
-                functionReturnValue = toV8Array(signatures);
-
-                functionSuccess = true;
-            }
-        }
-        catch (const std::exception &)
+    return [transactionSecretKey, realOutput, k, signatures](std::vector<std::string> &result) {
+        if (transactionSecretKey.empty() || k.empty() || signatures.size() == 0)
         {
-            functionSuccess = false;
+            return false;
         }
-    }
 
-    info.GetReturnValue().Set(prepareResult(functionSuccess, functionReturnValue));
+        result = signatures;
+
+        return Core::Cryptography::completeRingSignatures(transactionSecretKey, realOutput, k, result);
+    };
 }
 
-void restoreRingSignatures(const Nan::FunctionCallbackInfo<v8::Value> &info)
+CryptoJob<std::vector<std::string>> restoreRingSignaturesJob(const Nan::FunctionCallbackInfo<v8::Value> &info)
 {
-    /* Setup our return object */
-    v8::Local<v8::Value> functionReturnValue = Nan::New("").ToLocalChecked();
-
-    bool functionSuccess = false;
-
     std::string derivation = getString(info, 0);
 
-    size_t output_index = (size_t)getUInt32(info, 1);
+    size_t outputIndex = (size_t)getUInt32(info, 1);
 
     std::vector<std::string> partialSigningKeys = toStringVector(info, 2);
 
@@ -316,66 +347,40 @@ void restoreRingSignatures(const Nan::FunctionCallbackInfo<v8::Value> &info)
 
     std::vector<std::string> signatures = toStringVector(info, 5);
 
-    if (!derivation.empty() && partialSigningKeys.size() != 0 && !k.empty() && signatures.size() != 0)
-    {
-        try
-        {
-            bool success = Core::Cryptography::restoreRingSignatures(
-                derivation, output_index, partialSigningKeys, realOutput, k, signatures);
-
-            if (success)
-            {
-                functionReturnValue = toV8Array(signatures);
-
-                functionSuccess = true;
-            }
-        }
-        catch (const std::exception &)
+    return [derivation, outputIndex, partialSigningKeys, realOutput, k, signatures](
+               std::vector<std::string> &result) {
+        if (derivation.empty() || partialSigningKeys.size() == 0 || k.empty() || signatures.size() == 0)
         {
-            functionSuccess = false;
+            return false;
         }
-    }
 
-    info.GetReturnValue().Set(prepareResult(functionSuccess, functionReturnValue));
+        result = signatures;
+
+        return Core::Cryptography::restoreRingSignatures(
+            derivation, outputIndex, partialSigningKeys, realOutput, k, result);
+    };
 }
 
-void generatePartialSigningKey(const Nan::FunctionCallbackInfo<v8::Value> &info)
+CryptoJob<std::string> generatePartialSigningKeyJob(const Nan::FunctionCallbackInfo<v8::Value> &info)
 {
-    /* Setup our return object */
-    v8::Local<v8::Value> functionReturnValue = Nan::New(false);
-
-    bool functionSuccess = false;
-
     std::string signature = getString(info, 0);
 
     std::string privateSpendKey = getString(info, 1);
 
-    if (!signature.empty() && !privateSpendKey.empty())
-    {
-        try
-        {
-            std::string result = Core::Cryptography::generatePartialSigningKey(signature, privateSpendKey);
-
-            functionReturnValue = Nan::New(result).ToLocalChecked();
-
-            functionSuccess = true;
-        }
-        catch (const std::exception &)
+    return [signature, privateSpendKey](std::string &result) {
+        if (signature.empty() || privateSpendKey.empty())
         {
-            functionSuccess = false;
+            return false;
         }
-    }
 
-    info.GetReturnValue().Set(prepareResult(functionSuccess, functionReturnValue));
+        result = Core::Cryptography::generatePartialSigningKey(signature, privateSpendKey);
+
+        return true;
+    };
 }
 
-void restoreKeyImage(const Nan::FunctionCallbackInfo<v8::Value> &info)
+CryptoJob<std::string> restoreKeyImageJob(const Nan::FunctionCallbackInfo<v8::Value> &info)
 {
-    /* Setup our return object */
-    v8::Local<v8::Value> functionReturnValue = Nan::New(false);
-
-    bool functionSuccess = false;
-
     std::string publicEphemeral = getString(info, 0);
 
     std::string derivation = getString(info, 1);
@@ -384,55 +389,40 @@ void restoreKeyImage(const Nan::FunctionCallbackInfo<v8::Value> &info)
 
     std::vector<std::string> partialKeyImages = toStringVector(info, 3);
 
-    if (!publicEphemeral.empty() && !derivation.empty() && partialKeyImages.size() != 0)
-    {
-        try
-        {
-            std::string result =
-                Core::Cryptography::restoreKeyImage(publicEphemeral, derivation, outputIndex, partialKeyImages);
-
-            functionReturnValue = Nan::New(result).ToLocalChecked();
-
-            functionSuccess = true;
-        }
-        catch (const std::exception &)
+    return [publicEphemeral, derivation, outputIndex, partialKeyImages](std::string &result) {
+        if (publicEphemeral.empty() || derivation.empty() || partialKeyImages.size() == 0)
         {
-            functionSuccess = false;
+            return false;
         }
-    }
 
-    info.GetReturnValue().Set(prepareResult(functionSuccess, functionReturnValue));
+        result = Core::Cryptography::restoreKeyImage(publicEphemeral, derivation, outputIndex, partialKeyImages);
+
+        return true;
+    };
 }
 
-void checkKey(const Nan::FunctionCallbackInfo<v8::Value> &info)
+/* A check job always succeeds, as bad input simply fails the check. It catches
+   its own exceptions so that the asynchronous export does not report them */
+CryptoJob<bool> checkKeyJob(const Nan::FunctionCallbackInfo<v8::Value> &info)
 {
-    /* Setup our return object */
-    v8::Local<v8::Value> functionReturnValue = Nan::New(false);
-
     std::string publicKey = getString(info, 0);
 
-    if (!publicKey.empty())
-    {
+    return [publicKey](bool &result) {
         try
         {
-            bool success = Core::Cryptography::checkKey(publicKey);
-
-            functionReturnValue = Nan::New(success);
+            result = !publicKey.empty() && Core::Cryptography::checkKey(publicKey);
         }
         catch (const std::exception &)
         {
-            functionReturnValue = Nan::New(false);
+            result = false;
         }
-    }
 
-    info.GetReturnValue().Set(functionReturnValue);
+        return true;
+    };
 }
 
-void checkRingSignature(const Nan::FunctionCallbackInfo<v8::Value> &info)
+CryptoJob<bool> checkRingSignatureJob(const Nan::FunctionCallbackInfo<v8::Value> &info)
 {
-    /* Setup our return object */
-    v8::Local<v8::Value> functionReturnValue = Nan::New(false);
-
     std::string prefixHash = getString(info, 0);
 
     std::string keyImage = getString(info, 1);
@@ -441,1509 +431,1477 @@ void checkRingSignature(const Nan::FunctionCallbackInfo<v8::Value> &info)
 
     std::vector<std::string> signatures = toStringVector(info, 3);
 
-    if (!prefixHash.empty() && !keyImage.empty() && publicKeys.size() != 0 && signatures.size() != 0)
-    {
+    return [prefixHash, keyImage, publicKeys, signatures](bool &result) {
         try
         {
-            bool success = Core::Cryptography::checkRingSignature(prefixHash, keyImage, publicKeys, signatures);
-
-            functionReturnValue = Nan::New(success);
+            result = !prefixHash.empty() && !keyImage.empty() && publicKeys.size() != 0 && signatures.size() != 0
+                     && Core::Cryptography::checkRingSignature(prefixHash, keyImage, publicKeys, signatures);
         }
         catch (const std::exception &)
         {
-            functionReturnValue = Nan::New(false);
+            result = false;
         }
-    }
 
-    info.GetReturnValue().Set(functionReturnValue);
+        return true;
+    };
 }
 
-void checkSignature(const Nan::FunctionCallbackInfo<v8::Value> &info)
+CryptoJob<bool> checkSignatureJob(const Nan::FunctionCallbackInfo<v8::Value> &info)
 {
-    /* Setup our return object */
-    v8::Local<v8::Value> functionReturnValue = Nan::New(false);
     std::string prefixHash = getString(info, 0);
 
     std::string publicKey = getString(info, 1);
 
     std::string signature = getString(info, 2);
 
-    if (!prefixHash.empty() && !publicKey.empty() && !signature.empty())
-    {
+    return [prefixHash, publicKey, signature](bool &result) {
         try
         {
-            bool success = Core::Cryptography::checkSignature(prefixHash, publicKey, signature);
-
-            functionReturnValue = Nan::New(success);
+            result = !prefixHash.empty() && !publicKey.empty() && !signature.empty()
+                     && Core::Cryptography::checkSignature(prefixHash, publicKey, signature);
         }
         catch (const std::exception &)
         {
-            functionReturnValue = Nan::New(false);
+            result = false;
         }
-    }
 
-    info.GetReturnValue().Set(functionReturnValue);
+        return true;
+    };
 }
 
-void derivePublicKey(const Nan::FunctionCallbackInfo<v8::Value> &info)
+CryptoJob<std::string> derivePublicKeyJob(const Nan::FunctionCallbackInfo<v8::Value> &info)
 {
-    /* Setup our return object */
-    v8::Local<v8::Value> functionReturnValue = Nan::New("").ToLocalChecked();
-
-    bool functionSuccess = false;
-
     std::string derivation = getString(info, 0);
 
     size_t outputIndex = (size_t)getUInt32(info, 1);
 
     std::string publicKey = getString(info, 2);
 
-    if (!derivation.empty() && !publicKey.empty())
-    {
-        try
-        {
-            std::string outPublicKey = std::string();
-
-            bool success = Core::Cryptography::derivePublicKey(derivation, outputIndex, publicKey, outPublicKey);
-
-            if (success)
-            {
-                functionReturnValue = Nan::New(outPublicKey).ToLocalChecked();
-
-                functionSuccess = success;
-            }
-        }
-        catch (const std::exception &)
+    return [derivation, outputIndex, publicKey](std::string &outPublicKey) {
+        if (derivation.empty() || publicKey.empty())
         {
-            functionSuccess = false;
+            return false;
         }
-    }
 
-    info.GetReturnValue().Set(prepareResult(functionSuccess, functionReturnValue));
+        return Core::Cryptography::derivePublicKey(derivation, outputIndex, publicKey, outPublicKey);
+    };
 }
 
-void deriveSecretKey(const Nan::FunctionCallbackInfo<v8::Value> &info)
+CryptoJob<std::string> deriveSecretKeyJob(const Nan::FunctionCallbackInfo<v8::Value> &info)
 {
-    /* Setup our return object */
-    v8::Local<v8::Value> functionReturnValue = Nan::New("").ToLocalChecked();
-
-    bool functionSuccess = false;
-
     std::string derivation = getString(info, 0);
 
     size_t outputIndex = (size_t)getUInt32(info, 1);
 
     std::string secretKey = getString(info, 2);
 
-    if (!derivation.empty() && !secretKey.empty())
-    {
-        try
-        {
-            std::string _secretKey = Core::Cryptography::deriveSecretKey(derivation, outputIndex, secretKey);
-
-            if (!_secretKey.empty())
-            {
-                functionReturnValue = Nan::New(_secretKey).ToLocalChecked();
-
-                functionSuccess = true;
-            }
-        }
-        catch (const std::exception &)
+    return [derivation, outputIndex, secretKey](std::string &result) {
+        if (derivation.empty() || secretKey.empty())
         {
-            functionSuccess = false;
+            return false;
         }
-    }
 
-    info.GetReturnValue().Set(prepareResult(functionSuccess, functionReturnValue));
+        result = Core::Cryptography::deriveSecretKey(derivation, outputIndex, secretKey);
+
+        return !result.empty();
+    };
 }
 
-void generateKeys(const Nan::FunctionCallbackInfo<v8::Value> &info)
+CryptoJob<KeyPairResult> generateKeysJob(const Nan::FunctionCallbackInfo<v8::Value> &)
 {
-    v8::Local<v8::Object> jsonObject = Nan::New<v8::Object>();
+    return [](KeyPairResult &result) {
+        Core::Cryptography::generateKeys(result.secretKey, result.publicKey);
 
-    bool functionSuccess = false;
+        return true;
+    };
+}
 
-    try
-    {
-        std::string secretKey;
-
-        std::string publicKey;
+CryptoJob<std::string> generateKeyDerivationJob(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    std::string publicKey = getString(info, 0);
 
-        Core::Cryptography::generateKeys(secretKey, publicKey);
+    std::string secretKey = getString(info, 1);
 
-        v8::Local<v8::String> publicKeyProp = Nan::New("publicKey").ToLocalChecked();
+    return [publicKey, secretKey](std::string &derivation) {
+        if (secretKey.empty() || publicKey.empty())
+        {
+            return false;
+        }
 
-        v8::Local<v8::String> secretKeyProp = Nan::New("secretKey").ToLocalChecked();
+        return Core::Cryptography::generateKeyDerivation(publicKey, secretKey, derivation);
+    };
+}
 
-        v8::Local<v8::Value> publicKeyValue = Nan::New(publicKey).ToLocalChecked();
+CryptoJob<std::string> generateKeyDerivationScalarJob(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    std::string publicKey = getString(info, 0);
 
-        v8::Local<v8::Value> secretKeyValue = Nan::New(secretKey).ToLocalChecked();
+    std::string secretKey = getString(info, 1);
 
-        Nan::Set(jsonObject, publicKeyProp, publicKeyValue);
+    uint64_t outputIndex = getUInt64(info, 2);
 
-        Nan::Set(jsonObject, secretKeyProp, secretKeyValue);
+    return [publicKey, secretKey, outputIndex](std::string &derivationScalar) {
+        if (secretKey.empty() || publicKey.empty())
+        {
+            return false;
+        }
 
-        functionSuccess = true;
-    }
-    catch (const std::exception &)
-    {
-        functionSuccess = false;
-    }
+        derivationScalar = Core::Cryptography::generateKeyDerivationScalar(publicKey, secretKey, outputIndex);
 
-    info.GetReturnValue().Set(prepareResult(functionSuccess, jsonObject));
+        return true;
+    };
 }
 
-void generateKeyDerivation(const Nan::FunctionCallbackInfo<v8::Value> &info)
+CryptoJob<std::string> derivationToScalarJob(const Nan::FunctionCallbackInfo<v8::Value> &info)
 {
-    /* Setup our return object */
-    v8::Local<v8::Value> functionReturnValue = Nan::New("").ToLocalChecked();
+    std::string derivation = getString(info, 0);
 
-    bool functionSuccess = false;
+    uint64_t outputIndex = getUInt64(info, 1);
+
+    return [derivation, outputIndex](std::string &derivationScalar) {
+        if (derivation.empty())
+        {
+            return false;
+        }
+
+        derivationScalar = Core::Cryptography::derivationToScalar(derivation, outputIndex);
+
+        return true;
+    };
+}
 
+CryptoJob<std::string> generateKeyImageJob(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
     std::string publicKey = getString(info, 0);
 
     std::string secretKey = getString(info, 1);
 
-    if (!secretKey.empty() && !publicKey.empty())
-    {
-        try
+    return [publicKey, secretKey](std::string &keyImage) {
+        if (publicKey.empty() || secretKey.empty())
         {
-            std::string derivation;
+            return false;
+        }
 
-            bool success = Core::Cryptography::generateKeyDerivation(publicKey, secretKey, derivation);
+        keyImage = Core::Cryptography::generateKeyImage(publicKey, secretKey);
 
-            if (success)
-            {
-                functionReturnValue = Nan::New(derivation).ToLocalChecked();
+        return true;
+    };
+}
 
-                functionSuccess = true;
-            }
-        }
-        catch (const std::exception &)
+CryptoJob<std::string> generatePrivateViewKeyFromPrivateSpendKeyJob(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    std::string secretKey = getString(info, 0);
+
+    return [secretKey](std::string &privateViewKey) {
+        if (secretKey.empty())
         {
-            functionSuccess = false;
+            return false;
         }
-    }
 
-    info.GetReturnValue().Set(prepareResult(functionSuccess, functionReturnValue));
+        privateViewKey = Core::Cryptography::generatePrivateViewKeyFromPrivateSpendKey(secretKey);
+
+        return true;
+    };
 }
 
-void generateKeyDerivationScalar(const Nan::FunctionCallbackInfo<v8::Value> &info)
+CryptoJob<KeyPairResult> generateDeterministicSubwalletKeysJob(const Nan::FunctionCallbackInfo<v8::Value> &info)
 {
-    /* Setup our return object */
-    v8::Local<v8::Value> functionReturnValue = Nan::New("").ToLocalChecked();
-
-    bool functionSuccess = false;
-
-    std::string publicKey = getString(info, 0);
+    std::string secretKey = getString(info, 0);
 
-    std::string secretKey = getString(info, 1);
+    /* The wallet index is required, as 0 is the primary wallet */
+    const bool haveWalletIndex = info[1]->IsNumber();
 
-    uint64_t outputIndex = getUInt64(info, 2);
+    size_t walletIndex = (size_t)getUInt32(info, 1);
 
-    if (!secretKey.empty() && !publicKey.empty())
-    {
-        try
+    return [secretKey, haveWalletIndex, walletIndex](KeyPairResult &result) {
+        if (secretKey.empty() || !haveWalletIndex)
         {
-            std::string derivationScalar =
-                Core::Cryptography::generateKeyDerivationScalar(publicKey, secretKey, outputIndex);
+            return false;
+        }
 
-            functionReturnValue = Nan::New(derivationScalar).ToLocalChecked();
+        return Core::Cryptography::generateDeterministicSubwalletKeys(
+            secretKey, walletIndex, result.secretKey, result.publicKey);
+    };
+}
 
-            functionSuccess = true;
-        }
-        catch (const std::exception &)
+CryptoJob<KeyPairResult> generateViewKeysFromPrivateSpendKeyJob(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    std::string secretKey = getString(info, 0);
+
+    return [secretKey](KeyPairResult &result) {
+        if (secretKey.empty())
         {
-            functionSuccess = false;
+            return false;
         }
-    }
 
-    info.GetReturnValue().Set(prepareResult(functionSuccess, functionReturnValue));
+        Core::Cryptography::generateViewKeysFromPrivateSpendKey(secretKey, result.secretKey, result.publicKey);
+
+        return true;
+    };
 }
 
-void derivationToScalar(const Nan::FunctionCallbackInfo<v8::Value> &info)
+CryptoJob<std::vector<std::string>> generateRingSignaturesJob(const Nan::FunctionCallbackInfo<v8::Value> &info)
 {
-    /* Setup our return object */
-    v8::Local<v8::Value> functionReturnValue = Nan::New("").ToLocalChecked();
-
-    bool functionSuccess = false;
+    std::string prefixHash = getString(info, 0);
 
-    std::string derivation = getString(info, 0);
+    std::string keyImage = getString(info, 1);
 
-    uint64_t outputIndex = getUInt64(info, 1);
+    std::vector<std::string> publicKeys = toStringVector(info, 2);
 
-    if (!derivation.empty())
-    {
-        try
-        {
-            std::string derivationScalar = Core::Cryptography::derivationToScalar(derivation, outputIndex);
+    std::string transactionSecretKey = getString(info, 3);
 
-            functionReturnValue = Nan::New(derivationScalar).ToLocalChecked();
+    uint64_t realOutput = getUInt64(info, 4);
 
-            functionSuccess = true;
-        }
-        catch (const std::exception &)
+    return [prefixHash, keyImage, publicKeys, transactionSecretKey, realOutput](
+               std::vector<std::string> &signatures) {
+        if (prefixHash.empty() || keyImage.empty() || transactionSecretKey.empty() || publicKeys.size() == 0)
         {
-            functionSuccess = false;
+            return false;
         }
-    }
 
-    info.GetReturnValue().Set(prepareResult(functionSuccess, functionReturnValue));
+        return Core::Cryptography::generateRingSignatures(
+            prefixHash, keyImage, publicKeys, transactionSecretKey, realOutput, signatures);
+    };
 }
 
-void generateKeyImage(const Nan::FunctionCallbackInfo<v8::Value> &info)
+CryptoJob<std::string> generateSignatureJob(const Nan::FunctionCallbackInfo<v8::Value> &info)
 {
-    /* Setup our return object */
-    v8::Local<v8::Value> functionReturnValue = Nan::New("").ToLocalChecked();
+    std::string prefixHash = getString(info, 0);
 
-    bool functionSuccess = false;
+    std::string publicKey = getString(info, 1);
 
-    std::string publicKey = getString(info, 0);
+    std::string secretKey = getString(info, 2);
 
-    std::string secretKey = getString(info, 1);
+    return [prefixHash, publicKey, secretKey](std::string &signature) {
+        if (prefixHash.empty() || publicKey.empty() || secretKey.empty())
+        {
+            return false;
+        }
 
-    if (!publicKey.empty() && !secretKey.empty())
-    {
-        std::string keyImage;
+        signature = Core::Cryptography::generateSignature(prefixHash, publicKey, secretKey);
 
-        try
-        {
-            keyImage = Core::Cryptography::generateKeyImage(publicKey, secretKey);
+        return true;
+    };
+}
 
-            functionReturnValue = Nan::New(keyImage).ToLocalChecked();
+CryptoJob<std::string> hashToEllipticCurveJob(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    std::string hash = getString(info, 0);
 
-            functionSuccess = true;
-        }
-        catch (const std::exception &)
+    return [hash](std::string &result) {
+        if (hash.empty())
         {
-            functionSuccess = false;
+            return false;
         }
-    }
 
-    info.GetReturnValue().Set(prepareResult(functionSuccess, functionReturnValue));
+        result = Core::Cryptography::hashToEllipticCurve(hash);
+
+        return true;
+    };
 }
 
-void generatePrivateViewKeyFromPrivateSpendKey(const Nan::FunctionCallbackInfo<v8::Value> &info)
+CryptoJob<std::string> hashToScalarJob(const Nan::FunctionCallbackInfo<v8::Value> &info)
 {
-    /* Setup our return object */
-    v8::Local<v8::Value> functionReturnValue = Nan::New("").ToLocalChecked();
+    std::string data = getString(info, 0);
 
-    bool functionSuccess = false;
+    return [data](std::string &result) {
+        if (data.empty())
+        {
+            return false;
+        }
 
-    std::string secretKey = getString(info, 0);
+        result = Core::Cryptography::hashToScalar(data);
 
-    if (!secretKey.empty())
-    {
-        try
-        {
-            std::string privateViewKey = Core::Cryptography::generatePrivateViewKeyFromPrivateSpendKey(secretKey);
+        return true;
+    };
+}
 
-            functionReturnValue = Nan::New(privateViewKey).ToLocalChecked();
+CryptoJob<std::string> scalarDerivePublicKeyJob(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    std::string derivation = getString(info, 0);
 
-            functionSuccess = true;
-        }
-        catch (const std::exception &)
+    std::string publicKey = getString(info, 1);
+
+    return [derivation, publicKey](std::string &outPublicKey) {
+        if (derivation.empty() || publicKey.empty())
         {
-            functionSuccess = false;
+            return false;
         }
-    }
 
-    info.GetReturnValue().Set(prepareResult(functionSuccess, functionReturnValue));
+        return Core::Cryptography::derivePublicKey(derivation, publicKey, outPublicKey);
+    };
 }
 
-void generateDeterministicSubwalletKeys(const Nan::FunctionCallbackInfo<v8::Value> &info)
+CryptoJob<std::string> scalarDeriveSecretKeyJob(const Nan::FunctionCallbackInfo<v8::Value> &info)
 {
-    /* Setup our return object */
-    v8::Local<v8::Object> jsonObject = Nan::New<v8::Object>();
-
-    bool functionSuccess = false;
-
-    if (info.Length() == 2)
-    {
-        std::string secretKey = getString(info, 0);
+    std::string derivation = getString(info, 0);
 
-        size_t walletIndex = (size_t)getUInt32(info, 1);
+    std::string secretKey = getString(info, 1);
 
-        if (!secretKey.empty())
+    return [derivation, secretKey](std::string &result) {
+        if (derivation.empty() || secretKey.empty())
         {
-            std::string newSecretKey = std::string();
-
-            std::string newPublicKey = std::string();
-
-            try
-            {
-                functionSuccess = Core::Cryptography::generateDeterministicSubwalletKeys(
-                    secretKey, walletIndex, newSecretKey, newPublicKey);
-
-                v8::Local<v8::String> publicKeyProp = Nan::New("publicKey").ToLocalChecked();
+            return false;
+        }
 
-                v8::Local<v8::String> secretKeyProp = Nan::New("secretKey").ToLocalChecked();
+        result = Core::Cryptography::deriveSecretKey(derivation, secretKey);
 
-                v8::Local<v8::Value> publicKeyValue = Nan::New(newPublicKey).ToLocalChecked();
+        return !result.empty();
+    };
+}
 
-                v8::Local<v8::Value> secretKeyValue = Nan::New(newSecretKey).ToLocalChecked();
+CryptoJob<std::string> scalarmultKeyJob(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    std::string keyImageA = getString(info, 0);
 
-                Nan::Set(jsonObject, publicKeyProp, publicKeyValue);
+    std::string keyImageB = getString(info, 1);
 
-                Nan::Set(jsonObject, secretKeyProp, secretKeyValue);
-            }
-            catch (const std::exception &)
-            {
-                functionSuccess = false;
-            }
+    return [keyImageA, keyImageB](std::string &keyImageC) {
+        if (keyImageA.empty() || keyImageB.empty())
+        {
+            return false;
         }
-    }
 
-    info.GetReturnValue().Set(prepareResult(functionSuccess, jsonObject));
+        keyImageC = Core::Cryptography::scalarmultKey(keyImageA, keyImageB);
+
+        return true;
+    };
 }
 
-void generateViewKeysFromPrivateSpendKey(const Nan::FunctionCallbackInfo<v8::Value> &info)
+CryptoJob<std::string> scReduce32Job(const Nan::FunctionCallbackInfo<v8::Value> &info)
 {
-    /* Setup our return object */
-    v8::Local<v8::Object> jsonObject = Nan::New<v8::Object>();
+    std::string data = getString(info, 0);
 
-    v8::Local<v8::String> publicKeyProp = Nan::New("publicKey").ToLocalChecked();
+    return [data](std::string &scalar) {
+        if (data.empty())
+        {
+            return false;
+        }
 
-    v8::Local<v8::String> secretKeyProp = Nan::New("secretKey").ToLocalChecked();
+        scalar = Core::Cryptography::scReduce32(data);
 
-    bool functionSuccess = false;
+        return true;
+    };
+}
 
+CryptoJob<std::string> secretKeyToPublicKeyJob(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
     std::string secretKey = getString(info, 0);
 
-    if (!secretKey.empty())
-    {
-        try
+    return [secretKey](std::string &publicKey) {
+        if (secretKey.empty())
         {
-            std::string privateViewKey;
+            return false;
+        }
 
-            std::string publicViewKey;
+        return Core::Cryptography::secretKeyToPublicKey(secretKey, publicKey);
+    };
+}
 
-            Core::Cryptography::generateViewKeysFromPrivateSpendKey(secretKey, privateViewKey, publicViewKey);
+CryptoJob<uint32_t> tree_depth_job(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    const bool haveCount = info[0]->IsNumber();
 
-            v8::Local<v8::Value> publicKeyValue = Nan::New(publicViewKey).ToLocalChecked();
+    uint32_t count = getUInt32(info, 0);
 
-            v8::Local<v8::Value> secretKeyValue = Nan::New(privateViewKey).ToLocalChecked();
+    return [haveCount, count](uint32_t &depth) {
+        if (!haveCount)
+        {
+            return false;
+        }
 
-            Nan::Set(jsonObject, publicKeyProp, publicKeyValue);
+        depth = Core::Cryptography::tree_depth(count);
 
-            Nan::Set(jsonObject, secretKeyProp, secretKeyValue);
+        return true;
+    };
+}
 
-            functionSuccess = true;
-        }
-        catch (const std::exception &)
+CryptoJob<std::string> tree_hash_job(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    std::vector<std::string> hashes = toStringVector(info, 0);
+
+    return [hashes](std::string &hash) {
+        if (hashes.size() == 0)
         {
-            functionSuccess = false;
+            return false;
         }
-    }
 
-    info.GetReturnValue().Set(prepareResult(functionSuccess, jsonObject));
+        hash = Core::Cryptography::tree_hash(hashes);
+
+        return true;
+    };
 }
 
-void generateRingSignatures(const Nan::FunctionCallbackInfo<v8::Value> &info)
+CryptoJob<std::vector<std::string>> tree_branch_job(const Nan::FunctionCallbackInfo<v8::Value> &info)
 {
-    /* Setup our return object */
-    v8::Local<v8::Value> functionReturnValue = Nan::New("").ToLocalChecked();
+    std::vector<std::string> hashes = toStringVector(info, 0);
 
-    bool functionSuccess = false;
+    return [hashes](std::vector<std::string> &branches) {
+        if (hashes.size() == 0)
+        {
+            return false;
+        }
 
-    std::string prefixHash = getString(info, 0);
+        branches = Core::Cryptography::tree_branch(hashes);
 
-    std::string keyImage = getString(info, 1);
+        return true;
+    };
+}
 
-    std::vector<std::string> publicKeys = toStringVector(info, 2);
+CryptoJob<std::string> tree_hash_from_branch_job(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    std::vector<std::string> branches = toStringVector(info, 0);
 
-    std::string transactionSecretKey = getString(info, 3);
+    std::string leaf = getString(info, 1);
 
-    uint64_t realOutput = getUInt64(info, 4);
+    std::string path = getString(info, 2);
 
-    if (!prefixHash.empty() && !keyImage.empty() && !transactionSecretKey.empty() && publicKeys.size() != 0)
+    if (info[2]->IsNumber())
     {
-        try
-        {
-            std::vector<std::string> signatures;
-
-            bool success = Core::Cryptography::generateRingSignatures(
-                prefixHash, keyImage, publicKeys, transactionSecretKey, realOutput, signatures);
-
-            if (success)
-            {
-                functionReturnValue = toV8Array(signatures);
+        path = std::to_string((size_t)getUInt32(info, 2));
+    }
 
-                functionSuccess = true;
-            }
-        }
-        catch (const std::exception &)
+    return [branches, leaf, path](std::string &hash) {
+        if (leaf.empty() || path.empty())
         {
-            functionSuccess = false;
+            return false;
         }
-    }
 
-    info.GetReturnValue().Set(prepareResult(functionSuccess, functionReturnValue));
+        hash = Core::Cryptography::tree_hash_from_branch(branches, leaf, path);
+
+        return true;
+    };
 }
 
-void generateSignature(const Nan::FunctionCallbackInfo<v8::Value> &info)
+CryptoJob<std::string> underivePublicKeyJob(const Nan::FunctionCallbackInfo<v8::Value> &info)
 {
-    /* Setup our return object */
-    v8::Local<v8::Value> functionReturnValue = Nan::New("").ToLocalChecked();
-
-    bool functionSuccess = false;
+    std::string derivation = getString(info, 0);
 
-    std::string prefixHash = getString(info, 0);
+    size_t outputIndex = (size_t)getUInt32(info, 1);
 
-    std::string publicKey = getString(info, 1);
+    std::string derivedKey = getString(info, 2);
 
-    std::string secretKey = getString(info, 2);
+    return [derivation, outputIndex, derivedKey](std::string &publicKey) {
+        if (derivation.empty() || derivedKey.empty())
+        {
+            return false;
+        }
 
-    if (!prefixHash.empty() && !publicKey.empty() && !secretKey.empty())
-    {
-        std::string signature;
+        return Core::Cryptography::underivePublicKey(derivation, outputIndex, derivedKey, publicKey);
+    };
+}
 
-        try
-        {
-            signature = Core::Cryptography::generateSignature(prefixHash, publicKey, secretKey);
+/*
+ *
+ * Hashing Operations
+ *
+ */
 
-            functionReturnValue = Nan::New(signature).ToLocalChecked();
+/* cn_fast_hash and every slow hash variant that only takes the data to hash */
+template<std::string (*HashFunction)(const std::string)>
+CryptoJob<std::string> hashJob(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    std::string data = getString(info, 0);
 
-            functionSuccess = true;
-        }
-        catch (const std::exception &)
+    return [data](std::string &hash) {
+        if (data.empty())
         {
-            functionSuccess = false;
+            return false;
         }
-    }
 
-    info.GetReturnValue().Set(prepareResult(functionSuccess, functionReturnValue));
+        hash = HashFunction(data);
+
+        return true;
+    };
 }
 
-void hashToEllipticCurve(const Nan::FunctionCallbackInfo<v8::Value> &info)
+CryptoJob<std::string> chukwa_slow_hash_base_job(const Nan::FunctionCallbackInfo<v8::Value> &info)
 {
-    /* Setup our return object */
-    v8::Local<v8::Value> functionReturnValue = Nan::New("").ToLocalChecked();
+    std::string data = getString(info, 0);
 
-    bool functionSuccess = false;
+    uint32_t iterations = getUInt32(info, 1);
 
-    std::string hash = getString(info, 0);
+    uint32_t memory = getUInt32(info, 2);
 
-    if (!hash.empty())
-    {
-        try
-        {
-            std::string _ec = Core::Cryptography::hashToEllipticCurve(hash);
+    uint32_t threads = getUInt32(info, 3);
 
-            functionReturnValue = Nan::New(_ec).ToLocalChecked();
-
-            functionSuccess = true;
-        }
-        catch (const std::exception &)
+    return [data, iterations, memory, threads](std::string &hash) {
+        if (data.empty() || iterations == 0 || memory == 0 || threads == 0)
         {
-            functionSuccess = false;
+            return false;
         }
-    }
-
-    info.GetReturnValue().Set(prepareResult(functionSuccess, functionReturnValue));
-}
-
-void hashToScalar(const Nan::FunctionCallbackInfo<v8::Value> &info)
-{
-    /* Setup our return object */
-    v8::Local<v8::Value> functionReturnValue = Nan::New("").ToLocalChecked();
 
-    bool functionSuccess = false;
+        hash = Core::Cryptography::chukwa_slow_hash_base(data, iterations, memory, threads);
 
-    std::string data = getString(info, 0);
+        return true;
+    };
+}
 
-    if (!data.empty())
-    {
-        try
-        {
-            std::string _scalar = Core::Cryptography::hashToScalar(data);
+/*
+ *
+ * Synchronous Operations
+ *
+ */
 
-            functionReturnValue = Nan::New(_scalar).ToLocalChecked();
+void calculateMultisigPrivateKeys(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    runJob(info, calculateMultisigPrivateKeysJob(info));
+}
 
-            functionSuccess = true;
-        }
-        catch (const std::exception &)
-        {
-            functionSuccess = false;
-        }
-    }
+void calculateSharedPrivateKey(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    runJob(info, calculateSharedPrivateKeyJob(info));
+}
 
-    info.GetReturnValue().Set(prepareResult(functionSuccess, functionReturnValue));
+void calculateSharedPublicKey(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    runJob(info, calculateSharedPublicKeyJob(info));
 }
 
-void scalarDerivePublicKey(const Nan::FunctionCallbackInfo<v8::Value> &info)
+void prepareRingSignatures(const Nan::FunctionCallbackInfo<v8::Value> &info)
 {
-    /* Setup our return object */
-    v8::Local<v8::Value> functionReturnValue = Nan::New("").ToLocalChecked();
+    runJob(info, prepareRingSignaturesJob(info));
+}
 
-    bool functionSuccess = false;
+void completeRingSignatures(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    runJob(info, completeRingSignaturesJob(info));
+}
 
-    std::string derivation = getString(info, 0);
+void restoreRingSignatures(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    runJob(info, restoreRingSignaturesJob(info));
+}
 
-    std::string publicKey = getString(info, 1);
+void generatePartialSigningKey(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    runJob(info, generatePartialSigningKeyJob(info));
+}
 
-    if (!derivation.empty() && !publicKey.empty())
-    {
-        try
-        {
-            std::string outPublicKey = std::string();
+void restoreKeyImage(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    runJob(info, restoreKeyImageJob(info));
+}
 
-            bool success = Core::Cryptography::derivePublicKey(derivation, publicKey, outPublicKey);
+void checkKey(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    runCheck(info, checkKeyJob(info));
+}
 
-            if (success)
-            {
-                functionReturnValue = Nan::New(outPublicKey).ToLocalChecked();
+void checkRingSignature(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    runCheck(info, checkRingSignatureJob(info));
+}
 
-                functionSuccess = success;
-            }
-        }
-        catch (const std::exception &)
-        {
-            functionSuccess = false;
-        }
-    }
+void checkSignature(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    runCheck(info, checkSignatureJob(info));
+}
 
-    info.GetReturnValue().Set(prepareResult(functionSuccess, functionReturnValue));
+void derivePublicKey(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    runJob(info, derivePublicKeyJob(info));
 }
 
-void scalarDeriveSecretKey(const Nan::FunctionCallbackInfo<v8::Value> &info)
+void deriveSecretKey(const Nan::FunctionCallbackInfo<v8::Value> &info)
 {
-    /* Setup our return object */
-    v8::Local<v8::Value> functionReturnValue = Nan::New("").ToLocalChecked();
+    runJob(info, deriveSecretKeyJob(info));
+}
 
-    bool functionSuccess = false;
+void generateKeys(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    runJob(info, generateKeysJob(info));
+}
 
-    std::string derivation = getString(info, 0);
+void generateKeyDerivation(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    runJob(info, generateKeyDerivationJob(info));
+}
 
-    std::string secretKey = getString(info, 1);
+void generateKeyDerivationScalar(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    runJob(info, generateKeyDerivationScalarJob(info));
+}
 
-    if (!derivation.empty() && !secretKey.empty())
-    {
-        try
-        {
-            std::string _secretKey = Core::Cryptography::deriveSecretKey(derivation, secretKey);
+void derivationToScalar(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    runJob(info, derivationToScalarJob(info));
+}
 
-            if (!_secretKey.empty())
-            {
-                functionReturnValue = Nan::New(_secretKey).ToLocalChecked();
+void generateKeyImage(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    runJob(info, generateKeyImageJob(info));
+}
 
-                functionSuccess = true;
-            }
-        }
-        catch (const std::exception &)
-        {
-            functionSuccess = false;
-        }
-    }
+void generatePrivateViewKeyFromPrivateSpendKey(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    runJob(info, generatePrivateViewKeyFromPrivateSpendKeyJob(info));
+}
 
-    info.GetReturnValue().Set(prepareResult(functionSuccess, functionReturnValue));
+void generateDeterministicSubwalletKeys(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    runJob(info, generateDeterministicSubwalletKeysJob(info));
 }
 
-void scalarmultKey(const Nan::FunctionCallbackInfo<v8::Value> &info)
+void generateViewKeysFromPrivateSpendKey(const Nan::FunctionCallbackInfo<v8::Value> &info)
 {
-    /* Setup our return object */
-    v8::Local<v8::Value> functionReturnValue = Nan::New("").ToLocalChecked();
+    runJob(info, generateViewKeysFromPrivateSpendKeyJob(info));
+}
 
-    bool functionSuccess = false;
+void generateRingSignatures(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    runJob(info, generateRingSignaturesJob(info));
+}
 
-    std::string keyImageA = getString(info, 0);
+void generateSignature(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    runJob(info, generateSignatureJob(info));
+}
 
-    std::string keyImageB = getString(info, 1);
+void hashToEllipticCurve(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    runJob(info, hashToEllipticCurveJob(info));
+}
 
-    if (!keyImageA.empty() && !keyImageB.empty())
-    {
-        try
-        {
-            std::string keyImageC = Core::Cryptography::scalarmultKey(keyImageA, keyImageB);
+void hashToScalar(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    runJob(info, hashToScalarJob(info));
+}
 
-            functionReturnValue = Nan::New(keyImageC).ToLocalChecked();
+void scalarDerivePublicKey(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    runJob(info, scalarDerivePublicKeyJob(info));
+}
 
-            functionSuccess = true;
-        }
-        catch (const std::exception &)
-        {
-            functionSuccess = false;
-        }
-    }
+void scalarDeriveSecretKey(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    runJob(info, scalarDeriveSecretKeyJob(info));
+}
 
-    info.GetReturnValue().Set(prepareResult(functionSuccess, functionReturnValue));
+void scalarmultKey(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    runJob(info, scalarmultKeyJob(info));
 }
 
 void scReduce32(const Nan::FunctionCallbackInfo<v8::Value> &info)
 {
-    /* Setup our return object */
-    v8::Local<v8::Value> functionReturnValue = Nan::New("").ToLocalChecked();
-
-    bool functionSuccess = false;
-
-    std::string data = getString(info, 0);
-
-    if (!data.empty())
-    {
-        try
-        {
-            std::string scalar = Core::Cryptography::scReduce32(data);
-
-            functionReturnValue = Nan::New(scalar).ToLocalChecked();
-
-            functionSuccess = true;
-        }
-        catch (const std::exception &)
-        {
-            functionSuccess = false;
-        }
-    }
-
-    info.GetReturnValue().Set(prepareResult(functionSuccess, functionReturnValue));
+    runJob(info, scReduce32Job(info));
 }
 
 void secretKeyToPublicKey(const Nan::FunctionCallbackInfo<v8::Value> &info)
 {
-    /* Setup our return object */
-    v8::Local<v8::Value> functionReturnValue = Nan::New("").ToLocalChecked();
-
-    bool functionSuccess = false;
-
-    std::string secretKey = getString(info, 0);
-
-    if (!secretKey.empty())
-    {
-        try
-        {
-            std::string publicKey;
-
-            bool success = Core::Cryptography::secretKeyToPublicKey(secretKey, publicKey);
-
-            if (success)
-            {
-                functionReturnValue = Nan::New(publicKey).ToLocalChecked();
-
-                functionSuccess = true;
-            }
-        }
-        catch (const std::exception &)
-        {
-            functionSuccess = false;
-        }
-    }
-
-    info.GetReturnValue().Set(prepareResult(functionSuccess, functionReturnValue));
+    runJob(info, secretKeyToPublicKeyJob(info));
 }
 
 void tree_depth(const Nan::FunctionCallbackInfo<v8::Value> &info)
 {
-    /* Setup our return object */
-    v8::Local<v8::Value> functionReturnValue = Nan::New("").ToLocalChecked();
-
-    bool functionSuccess = false;
-
-    uint32_t count = 0;
-
-    if (info[0]->IsNumber())
-    {
-        try
-        {
-            count = getUInt32(info, 0);
-
-            uint32_t depth = Core::Cryptography::tree_depth(count);
-
-            functionReturnValue = Nan::New(depth);
-
-            functionSuccess = true;
-        }
-        catch (const std::exception &)
-        {
-            functionSuccess = false;
-        }
-    }
-
-    info.GetReturnValue().Set(prepareResult(functionSuccess, functionReturnValue));
+    runJob(info, tree_depth_job(info));
 }
 
 void tree_hash(const Nan::FunctionCallbackInfo<v8::Value> &info)
 {
-    /* Setup our return object */
-    v8::Local<v8::Value> functionReturnValue = Nan::New("").ToLocalChecked();
-
-    bool functionSuccess = false;
-
-    std::vector<std::string> hashes = toStringVector(info, 0);
-
-    if (hashes.size() != 0)
-    {
-        try
-        {
-            std::string hash = Core::Cryptography::tree_hash(hashes);
-
-            functionReturnValue = Nan::New(hash).ToLocalChecked();
-
-            functionSuccess = true;
-        }
-        catch (const std::exception &)
-        {
-            functionSuccess = false;
-        }
-    }
-
-    info.GetReturnValue().Set(prepareResult(functionSuccess, functionReturnValue));
+    runJob(info, tree_hash_job(info));
 }
 
 void tree_branch(const Nan::FunctionCallbackInfo<v8::Value> &info)
 {
-    /* Setup our return object */
-    v8::Local<v8::Value> functionReturnValue = Nan::New("").ToLocalChecked();
-
-    bool functionSuccess = false;
-
-    std::vector<std::string> hashes = toStringVector(info, 0);
-
-    if (hashes.size() != 0)
-    {
-        try
-        {
-            std::vector<std::string> _branches = Core::Cryptography::tree_branch(hashes);
-
-            v8::Local<v8::Array> branches = Nan::New<v8::Array>(_branches.size());
-
-            for (size_t i = 0; i < _branches.size(); i++)
-            {
-                v8::Local<v8::String> result = Nan::New(_branches[i]).ToLocalChecked();
-
-                Nan::Set(branches, i, result);
-            }
-
-            functionReturnValue = branches;
-
-            functionSuccess = true;
-        }
-        catch (const std::exception &)
-        {
-            functionSuccess = false;
-        }
-    }
-
-    info.GetReturnValue().Set(prepareResult(functionSuccess, functionReturnValue));
+    runJob(info, tree_branch_job(info));
 }
 
 void tree_hash_from_branch(const Nan::FunctionCallbackInfo<v8::Value> &info)
 {
-    /* Setup our return object */
-    v8::Local<v8::Value> functionReturnValue = Nan::New("").ToLocalChecked();
-
-    bool functionSuccess = false;
-
-    std::vector<std::string> branches = toStringVector(info, 0);
-
-    std::string leaf = getString(info, 1);
-
-    std::string path = getString(info, 2);
-
-    if (info[2]->IsNumber())
-    {
-        path = std::to_string((size_t)getUInt32(info, 2));
-    }
-
-    if (!leaf.empty() && !path.empty())
-    {
-        try
-        {
-            std::string hash = Core::Cryptography::tree_hash_from_branch(branches, leaf, path);
-
-            functionReturnValue = Nan::New(hash).ToLocalChecked();
-            ;
-
-            functionSuccess = true;
-        }
-        catch (const std::exception &)
-        {
-            functionSuccess = false;
-        }
-    }
-
-    info.GetReturnValue().Set(prepareResult(functionSuccess, functionReturnValue));
-}
-
-void underivePublicKey(const Nan::FunctionCallbackInfo<v8::Value> &info)
-{
-    /* Setup our return object */
-    v8::Local<v8::Value> functionReturnValue = Nan::New("").ToLocalChecked();
-
-    bool functionSuccess = false;
-
-    std::string derivation = getString(info, 0);
-
-    size_t outputIndex = (size_t)getUInt32(info, 1);
+    runJob(info, tree_hash_from_branch_job(info));
+}
 
-    std::string derivedKey = getString(info, 2);
+void underivePublicKey(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    runJob(info, underivePublicKeyJob(info));
+}
 
-    if (!derivation.empty() && !derivedKey.empty())
-    {
-        try
-        {
-            std::string publicKey;
+void cn_fast_hash(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    runJob(info, hashJob<Core::Cryptography::cn_fast_hash>(info));
+}
 
-            bool success = Core::Cryptography::underivePublicKey(derivation, outputIndex, derivedKey, publicKey);
+/* Cryptonight Variants */
 
-            if (success)
-            {
-                functionReturnValue = Nan::New(publicKey).ToLocalChecked();
+void cn_slow_hash_v0(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    runJob(info, hashJob<Core::Cryptography::cn_slow_hash_v0>(info));
+}
 
-                functionSuccess = true;
-            }
-        }
-        catch (const std::exception &)
-        {
-            functionSuccess = false;
-        }
-    }
+void cn_slow_hash_v1(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    runJob(info, hashJob<Core::Cryptography::cn_slow_hash_v1>(info));
+}
 
-    info.GetReturnValue().Set(prepareResult(functionSuccess, functionReturnValue));
+void cn_slow_hash_v2(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    runJob(info, hashJob<Core::Cryptography::cn_slow_hash_v2>(info));
 }
 
-/*
- *
- * Hashing Operations
- *
- */
+/* Cryptonight Lite Variants */
 
-void cn_fast_hash(const Nan::FunctionCallbackInfo<v8::Value> &info)
+void cn_lite_slow_hash_v0(const Nan::FunctionCallbackInfo<v8::Value> &info)
 {
-    /* Setup our return object */
-    v8::Local<v8::Value> functionReturnValue = Nan::New("").ToLocalChecked();
+    runJob(info, hashJob<Core::Cryptography::cn_lite_slow_hash_v0>(info));
+}
 
-    bool functionSuccess = false;
+void cn_lite_slow_hash_v1(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    runJob(info, hashJob<Core::Cryptography::cn_lite_slow_hash_v1>(info));
+}
 
-    std::string data = getString(info, 0);
+void cn_lite_slow_hash_v2(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    runJob(info, hashJob<Core::Cryptography::cn_lite_slow_hash_v2>(info));
+}
 
-    if (!data.empty())
-    {
-        try
-        {
-            std::string hash = Core::Cryptography::cn_fast_hash(data);
+/* Cryptonight Dark Variants */
 
-            functionReturnValue = Nan::New(hash).ToLocalChecked();
+void cn_dark_slow_hash_v0(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    runJob(info, hashJob<Core::Cryptography::cn_dark_slow_hash_v0>(info));
+}
 
-            functionSuccess = true;
-        }
-        catch (const std::exception &)
-        {
-            functionSuccess = false;
-        }
-    }
+void cn_dark_slow_hash_v1(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    runJob(info, hashJob<Core::Cryptography::cn_dark_slow_hash_v1>(info));
+}
 
-    info.GetReturnValue().Set(prepareResult(functionSuccess, functionReturnValue));
+void cn_dark_slow_hash_v2(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    runJob(info, hashJob<Core::Cryptography::cn_dark_slow_hash_v2>(info));
 }
 
-/* Cryptonight Variants */
+/* Cryptonight Dark Lite Variants */
 
-void cn_slow_hash_v0(const Nan::FunctionCallbackInfo<v8::Value> &info)
+void cn_dark_lite_slow_hash_v0(const Nan::FunctionCallbackInfo<v8::Value> &info)
 {
-    /* Setup our return object */
-    v8::Local<v8::Value> functionReturnValue = Nan::New("").ToLocalChecked();
-
-    bool functionSuccess = false;
+    runJob(info, hashJob<Core::Cryptography::cn_dark_lite_slow_hash_v0>(info));
+}
 
-    std::string data = getString(info, 0);
+void cn_dark_lite_slow_hash_v1(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    runJob(info, hashJob<Core::Cryptography::cn_dark_lite_slow_hash_v1>(info));
+}
 
-    if (!data.empty())
-    {
-        try
-        {
-            std::string hash = Core::Cryptography::cn_slow_hash_v0(data);
+void cn_dark_lite_slow_hash_v2(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    runJob(info, hashJob<Core::Cryptography::cn_dark_lite_slow_hash_v2>(info));
+}
 
-            functionReturnValue = Nan::New(hash).ToLocalChecked();
+/* Cryptonight Turtle Variants */
 
-            functionSuccess = true;
-        }
-        catch (const std::exception &)
-        {
-            functionSuccess = false;
-        }
-    }
+void cn_turtle_slow_hash_v0(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    runJob(info, hashJob<Core::Cryptography::cn_turtle_slow_hash_v0>(info));
+}
 
-    info.GetReturnValue().Set(prepareResult(functionSuccess, functionReturnValue));
+void cn_turtle_slow_hash_v1(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    runJob(info, hashJob<Core::Cryptography::cn_turtle_slow_hash_v1>(info));
 }
 
-void cn_slow_hash_v1(const Nan::FunctionCallbackInfo<v8::Value> &info)
+void cn_turtle_slow_hash_v2(const Nan::FunctionCallbackInfo<v8::Value> &info)
 {
-    /* Setup our return object */
-    v8::Local<v8::Value> functionReturnValue = Nan::New("").ToLocalChecked();
+    runJob(info, hashJob<Core::Cryptography::cn_turtle_slow_hash_v2>(info));
+}
 
-    bool functionSuccess = false;
+/* Cryptonight Turtle Lite Variants */
 
-    std::string data = getString(info, 0);
+void cn_turtle_lite_slow_hash_v0(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    runJob(info, hashJob<Core::Cryptography::cn_turtle_lite_slow_hash_v0>(info));
+}
 
-    if (!data.empty())
-    {
-        try
-        {
-            std::string hash = Core::Cryptography::cn_slow_hash_v1(data);
+void cn_turtle_lite_slow_hash_v1(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    runJob(info, hashJob<Core::Cryptography::cn_turtle_lite_slow_hash_v1>(info));
+}
 
-            functionReturnValue = Nan::New(hash).ToLocalChecked();
+void cn_turtle_lite_slow_hash_v2(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    runJob(info, hashJob<Core::Cryptography::cn_turtle_lite_slow_hash_v2>(info));
+}
 
-            functionSuccess = true;
-        }
-        catch (const std::exception &)
-        {
-            functionSuccess = false;
-        }
-    }
+/* Chukwa */
 
-    info.GetReturnValue().Set(prepareResult(functionSuccess, functionReturnValue));
+void chukwa_slow_hash_base(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    runJob(info, chukwa_slow_hash_base_job(info));
 }
 
-void cn_slow_hash_v2(const Nan::FunctionCallbackInfo<v8::Value> &info)
+void chukwa_slow_hash_v1(const Nan::FunctionCallbackInfo<v8::Value> &info)
 {
-    /* Setup our return object */
-    v8::Local<v8::Value> functionReturnValue = Nan::New("").ToLocalChecked();
+    runJob(info, hashJob<Core::Cryptography::chukwa_slow_hash_v1>(info));
+}
 
-    bool functionSuccess = false;
+void chukwa_slow_hash_v2(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    runJob(info, hashJob<Core::Cryptography::chukwa_slow_hash_v2>(info));
+}
 
-    std::string data = getString(info, 0);
+/*
+ *
+ * Asynchronous Operations
+ *
+ * Each of the methods above has a variant that takes a node-style callback as
+ * its last argument. The arguments are read on the main thread, the work itself
+ * runs on the libuv threadpool, and the callback is invoked with (err, value)
+ * in the same order as the [err, value] arrays returned by the synchronous
+ * methods. They are exported on the "async" object of the module.
+ *
+ */
+
+template<typename T> class CryptoWorker : public Nan::AsyncWorker
+{
+  public:
+    CryptoWorker(Nan::Callback *callback, CryptoJob<T> job):
+        Nan::AsyncWorker(callback, "turtlecoin-crypto:CryptoWorker"), m_job(job), m_result(), m_success(false)
+    {
+    }
 
-    if (!data.empty())
+    void Execute() override
     {
         try
         {
-            std::string hash = Core::Cryptography::cn_slow_hash_v2(data);
-
-            functionReturnValue = Nan::New(hash).ToLocalChecked();
-
-            functionSuccess = true;
+            m_success = m_job(m_result);
         }
         catch (const std::exception &)
         {
-            functionSuccess = false;
+            m_success = false;
         }
     }
 
-    info.GetReturnValue().Set(prepareResult(functionSuccess, functionReturnValue));
-}
+    void HandleOKCallback() override
+    {
+        Nan::HandleScope scope;
 
-/* Cryptonight Lite Variants */
+        v8::Local<v8::Value> argv[] = {Nan::New(!m_success),
+                                       m_success ? toV8Value(m_result) : toV8Value(std::string())};
 
-void cn_lite_slow_hash_v0(const Nan::FunctionCallbackInfo<v8::Value> &info)
-{
-    /* Setup our return object */
-    v8::Local<v8::Value> functionReturnValue = Nan::New("").ToLocalChecked();
+        callback->Call(2, argv, async_resource);
+    }
 
-    bool functionSuccess = false;
+  private:
+    CryptoJob<T> m_job;
 
-    std::string data = getString(info, 0);
+    T m_result;
 
-    if (!data.empty())
-    {
-        try
-        {
-            std::string hash = Core::Cryptography::cn_lite_slow_hash_v0(data);
+    bool m_success;
+};
 
-            functionReturnValue = Nan::New(hash).ToLocalChecked();
+template<typename T> void queueJob(const Nan::FunctionCallbackInfo<v8::Value> &info, CryptoJob<T> job)
+{
+    if (info.Length() == 0 || !info[info.Length() - 1]->IsFunction())
+    {
+        Nan::ThrowTypeError("The last argument must be a callback function");
 
-            functionSuccess = true;
-        }
-        catch (const std::exception &)
-        {
-            functionSuccess = false;
-        }
+        return;
     }
 
-    info.GetReturnValue().Set(prepareResult(functionSuccess, functionReturnValue));
+    Nan::Callback *callback = new Nan::Callback(info[info.Length() - 1].As<v8::Function>());
+
+    Nan::AsyncQueueWorker(new CryptoWorker<T>(callback, job));
 }
 
-void cn_lite_slow_hash_v1(const Nan::FunctionCallbackInfo<v8::Value> &info)
+void calculateMultisigPrivateKeysAsync(const Nan::FunctionCallbackInfo<v8::Value> &info)
 {
-    /* Setup our return object */
-    v8::Local<v8::Value> functionReturnValue = Nan::New("").ToLocalChecked();
-
-    bool functionSuccess = false;
+    queueJob(info, calculateMultisigPrivateKeysJob(info));
+}
 
-    std::string data = getString(info, 0);
+void calculateSharedPrivateKeyAsync(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    queueJob(info, calculateSharedPrivateKeyJob(info));
+}
 
-    if (!data.empty())
-    {
-        try
-        {
-            std::string hash = Core::Cryptography::cn_lite_slow_hash_v1(data);
+void calculateSharedPublicKeyAsync(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    queueJob(info, calculateSharedPublicKeyJob(info));
+}
 
-            functionReturnValue = Nan::New(hash).ToLocalChecked();
+void prepareRingSignaturesAsync(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    queueJob(info, prepareRingSignaturesJob(info));
+}
 
-            functionSuccess = true;
-        }
-        catch (const std::exception &)
-        {
-            functionSuccess = false;
-        }
-    }
+void completeRingSignaturesAsync(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    queueJob(info, completeRingSignaturesJob(info));
+}
 
-    info.GetReturnValue().Set(prepareResult(functionSuccess, functionReturnValue));
+void restoreRingSignaturesAsync(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    queueJob(info, restoreRingSignaturesJob(info));
 }
 
-void cn_lite_slow_hash_v2(const Nan::FunctionCallbackInfo<v8::Value> &info)
+void generatePartialSigningKeyAsync(const Nan::FunctionCallbackInfo<v8::Value> &info)
 {
-    /* Setup our return object */
-    v8::Local<v8::Value> functionReturnValue = Nan::New("").ToLocalChecked();
+    queueJob(info, generatePartialSigningKeyJob(info));
+}
 
-    bool functionSuccess = false;
+void restoreKeyImageAsync(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    queueJob(info, restoreKeyImageJob(info));
+}
 
-    std::string data = getString(info, 0);
+void checkKeyAsync(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    queueJob(info, checkKeyJob(info));
+}
 
-    if (!data.empty())
-    {
-        try
-        {
-            std::string hash = Core::Cryptography::cn_lite_slow_hash_v2(data);
+void checkRingSignatureAsync(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    queueJob(info, checkRingSignatureJob(info));
+}
 
-            functionReturnValue = Nan::New(hash).ToLocalChecked();
+void checkSignatureAsync(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    queueJob(info, checkSignatureJob(info));
+}
 
-            functionSuccess = true;
-        }
-        catch (const std::exception &)
-        {
-            functionSuccess = false;
-        }
-    }
+void derivePublicKeyAsync(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    queueJob(info, derivePublicKeyJob(info));
+}
 
-    info.GetReturnValue().Set(prepareResult(functionSuccess, functionReturnValue));
+void deriveSecretKeyAsync(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    queueJob(info, deriveSecretKeyJob(info));
 }
 
-/* Cryptonight Dark Variants */
+void generateKeysAsync(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    queueJob(info, generateKeysJob(info));
+}
 
-void cn_dark_slow_hash_v0(const Nan::FunctionCallbackInfo<v8::Value> &info)
+void generateKeyDerivationAsync(const Nan::FunctionCallbackInfo<v8::Value> &info)
 {
-    /* Setup our return object */
-    v8::Local<v8::Value> functionReturnValue = Nan::New("").ToLocalChecked();
+    queueJob(info, generateKeyDerivationJob(info));
+}
 
-    bool functionSuccess = false;
+void generateKeyDerivationScalarAsync(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    queueJob(info, generateKeyDerivationScalarJob(info));
+}
 
-    std::string data = getString(info, 0);
+void derivationToScalarAsync(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    queueJob(info, derivationToScalarJob(info));
+}
 
-    if (!data.empty())
-    {
-        try
-        {
-            std::string hash = Core::Cryptography::cn_dark_slow_hash_v0(data);
+void generateKeyImageAsync(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    queueJob(info, generateKeyImageJob(info));
+}
 
-            functionReturnValue = Nan::New(hash).ToLocalChecked();
+void generatePrivateViewKeyFromPrivateSpendKeyAsync(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    queueJob(info, generatePrivateViewKeyFromPrivateSpendKeyJob(info));
+}
 
-            functionSuccess = true;
-        }
-        catch (const std::exception &)
-        {
-            functionSuccess = false;
-        }
-    }
+void generateDeterministicSubwalletKeysAsync(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    queueJob(info, generateDeterministicSubwalletKeysJob(info));
+}
 
-    info.GetReturnValue().Set(prepareResult(functionSuccess, functionReturnValue));
+void generateViewKeysFromPrivateSpendKeyAsync(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    queueJob(info, generateViewKeysFromPrivateSpendKeyJob(info));
 }
 
-void cn_dark_slow_hash_v1(const Nan::FunctionCallbackInfo<v8::Value> &info)
+void generateRingSignaturesAsync(const Nan::FunctionCallbackInfo<v8::Value> &info)
 {
-    /* Setup our return object */
-    v8::Local<v8::Value> functionReturnValue = Nan::New("").ToLocalChecked();
+    queueJob(info, generateRingSignaturesJob(info));
+}
 
-    bool functionSuccess = false;
+void generateSignatureAsync(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    queueJob(info, generateSignatureJob(info));
+}
 
-    std::string data = getString(info, 0);
+void hashToEllipticCurveAsync(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    queueJob(info, hashToEllipticCurveJob(info));
+}
 
-    if (!data.empty())
-    {
-        try
-        {
-            std::string hash = Core::Cryptography::cn_dark_slow_hash_v1(data);
+void hashToScalarAsync(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    queueJob(info, hashToScalarJob(info));
+}
 
-            functionReturnValue = Nan::New(hash).ToLocalChecked();
+void scalarDerivePublicKeyAsync(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    queueJob(info, scalarDerivePublicKeyJob(info));
+}
 
-            functionSuccess = true;
-        }
-        catch (const std::exception &)
-        {
-            functionSuccess = false;
-        }
-    }
+void scalarDeriveSecretKeyAsync(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    queueJob(info, scalarDeriveSecretKeyJob(info));
+}
 
-    info.GetReturnValue().Set(prepareResult(functionSuccess, functionReturnValue));
+void scalarmultKeyAsync(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    queueJob(info, scalarmultKeyJob(info));
 }
 
-void cn_dark_slow_hash_v2(const Nan::FunctionCallbackInfo<v8::Value> &info)
+void scReduce32Async(const Nan::FunctionCallbackInfo<v8::Value> &info)
 {
-    /* Setup our return object */
-    v8::Local<v8::Value> functionReturnValue = Nan::New("").ToLocalChecked();
+    queueJob(info, scReduce32Job(info));
+}
 
-    bool functionSuccess = false;
+void secretKeyToPublicKeyAsync(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    queueJob(info, secretKeyToPublicKeyJob(info));
+}
 
-    std::string data = getString(info, 0);
+void tree_depth_async(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    queueJob(info, tree_depth_job(info));
+}
 
-    if (!data.empty())
-    {
-        try
-        {
-            std::string hash = Core::Cryptography::cn_dark_slow_hash_v2(data);
+void tree_hash_async(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    queueJob(info, tree_hash_job(info));
+}
 
-            functionReturnValue = Nan::New(hash).ToLocalChecked();
+void tree_branch_async(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    queueJob(info, tree_branch_job(info));
+}
 
-            functionSuccess = true;
-        }
-        catch (const std::exception &)
-        {
-            functionSuccess = false;
-        }
-    }
+void tree_hash_from_branch_async(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    queueJob(info, tree_hash_from_branch_job(info));
+}
 
-    info.GetReturnValue().Set(prepareResult(functionSuccess, functionReturnValue));
+void underivePublicKeyAsync(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    queueJob(info, underivePublicKeyJob(info));
 }
 
-/* Cryptonight Dark Lite Variants */
+/* cn_fast_hash and every slow hash variant that only takes the data to hash */
+template<std::string (*HashFunction)(const std::string)>
+void hashAsync(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    queueJob(info, hashJob<HashFunction>(info));
+}
 
-void cn_dark_lite_slow_hash_v0(const Nan::FunctionCallbackInfo<v8::Value> &info)
+void chukwa_slow_hash_base_async(const Nan::FunctionCallbackInfo<v8::Value> &info)
 {
-    /* Setup our return object */
-    v8::Local<v8::Value> functionReturnValue = Nan::New("").ToLocalChecked();
+    queueJob(info, chukwa_slow_hash_base_job(info));
+}
 
-    bool functionSuccess = false;
+/*
+ *
+ * Batch Operations
+ *
+ * These take Buffers (or any other typed array) of packed, fixed-width binary
+ * records instead of hex strings, and return a Buffer holding one packed result
+ * per record. An argument that holds a single record is used for every record
+ * of the batch. Results that could not be computed are left zeroed, and the
+ * check methods return one byte per record that is 1 if the check passed.
+ *
+ */
 
-    std::string data = getString(info, 0);
+/* Copies the records out of a typed array, so that they outlive the call */
+template<typename T> std::vector<T> getRecords(const Nan::FunctionCallbackInfo<v8::Value> &info, const uint8_t index)
+{
+    std::vector<T> records;
 
-    if (!data.empty())
+    if (info[index]->IsArrayBufferView())
     {
-        try
-        {
-            std::string hash = Core::Cryptography::cn_dark_lite_slow_hash_v0(data);
-
-            functionReturnValue = Nan::New(hash).ToLocalChecked();
+        Nan::TypedArrayContents<uint8_t> contents(info[index]);
 
-            functionSuccess = true;
-        }
-        catch (const std::exception &)
+        if (contents.length() != 0 && contents.length() % sizeof(T) == 0)
         {
-            functionSuccess = false;
+            records.resize(contents.length() / sizeof(T));
+
+            std::memcpy(records.data(), *contents, contents.length());
         }
     }
 
-    info.GetReturnValue().Set(prepareResult(functionSuccess, functionReturnValue));
+    return records;
 }
 
-void cn_dark_lite_slow_hash_v1(const Nan::FunctionCallbackInfo<v8::Value> &info)
+/* Output indexes and ring sizes may be given as a typed array, an array or a single number */
+inline std::vector<uint32_t> getUInt32Records(const Nan::FunctionCallbackInfo<v8::Value> &info, const uint8_t index)
 {
-    /* Setup our return object */
-    v8::Local<v8::Value> functionReturnValue = Nan::New("").ToLocalChecked();
+    std::vector<uint32_t> records;
 
-    bool functionSuccess = false;
-
-    std::string data = getString(info, 0);
-
-    if (!data.empty())
+    if (info[index]->IsNumber())
     {
-        try
-        {
-            std::string hash = Core::Cryptography::cn_dark_lite_slow_hash_v1(data);
-
-            functionReturnValue = Nan::New(hash).ToLocalChecked();
+        records.push_back(getUInt32(info, index));
+    }
+    else if (info[index]->IsArray())
+    {
+        v8::Local<v8::Array> array = v8::Local<v8::Array>::Cast(info[index]);
 
-            functionSuccess = true;
-        }
-        catch (const std::exception &)
+        for (size_t i = 0; i < array->Length(); i++)
         {
-            functionSuccess = false;
+            records.push_back(Nan::To<uint32_t>(Nan::Get(array, i).ToLocalChecked()).FromMaybe(0));
         }
     }
+    else
+    {
+        records = getRecords<uint32_t>(info, index);
+    }
 
-    info.GetReturnValue().Set(prepareResult(functionSuccess, functionReturnValue));
+    return records;
 }
 
-void cn_dark_lite_slow_hash_v2(const Nan::FunctionCallbackInfo<v8::Value> &info)
+/* The number of records in the batch, or 0 if any argument holds neither one
+   record nor as many as the largest argument */
+inline size_t batchSize(std::initializer_list<size_t> sizes)
 {
-    /* Setup our return object */
-    v8::Local<v8::Value> functionReturnValue = Nan::New("").ToLocalChecked();
-
-    bool functionSuccess = false;
+    size_t count = 1;
 
-    std::string data = getString(info, 0);
-
-    if (!data.empty())
+    for (const size_t size : sizes)
     {
-        try
-        {
-            std::string hash = Core::Cryptography::cn_dark_lite_slow_hash_v2(data);
-
-            functionReturnValue = Nan::New(hash).ToLocalChecked();
-
-            functionSuccess = true;
-        }
-        catch (const std::exception &)
+        if (size == 0 || (size != 1 && count != 1 && size != count))
         {
-            functionSuccess = false;
+            return 0;
         }
+
+        count = std::max(count, size);
     }
 
-    info.GetReturnValue().Set(prepareResult(functionSuccess, functionReturnValue));
+    return count;
 }
 
-/* Cryptonight Turtle Variants */
+template<typename T> const T &recordAt(const std::vector<T> &records, const size_t index)
+{
+    return records.size() == 1 ? records[0] : records[index];
+}
 
-void cn_turtle_slow_hash_v0(const Nan::FunctionCallbackInfo<v8::Value> &info)
+template<typename T> void putRecord(std::vector<uint8_t> &output, const size_t index, const T &record)
 {
-    /* Setup our return object */
-    v8::Local<v8::Value> functionReturnValue = Nan::New("").ToLocalChecked();
+    std::memcpy(output.data() + index * sizeof(T), &record, sizeof(T));
+}
 
-    bool functionSuccess = false;
+CryptoJob<std::vector<uint8_t>> generateKeyDerivationsJob(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    std::vector<Crypto::PublicKey> publicKeys = getRecords<Crypto::PublicKey>(info, 0);
 
-    std::string data = getString(info, 0);
+    std::vector<Crypto::SecretKey> secretKeys = getRecords<Crypto::SecretKey>(info, 1);
 
-    if (!data.empty())
-    {
-        try
+    return [publicKeys, secretKeys](std::vector<uint8_t> &result) {
+        const size_t count = batchSize({publicKeys.size(), secretKeys.size()});
+
+        if (count == 0)
         {
-            std::string hash = Core::Cryptography::cn_turtle_slow_hash_v0(data);
+            return false;
+        }
 
-            functionReturnValue = Nan::New(hash).ToLocalChecked();
+        result.assign(count * sizeof(Crypto::KeyDerivation), 0);
 
-            functionSuccess = true;
-        }
-        catch (const std::exception &)
+        for (size_t i = 0; i < count; i++)
         {
-            functionSuccess = false;
+            Crypto::KeyDerivation derivation;
+
+            if (Core::BinaryCryptography::generateKeyDerivation(
+                    recordAt(publicKeys, i), recordAt(secretKeys, i), derivation))
+            {
+                putRecord(result, i, derivation);
+            }
         }
-    }
 
-    info.GetReturnValue().Set(prepareResult(functionSuccess, functionReturnValue));
+        return true;
+    };
 }
 
-void cn_turtle_slow_hash_v1(const Nan::FunctionCallbackInfo<v8::Value> &info)
+CryptoJob<std::vector<uint8_t>> derivePublicKeysJob(const Nan::FunctionCallbackInfo<v8::Value> &info)
 {
-    /* Setup our return object */
-    v8::Local<v8::Value> functionReturnValue = Nan::New("").ToLocalChecked();
+    std::vector<Crypto::KeyDerivation> derivations = getRecords<Crypto::KeyDerivation>(info, 0);
 
-    bool functionSuccess = false;
+    std::vector<uint32_t> outputIndexes = getUInt32Records(info, 1);
 
-    std::string data = getString(info, 0);
+    std::vector<Crypto::PublicKey> publicKeys = getRecords<Crypto::PublicKey>(info, 2);
 
-    if (!data.empty())
-    {
-        try
+    return [derivations, outputIndexes, publicKeys](std::vector<uint8_t> &result) {
+        const size_t count = batchSize({derivations.size(), outputIndexes.size(), publicKeys.size()});
+
+        if (count == 0)
         {
-            std::string hash = Core::Cryptography::cn_turtle_slow_hash_v1(data);
+            return false;
+        }
 
-            functionReturnValue = Nan::New(hash).ToLocalChecked();
+        result.assign(count * sizeof(Crypto::PublicKey), 0);
 
-            functionSuccess = true;
-        }
-        catch (const std::exception &)
+        for (size_t i = 0; i < count; i++)
         {
-            functionSuccess = false;
+            Crypto::PublicKey derivedKey;
+
+            if (Core::BinaryCryptography::derivePublicKey(
+                    recordAt(derivations, i), recordAt(outputIndexes, i), recordAt(publicKeys, i), derivedKey))
+            {
+                putRecord(result, i, derivedKey);
+            }
         }
-    }
 
-    info.GetReturnValue().Set(prepareResult(functionSuccess, functionReturnValue));
+        return true;
+    };
 }
 
-void cn_turtle_slow_hash_v2(const Nan::FunctionCallbackInfo<v8::Value> &info)
+CryptoJob<std::vector<uint8_t>> underivePublicKeysJob(const Nan::FunctionCallbackInfo<v8::Value> &info)
 {
-    /* Setup our return object */
-    v8::Local<v8::Value> functionReturnValue = Nan::New("").ToLocalChecked();
+    std::vector<Crypto::KeyDerivation> derivations = getRecords<Crypto::KeyDerivation>(info, 0);
 
-    bool functionSuccess = false;
+    std::vector<uint32_t> outputIndexes = getUInt32Records(info, 1);
 
-    std::string data = getString(info, 0);
+    std::vector<Crypto::PublicKey> derivedKeys = getRecords<Crypto::PublicKey>(info, 2);
 
-    if (!data.empty())
-    {
-        try
+    return [derivations, outputIndexes, derivedKeys](std::vector<uint8_t> &result) {
+        const size_t count = batchSize({derivations.size(), outputIndexes.size(), derivedKeys.size()});
+
+        if (count == 0)
         {
-            std::string hash = Core::Cryptography::cn_turtle_slow_hash_v2(data);
+            return false;
+        }
 
-            functionReturnValue = Nan::New(hash).ToLocalChecked();
+        result.assign(count * sizeof(Crypto::PublicKey), 0);
 
-            functionSuccess = true;
-        }
-        catch (const std::exception &)
+        for (size_t i = 0; i < count; i++)
         {
-            functionSuccess = false;
+            Crypto::PublicKey publicKey;
+
+            if (Core::BinaryCryptography::underivePublicKey(
+                    recordAt(derivations, i), recordAt(outputIndexes, i), recordAt(derivedKeys, i), publicKey))
+            {
+                putRecord(result, i, publicKey);
+            }
         }
-    }
 
-    info.GetReturnValue().Set(prepareResult(functionSuccess, functionReturnValue));
+        return true;
+    };
 }
 
-/* Cryptonight Turtle Lite Variants */
-
-void cn_turtle_lite_slow_hash_v0(const Nan::FunctionCallbackInfo<v8::Value> &info)
+CryptoJob<std::vector<uint8_t>> generateKeyImagesJob(const Nan::FunctionCallbackInfo<v8::Value> &info)
 {
-    /* Setup our return object */
-    v8::Local<v8::Value> functionReturnValue = Nan::New("").ToLocalChecked();
+    std::vector<Crypto::PublicKey> publicKeys = getRecords<Crypto::PublicKey>(info, 0);
 
-    bool functionSuccess = false;
+    std::vector<Crypto::SecretKey> secretKeys = getRecords<Crypto::SecretKey>(info, 1);
 
-    std::string data = getString(info, 0);
+    return [publicKeys, secretKeys](std::vector<uint8_t> &result) {
+        const size_t count = batchSize({publicKeys.size(), secretKeys.size()});
 
-    if (!data.empty())
-    {
-        try
+        if (count == 0)
         {
-            std::string hash = Core::Cryptography::cn_turtle_lite_slow_hash_v0(data);
+            return false;
+        }
 
-            functionReturnValue = Nan::New(hash).ToLocalChecked();
+        result.assign(count * sizeof(Crypto::KeyImage), 0);
 
-            functionSuccess = true;
-        }
-        catch (const std::exception &)
+        for (size_t i = 0; i < count; i++)
         {
-            functionSuccess = false;
+            Crypto::KeyImage keyImage;
+
+            Core::BinaryCryptography::generateKeyImage(recordAt(publicKeys, i), recordAt(secretKeys, i), keyImage);
+
+            putRecord(result, i, keyImage);
         }
-    }
 
-    info.GetReturnValue().Set(prepareResult(functionSuccess, functionReturnValue));
+        return true;
+    };
 }
 
-void cn_turtle_lite_slow_hash_v1(const Nan::FunctionCallbackInfo<v8::Value> &info)
+CryptoJob<std::vector<uint8_t>> checkSignaturesBatchJob(const Nan::FunctionCallbackInfo<v8::Value> &info)
 {
-    /* Setup our return object */
-    v8::Local<v8::Value> functionReturnValue = Nan::New("").ToLocalChecked();
+    std::vector<Crypto::Hash> prefixHashes = getRecords<Crypto::Hash>(info, 0);
 
-    bool functionSuccess = false;
+    std::vector<Crypto::PublicKey> publicKeys = getRecords<Crypto::PublicKey>(info, 1);
 
-    std::string data = getString(info, 0);
+    std::vector<Crypto::Signature> signatures = getRecords<Crypto::Signature>(info, 2);
 
-    if (!data.empty())
-    {
-        try
+    return [prefixHashes, publicKeys, signatures](std::vector<uint8_t> &result) {
+        const size_t count = batchSize({prefixHashes.size(), publicKeys.size(), signatures.size()});
+
+        if (count == 0)
         {
-            std::string hash = Core::Cryptography::cn_turtle_lite_slow_hash_v1(data);
+            return false;
+        }
 
-            functionReturnValue = Nan::New(hash).ToLocalChecked();
+        result.assign(count, 0);
 
-            functionSuccess = true;
-        }
-        catch (const std::exception &)
+        for (size_t i = 0; i < count; i++)
         {
-            functionSuccess = false;
+            result[i] = Core::BinaryCryptography::checkSignature(
+                recordAt(prefixHashes, i), recordAt(publicKeys, i), recordAt(signatures, i));
         }
-    }
 
-    info.GetReturnValue().Set(prepareResult(functionSuccess, functionReturnValue));
+        return true;
+    };
 }
 
-void cn_turtle_lite_slow_hash_v2(const Nan::FunctionCallbackInfo<v8::Value> &info)
+/* The public keys and signatures of every ring are packed one ring after the
+   other, with the size of each ring given by ringSizes */
+CryptoJob<std::vector<uint8_t>> checkRingSignaturesBatchJob(const Nan::FunctionCallbackInfo<v8::Value> &info)
 {
-    /* Setup our return object */
-    v8::Local<v8::Value> functionReturnValue = Nan::New("").ToLocalChecked();
+    std::vector<Crypto::Hash> prefixHashes = getRecords<Crypto::Hash>(info, 0);
 
-    bool functionSuccess = false;
+    std::vector<Crypto::KeyImage> keyImages = getRecords<Crypto::KeyImage>(info, 1);
 
-    std::string data = getString(info, 0);
+    std::vector<Crypto::PublicKey> publicKeys = getRecords<Crypto::PublicKey>(info, 2);
 
-    if (!data.empty())
-    {
-        try
+    std::vector<Crypto::Signature> signatures = getRecords<Crypto::Signature>(info, 3);
+
+    std::vector<uint32_t> ringSizes = getUInt32Records(info, 4);
+
+    return [prefixHashes, keyImages, publicKeys, signatures, ringSizes](std::vector<uint8_t> &result) {
+        const size_t count = batchSize({prefixHashes.size(), keyImages.size(), ringSizes.size()});
+
+        if (count == 0)
         {
-            std::string hash = Core::Cryptography::cn_turtle_lite_slow_hash_v2(data);
+            return false;
+        }
 
-            functionReturnValue = Nan::New(hash).ToLocalChecked();
+        size_t totalRingSize = 0;
 
-            functionSuccess = true;
+        for (size_t i = 0; i < count; i++)
+        {
+            totalRingSize += recordAt(ringSizes, i);
         }
-        catch (const std::exception &)
+
+        if (totalRingSize != publicKeys.size() || totalRingSize != signatures.size())
         {
-            functionSuccess = false;
+            return false;
         }
-    }
 
-    info.GetReturnValue().Set(prepareResult(functionSuccess, functionReturnValue));
-}
+        /* Checked together, so that ring members shared between the rings are only
+           decompressed and hashed to the curve once */
+        std::vector<Crypto::RingSignatureCheck> checks(count);
 
-/* Chukwa */
+        for (size_t i = 0, offset = 0; i < count; offset += recordAt(ringSizes, i), i++)
+        {
+            checks[i].prefixHash = recordAt(prefixHashes, i);
 
-void chukwa_slow_hash_base(const Nan::FunctionCallbackInfo<v8::Value> &info)
-{
-    /* Setup our return object */
-    v8::Local<v8::Value> functionReturnValue = Nan::New("").ToLocalChecked();
+            checks[i].keyImage = recordAt(keyImages, i);
 
-    bool functionSuccess = false;
+            checks[i].publicKeys.assign(
+                publicKeys.begin() + offset, publicKeys.begin() + offset + recordAt(ringSizes, i));
 
-    std::string data = getString(info, 0);
+            checks[i].signatures.assign(
+                signatures.begin() + offset, signatures.begin() + offset + recordAt(ringSizes, i));
+        }
 
-    uint32_t iterations = getUInt32(info, 1);
+        std::vector<bool> valid;
 
-    uint32_t memory = getUInt32(info, 2);
+        Crypto::crypto_ops::checkRingSignatures(checks, valid);
 
-    uint32_t threads = getUInt32(info, 3);
+        result.assign(valid.begin(), valid.end());
 
-    if (!data.empty() && iterations != 0 && memory != 0 && threads != 0)
-    {
-        try
+        return true;
+    };
+}
+
+/* Every recordLength bytes of data is hashed as a separate message */
+CryptoJob<std::vector<uint8_t>> cn_fast_hashes_job(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    std::vector<uint8_t> data = getRecords<uint8_t>(info, 0);
+
+    size_t recordLength = (size_t)getUInt32(info, 1);
+
+    return [data, recordLength](std::vector<uint8_t> &result) {
+        if (data.empty() || recordLength == 0 || data.size() % recordLength != 0)
         {
-            std::string hash = Core::Cryptography::chukwa_slow_hash_base(
-                data,
-                iterations,
-                memory,
-                threads);
+            return false;
+        }
 
-            functionReturnValue = Nan::New(hash).ToLocalChecked();
+        const size_t count = data.size() / recordLength;
 
-            functionSuccess = true;
+        std::vector<const void *> messages(count);
+
+        std::vector<size_t> lengths(count, recordLength);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            messages[i] = data.data() + i * recordLength;
         }
-        catch (const std::exception &)
+
+        std::vector<Crypto::Hash> hashes(count);
+
+        Crypto::cn_fast_hash_batch(messages.data(), lengths.data(), count, hashes.data());
+
+        result.assign(count * sizeof(Crypto::Hash), 0);
+
+        for (size_t i = 0; i < count; i++)
         {
-            functionSuccess = false;
+            putRecord(result, i, hashes[i]);
         }
-    }
 
-    info.GetReturnValue().Set(prepareResult(functionSuccess, functionReturnValue));
+        return true;
+    };
 }
 
-void chukwa_slow_hash_v1(const Nan::FunctionCallbackInfo<v8::Value> &info)
+void generateKeyDerivations(const Nan::FunctionCallbackInfo<v8::Value> &info)
 {
-    /* Setup our return object */
-    v8::Local<v8::Value> functionReturnValue = Nan::New("").ToLocalChecked();
+    runJob(info, generateKeyDerivationsJob(info));
+}
 
-    bool functionSuccess = false;
+void derivePublicKeys(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    runJob(info, derivePublicKeysJob(info));
+}
 
-    std::string data = getString(info, 0);
+void underivePublicKeys(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    runJob(info, underivePublicKeysJob(info));
+}
 
-    if (!data.empty())
-    {
-        try
-        {
-            std::string hash = Core::Cryptography::chukwa_slow_hash_v1(data);
+void generateKeyImages(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    runJob(info, generateKeyImagesJob(info));
+}
 
-            functionReturnValue = Nan::New(hash).ToLocalChecked();
+void checkSignaturesBatch(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    runJob(info, checkSignaturesBatchJob(info));
+}
 
-            functionSuccess = true;
-        }
-        catch (const std::exception &)
-        {
-            functionSuccess = false;
-        }
-    }
+void checkRingSignaturesBatch(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    runJob(info, checkRingSignaturesBatchJob(info));
+}
 
-    info.GetReturnValue().Set(prepareResult(functionSuccess, functionReturnValue));
+void cn_fast_hashes(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    runJob(info, cn_fast_hashes_job(info));
 }
 
-void chukwa_slow_hash_v2(const Nan::FunctionCallbackInfo<v8::Value> &info)
+void generateKeyDerivationsAsync(const Nan::FunctionCallbackInfo<v8::Value> &info)
 {
-    /* Setup our return object */
-    v8::Local<v8::Value> functionReturnValue = Nan::New("").ToLocalChecked();
+    queueJob(info, generateKeyDerivationsJob(info));
+}
 
-    bool functionSuccess = false;
+void derivePublicKeysAsync(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    queueJob(info, derivePublicKeysJob(info));
+}
 
-    std::string data = getString(info, 0);
+void underivePublicKeysAsync(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    queueJob(info, underivePublicKeysJob(info));
+}
 
-    if (!data.empty())
-    {
-        try
-        {
-            std::string hash = Core::Cryptography::chukwa_slow_hash_v2(data);
+void generateKeyImagesAsync(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    queueJob(info, generateKeyImagesJob(info));
+}
 
-            functionReturnValue = Nan::New(hash).ToLocalChecked();
+void checkSignaturesBatchAsync(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    queueJob(info, checkSignaturesBatchJob(info));
+}
 
-            functionSuccess = true;
-        }
-        catch (const std::exception &)
-        {
-            functionSuccess = false;
-        }
-    }
+void checkRingSignaturesBatchAsync(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    queueJob(info, checkRingSignaturesBatchJob(info));
+}
 
-    info.GetReturnValue().Set(prepareResult(functionSuccess, functionReturnValue));
+void cn_fast_hashes_async(const Nan::FunctionCallbackInfo<v8::Value> &info)
+{
+    queueJob(info, cn_fast_hashes_job(info));
 }
 
 NAN_MODULE_INIT(InitModule)
@@ -2244,6 +2202,396 @@ NAN_MODULE_INIT(InitModule)
          target,
          Nan::New("chukwa_slow_hash_v2").ToLocalChecked(),
          Nan::GetFunction(Nan::New<v8::FunctionTemplate>(chukwa_slow_hash_v2)).ToLocalChecked());
+
+    /* Batch Operations */
+    Nan::Set(
+        target,
+        Nan::New("generateKeyDerivations").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(generateKeyDerivations)).ToLocalChecked());
+
+    Nan::Set(
+        target,
+        Nan::New("derivePublicKeys").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(derivePublicKeys)).ToLocalChecked());
+
+    Nan::Set(
+        target,
+        Nan::New("underivePublicKeys").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(underivePublicKeys)).ToLocalChecked());
+
+    Nan::Set(
+        target,
+        Nan::New("generateKeyImages").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(generateKeyImages)).ToLocalChecked());
+
+    Nan::Set(
+        target,
+        Nan::New("checkSignaturesBatch").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(checkSignaturesBatch)).ToLocalChecked());
+
+    Nan::Set(
+        target,
+        Nan::New("checkRingSignaturesBatch").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(checkRingSignaturesBatch)).ToLocalChecked());
+
+    Nan::Set(
+        target,
+        Nan::New("cn_fast_hashes").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(cn_fast_hashes)).ToLocalChecked());
+
+    /* Asynchronous Operations */
+    v8::Local<v8::Object> asyncTarget = Nan::New<v8::Object>();
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("calculateMultisigPrivateKeys").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(calculateMultisigPrivateKeysAsync)).ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("calculateSharedPrivateKey").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(calculateSharedPrivateKeyAsync)).ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("calculateSharedPublicKey").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(calculateSharedPublicKeyAsync)).ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("generatePartialSigningKey").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(generatePartialSigningKeyAsync)).ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("prepareRingSignatures").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(prepareRingSignaturesAsync)).ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("completeRingSignatures").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(completeRingSignaturesAsync)).ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("restoreRingSignatures").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(restoreRingSignaturesAsync)).ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("restoreKeyImage").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(restoreKeyImageAsync)).ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("checkKey").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(checkKeyAsync)).ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("checkRingSignature").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(checkRingSignatureAsync)).ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("checkSignature").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(checkSignatureAsync)).ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("derivationToScalar").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(derivationToScalarAsync)).ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("derivePublicKey").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(derivePublicKeyAsync)).ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("deriveSecretKey").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(deriveSecretKeyAsync)).ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("generateKeys").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(generateKeysAsync)).ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("generateKeyDerivation").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(generateKeyDerivationAsync)).ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("generateKeyDerivationScalar").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(generateKeyDerivationScalarAsync)).ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("generateKeyImage").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(generateKeyImageAsync)).ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("generatePrivateViewKeyFromPrivateSpendKey").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(generatePrivateViewKeyFromPrivateSpendKeyAsync))
+            .ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("generateDeterministicSubwalletKeys").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(generateDeterministicSubwalletKeysAsync)).ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("generateViewKeysFromPrivateSpendKey").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(generateViewKeysFromPrivateSpendKeyAsync)).ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("generateRingSignatures").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(generateRingSignaturesAsync)).ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("generateSignature").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(generateSignatureAsync)).ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("hashToEllipticCurve").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(hashToEllipticCurveAsync)).ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("hashToScalar").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(hashToScalarAsync)).ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("scalarDerivePublicKey").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(scalarDerivePublicKeyAsync)).ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("scalarDeriveSecretKey").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(scalarDeriveSecretKeyAsync)).ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("scalarmultKey").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(scalarmultKeyAsync)).ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("scReduce32").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(scReduce32Async)).ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("secretKeyToPublicKey").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(secretKeyToPublicKeyAsync)).ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("tree_depth").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(tree_depth_async)).ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("tree_hash").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(tree_hash_async)).ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("tree_branch").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(tree_branch_async)).ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("tree_hash_from_branch").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(tree_hash_from_branch_async)).ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("underivePublicKey").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(underivePublicKeyAsync)).ToLocalChecked());
+
+    /* Asynchronous Hashing Operations */
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("cnFastHash").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(hashAsync<Core::Cryptography::cn_fast_hash>)).ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("cn_fast_hash").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(hashAsync<Core::Cryptography::cn_fast_hash>)).ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("cn_slow_hash_v0").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(hashAsync<Core::Cryptography::cn_slow_hash_v0>))
+            .ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("cn_slow_hash_v1").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(hashAsync<Core::Cryptography::cn_slow_hash_v1>))
+            .ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("cn_slow_hash_v2").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(hashAsync<Core::Cryptography::cn_slow_hash_v2>))
+            .ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("cn_lite_slow_hash_v0").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(hashAsync<Core::Cryptography::cn_lite_slow_hash_v0>))
+            .ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("cn_lite_slow_hash_v1").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(hashAsync<Core::Cryptography::cn_lite_slow_hash_v1>))
+            .ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("cn_lite_slow_hash_v2").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(hashAsync<Core::Cryptography::cn_lite_slow_hash_v2>))
+            .ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("cn_dark_slow_hash_v0").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(hashAsync<Core::Cryptography::cn_dark_slow_hash_v0>))
+            .ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("cn_dark_slow_hash_v1").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(hashAsync<Core::Cryptography::cn_dark_slow_hash_v1>))
+            .ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("cn_dark_slow_hash_v2").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(hashAsync<Core::Cryptography::cn_dark_slow_hash_v2>))
+            .ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("cn_dark_lite_slow_hash_v0").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(hashAsync<Core::Cryptography::cn_dark_lite_slow_hash_v0>))
+            .ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("cn_dark_lite_slow_hash_v1").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(hashAsync<Core::Cryptography::cn_dark_lite_slow_hash_v1>))
+            .ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("cn_dark_lite_slow_hash_v2").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(hashAsync<Core::Cryptography::cn_dark_lite_slow_hash_v2>))
+            .ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("cn_turtle_slow_hash_v0").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(hashAsync<Core::Cryptography::cn_turtle_slow_hash_v0>))
+            .ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("cn_turtle_slow_hash_v1").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(hashAsync<Core::Cryptography::cn_turtle_slow_hash_v1>))
+            .ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("cn_turtle_slow_hash_v2").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(hashAsync<Core::Cryptography::cn_turtle_slow_hash_v2>))
+            .ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("cn_turtle_lite_slow_hash_v0").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(hashAsync<Core::Cryptography::cn_turtle_lite_slow_hash_v0>))
+            .ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("cn_turtle_lite_slow_hash_v1").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(hashAsync<Core::Cryptography::cn_turtle_lite_slow_hash_v1>))
+            .ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("cn_turtle_lite_slow_hash_v2").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(hashAsync<Core::Cryptography::cn_turtle_lite_slow_hash_v2>))
+            .ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("chukwa_slow_hash_base").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(chukwa_slow_hash_base_async)).ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("chukwa_slow_hash_v1").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(hashAsync<Core::Cryptography::chukwa_slow_hash_v1>))
+            .ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("chukwa_slow_hash_v2").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(hashAsync<Core::Cryptography::chukwa_slow_hash_v2>))
+            .ToLocalChecked());
+
+    /* Asynchronous Batch Operations */
+    Nan::Set(
+        asyncTarget,
+        Nan::New("generateKeyDerivations").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(generateKeyDerivationsAsync)).ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("derivePublicKeys").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(derivePublicKeysAsync)).ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("underivePublicKeys").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(underivePublicKeysAsync)).ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("generateKeyImages").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(generateKeyImagesAsync)).ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("checkSignaturesBatch").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(checkSignaturesBatchAsync)).ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("checkRingSignaturesBatch").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(checkRingSignaturesBatchAsync)).ToLocalChecked());
+
+    Nan::Set(
+        asyncTarget,
+        Nan::New("cn_fast_hashes").ToLocalChecked(),
+        Nan::GetFunction(Nan::New<v8::FunctionTemplate>(cn_fast_hashes_async)).ToLocalChecked());
+
+    Nan::Set(target, Nan::New("async").ToLocalChecked(), asyncTarget);
 }
 
 NODE_MODULE(turtlecoincrypto, InitModule);
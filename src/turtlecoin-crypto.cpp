@@ -74,6 +74,207 @@ namespace Core
         return Common::fromHex(input);
     }
 
+    /* Binary Hashing Methods */
+    void BinaryCryptography::cn_fast_hash(const void *data, const size_t length, Crypto::Hash &hash)
+    {
+        Crypto::cn_fast_hash(data, length, hash);
+    }
+
+    void BinaryCryptography::tree_hash(const Crypto::Hash *hashes, const size_t count, Crypto::Hash &hash)
+    {
+        Crypto::tree_hash(hashes, count, hash);
+    }
+
+    void BinaryCryptography::tree_branch(const Crypto::Hash *hashes, const size_t count, Crypto::Hash *branch)
+    {
+        Crypto::tree_branch(hashes, count, branch);
+    }
+
+    void BinaryCryptography::tree_hash_from_branch(
+        const Crypto::Hash *branches,
+        const size_t depth,
+        const Crypto::Hash &leaf,
+        const void *path,
+        Crypto::Hash &hash)
+    {
+        Crypto::tree_hash_from_branch(branches, depth, leaf, path, hash);
+    }
+
+    /* Binary Crypto Methods */
+    bool BinaryCryptography::checkRingSignature(
+        const Crypto::Hash &prefixHash,
+        const Crypto::KeyImage &keyImage,
+        const Crypto::PublicKey *publicKeys,
+        const Crypto::Signature *signatures,
+        const size_t count)
+    {
+        return Crypto::crypto_ops::checkRingSignature(prefixHash, keyImage, publicKeys, signatures, count);
+    }
+
+    void BinaryCryptography::generatePrivateViewKeyFromPrivateSpendKey(
+        const Crypto::SecretKey &privateSpendKey,
+        Crypto::SecretKey &privateViewKey)
+    {
+        Crypto::crypto_ops::generateViewFromSpend(privateSpendKey, privateViewKey);
+    }
+
+    void BinaryCryptography::generateViewKeysFromPrivateSpendKey(
+        const Crypto::SecretKey &privateSpendKey,
+        Crypto::SecretKey &privateViewKey,
+        Crypto::PublicKey &publicViewKey)
+    {
+        Crypto::crypto_ops::generateViewFromSpend(privateSpendKey, privateViewKey, publicViewKey);
+    }
+
+    void BinaryCryptography::generateKeys(Crypto::SecretKey &privateKey, Crypto::PublicKey &publicKey)
+    {
+        Crypto::generate_keys(publicKey, privateKey);
+    }
+
+    bool BinaryCryptography::checkKey(const Crypto::PublicKey &publicKey)
+    {
+        return Crypto::check_key(publicKey);
+    }
+
+    bool BinaryCryptography::secretKeyToPublicKey(const Crypto::SecretKey &privateKey, Crypto::PublicKey &publicKey)
+    {
+        return Crypto::secret_key_to_public_key(privateKey, publicKey);
+    }
+
+    bool BinaryCryptography::generateKeyDerivation(
+        const Crypto::PublicKey &publicKey,
+        const Crypto::SecretKey &privateKey,
+        Crypto::KeyDerivation &derivation)
+    {
+        return Crypto::generate_key_derivation(publicKey, privateKey, derivation);
+    }
+
+    bool BinaryCryptography::generateKeyDerivationScalar(
+        const Crypto::PublicKey &publicKey,
+        const Crypto::SecretKey &privateKey,
+        const uint64_t outputIndex,
+        Crypto::EllipticCurveScalar &derivationScalar)
+    {
+        Crypto::KeyDerivation derivation;
+
+        if (!Crypto::generate_key_derivation(publicKey, privateKey, derivation))
+        {
+            return false;
+        }
+
+        Crypto::derivation_to_scalar(derivation, outputIndex, derivationScalar);
+
+        return true;
+    }
+
+    void BinaryCryptography::derivationToScalar(
+        const Crypto::KeyDerivation &derivation,
+        const uint64_t outputIndex,
+        Crypto::EllipticCurveScalar &derivationScalar)
+    {
+        Crypto::derivation_to_scalar(derivation, outputIndex, derivationScalar);
+    }
+
+    bool BinaryCryptography::derivePublicKey(
+        const Crypto::KeyDerivation &derivation,
+        const uint64_t outputIndex,
+        const Crypto::PublicKey &publicKey,
+        Crypto::PublicKey &derivedKey)
+    {
+        return Crypto::derive_public_key(derivation, outputIndex, publicKey, derivedKey);
+    }
+
+    bool BinaryCryptography::derivePublicKey(
+        const Crypto::EllipticCurveScalar &derivationScalar,
+        const Crypto::PublicKey &publicKey,
+        Crypto::PublicKey &derivedKey)
+    {
+        return Crypto::derive_public_key(derivationScalar, publicKey, derivedKey);
+    }
+
+    void BinaryCryptography::deriveSecretKey(
+        const Crypto::KeyDerivation &derivation,
+        const uint64_t outputIndex,
+        const Crypto::SecretKey &privateKey,
+        Crypto::SecretKey &derivedKey)
+    {
+        Crypto::derive_secret_key(derivation, outputIndex, privateKey, derivedKey);
+    }
+
+    void BinaryCryptography::deriveSecretKey(
+        const Crypto::EllipticCurveScalar &derivationScalar,
+        const Crypto::SecretKey &privateKey,
+        Crypto::SecretKey &derivedKey)
+    {
+        Crypto::derive_secret_key(derivationScalar, privateKey, derivedKey);
+    }
+
+    bool BinaryCryptography::underivePublicKey(
+        const Crypto::KeyDerivation &derivation,
+        const uint64_t outputIndex,
+        const Crypto::PublicKey &derivedKey,
+        Crypto::PublicKey &publicKey)
+    {
+        return Crypto::underive_public_key(derivation, outputIndex, derivedKey, publicKey);
+    }
+
+    void BinaryCryptography::generateSignature(
+        const Crypto::Hash &prefixHash,
+        const Crypto::PublicKey &publicKey,
+        const Crypto::SecretKey &privateKey,
+        Crypto::Signature &signature)
+    {
+        Crypto::generate_signature(prefixHash, publicKey, privateKey, signature);
+    }
+
+    bool BinaryCryptography::checkSignature(
+        const Crypto::Hash &prefixHash,
+        const Crypto::PublicKey &publicKey,
+        const Crypto::Signature &signature)
+    {
+        return Crypto::check_signature(prefixHash, publicKey, signature);
+    }
+
+    void BinaryCryptography::generateKeyImage(
+        const Crypto::PublicKey &publicKey,
+        const Crypto::SecretKey &privateKey,
+        Crypto::KeyImage &keyImage)
+    {
+        Crypto::generate_key_image(publicKey, privateKey, keyImage);
+    }
+
+    void BinaryCryptography::scalarmultKey(
+        const Crypto::KeyImage &keyImageA,
+        const Crypto::KeyImage &keyImageB,
+        Crypto::KeyImage &keyImage)
+    {
+        keyImage = Crypto::scalarmultKey(keyImageA, keyImageB);
+    }
+
+    void BinaryCryptography::hashToEllipticCurve(const Crypto::Hash &hash, Crypto::PublicKey &ellipticCurve)
+    {
+        Crypto::hash_data_to_ec(hash.data, sizeof(hash.data), ellipticCurve);
+    }
+
+    void BinaryCryptography::scReduce32(Crypto::EllipticCurveScalar &scalar)
+    {
+        Crypto::scReduce32(scalar);
+    }
+
+    void BinaryCryptography::hashToScalar(const void *data, const size_t length, Crypto::EllipticCurveScalar &scalar)
+    {
+        Crypto::hashToScalar(data, length, scalar);
+    }
+
+    bool BinaryCryptography::generateDeterministicSubwalletKeys(
+        const Crypto::SecretKey &basePrivateKey,
+        const uint64_t walletIndex,
+        Crypto::SecretKey &privateKey,
+        Crypto::PublicKey &publicKey)
+    {
+        return Crypto::generate_deterministic_subwallet_keys(basePrivateKey, walletIndex, privateKey, publicKey);
+    }
+
     /* Hashing Methods */
     std::string Cryptography::cn_fast_hash(const std::string input)
     {
@@ -81,7 +282,7 @@ namespace Core
 
         Crypto::BinaryArray data = toBinaryArray(input);
 
-        Crypto::cn_fast_hash(data.data(), data.size(), hash);
+        BinaryCryptography::cn_fast_hash(data.data(), data.size(), hash);
 
         return Common::podToHex(hash);
     }
@@ -367,7 +568,7 @@ namespace Core
 
         Crypto::Hash treeHash = Crypto::Hash();
 
-        Crypto::tree_hash(treeHashes.data(), treeHashes.size(), treeHash);
+        BinaryCryptography::tree_hash(treeHashes.data(), treeHashes.size(), treeHash);
 
         return Common::podToHex(treeHash);
     }
@@ -380,7 +581,7 @@ namespace Core
 
         std::vector<Crypto::Hash> l_branches(tree_depth(l_hashes.size()));
 
-        Crypto::tree_branch(l_hashes.data(), l_hashes.size(), l_branches.data());
+        BinaryCryptography::tree_branch(l_hashes.data(), l_hashes.size(), l_branches.data());
 
         std::vector<std::string> branches;
 
@@ -410,11 +611,11 @@ namespace Core
 
             Common::podFromHex(path, l_path);
 
-            Crypto::tree_hash_from_branch(l_branches.data(), branches.size(), l_leaf, l_path.data, l_hash);
+            BinaryCryptography::tree_hash_from_branch(l_branches.data(), branches.size(), l_leaf, l_path.data, l_hash);
         }
         else
         {
-            Crypto::tree_hash_from_branch(l_branches.data(), branches.size(), l_leaf, 0, l_hash);
+            BinaryCryptography::tree_hash_from_branch(l_branches.data(), branches.size(), l_leaf, 0, l_hash);
         }
 
         return Common::podToHex(l_hash);
@@ -480,7 +681,13 @@ namespace Core
 
         toTypedVector(signatures, l_signatures);
 
-        return Crypto::crypto_ops::checkRingSignature(l_prefixHash, l_keyImage, l_publicKeys, l_signatures);
+        if (l_publicKeys.size() != l_signatures.size())
+        {
+            return false;
+        }
+
+        return BinaryCryptography::checkRingSignature(
+            l_prefixHash, l_keyImage, l_publicKeys.data(), l_signatures.data(), l_publicKeys.size());
     }
 
     std::string Cryptography::generatePrivateViewKeyFromPrivateSpendKey(const std::string privateSpendKey)
@@ -491,7 +698,7 @@ namespace Core
 
         Crypto::SecretKey privateViewKey = Crypto::SecretKey();
 
-        Crypto::crypto_ops::generateViewFromSpend(l_privateSpendKey, privateViewKey);
+        BinaryCryptography::generatePrivateViewKeyFromPrivateSpendKey(l_privateSpendKey, privateViewKey);
 
         return Common::podToHex(privateViewKey);
     }
@@ -509,7 +716,7 @@ namespace Core
 
         Crypto::PublicKey l_publicViewKey = Crypto::PublicKey();
 
-        Crypto::crypto_ops::generateViewFromSpend(l_privateSpendKey, l_privateViewKey, l_publicViewKey);
+        BinaryCryptography::generateViewKeysFromPrivateSpendKey(l_privateSpendKey, l_privateViewKey, l_publicViewKey);
 
         privateViewKey = Common::podToHex(l_privateViewKey);
 
@@ -522,7 +729,7 @@ namespace Core
 
         Crypto::PublicKey l_publicKey = Crypto::PublicKey();
 
-        Crypto::generate_keys(l_publicKey, l_privateKey);
+        BinaryCryptography::generateKeys(l_privateKey, l_publicKey);
 
         privateKey = Common::podToHex(l_privateKey);
 
@@ -535,7 +742,7 @@ namespace Core
 
         Common::podFromHex(publicKey, l_publicKey);
 
-        return Crypto::check_key(l_publicKey);
+        return BinaryCryptography::checkKey(l_publicKey);
     }
 
     bool Cryptography::secretKeyToPublicKey(const std::string privateKey, std::string &publicKey)
@@ -546,7 +753,7 @@ namespace Core
 
         Crypto::PublicKey l_publicKey = Crypto::PublicKey();
 
-        bool success = Crypto::secret_key_to_public_key(l_privateKey, l_publicKey);
+        bool success = BinaryCryptography::secretKeyToPublicKey(l_privateKey, l_publicKey);
 
         if (success)
         {
@@ -571,7 +778,7 @@ namespace Core
 
         Crypto::KeyDerivation l_derivation = Crypto::KeyDerivation();
 
-        bool success = Crypto::generate_key_derivation(l_publicKey, l_privateKey, l_derivation);
+        bool success = BinaryCryptography::generateKeyDerivation(l_publicKey, l_privateKey, l_derivation);
 
         if (success)
         {
@@ -586,14 +793,22 @@ namespace Core
         const std::string secretKey,
         const uint64_t outputIndex)
     {
-        std::string scalar = std::string();
+        Crypto::PublicKey l_publicKey = Crypto::PublicKey();
+
+        Common::podFromHex(publicKey, l_publicKey);
+
+        Crypto::SecretKey l_secretKey = Crypto::SecretKey();
+
+        Common::podFromHex(secretKey, l_secretKey);
 
-        if (generateKeyDerivation(publicKey, secretKey, scalar))
+        Crypto::EllipticCurveScalar l_derivationScalar;
+
+        if (!BinaryCryptography::generateKeyDerivationScalar(l_publicKey, l_secretKey, outputIndex, l_derivationScalar))
         {
-            scalar = derivationToScalar(scalar, outputIndex);
+            return std::string();
         }
 
-        return scalar;
+        return Common::podToHex(l_derivationScalar);
     }
 
     std::string Cryptography::derivationToScalar(const std::string derivation, const uint64_t outputIndex)
@@ -604,7 +819,7 @@ namespace Core
 
         Crypto::EllipticCurveScalar derivationScalar;
 
-        Crypto::derivation_to_scalar(l_derivation, outputIndex, derivationScalar);
+        BinaryCryptography::derivationToScalar(l_derivation, outputIndex, derivationScalar);
 
         return Common::podToHex(derivationScalar);
     }
@@ -625,7 +840,7 @@ namespace Core
 
         Crypto::PublicKey l_derivedKey = Crypto::PublicKey();
 
-        bool success = Crypto::derive_public_key(l_derivation, outputIndex, l_publicKey, l_derivedKey);
+        bool success = BinaryCryptography::derivePublicKey(l_derivation, outputIndex, l_publicKey, l_derivedKey);
 
         if (success)
         {
@@ -650,7 +865,7 @@ namespace Core
 
         Crypto::PublicKey l_derivedKey = Crypto::PublicKey();
 
-        bool success = Crypto::derive_public_key(l_derivationScalar, l_publicKey, l_derivedKey);
+        bool success = BinaryCryptography::derivePublicKey(l_derivationScalar, l_publicKey, l_derivedKey);
 
         if (success)
         {
@@ -675,7 +890,7 @@ namespace Core
 
         Crypto::SecretKey l_derivedKey = Crypto::SecretKey();
 
-        Crypto::derive_secret_key(l_derivation, outputIndex, l_privateKey, l_derivedKey);
+        BinaryCryptography::deriveSecretKey(l_derivation, outputIndex, l_privateKey, l_derivedKey);
 
         return Common::podToHex(l_derivedKey);
     }
@@ -692,7 +907,7 @@ namespace Core
 
         Crypto::SecretKey l_derivedKey = Crypto::SecretKey();
 
-        Crypto::derive_secret_key(l_derivationScalar, l_privateKey, l_derivedKey);
+        BinaryCryptography::deriveSecretKey(l_derivationScalar, l_privateKey, l_derivedKey);
 
         return Common::podToHex(l_derivedKey);
     }
@@ -713,7 +928,7 @@ namespace Core
 
         Crypto::PublicKey l_publicKey = Crypto::PublicKey();
 
-        bool success = Crypto::underive_public_key(l_derivation, outputIndex, l_derivedKey, l_publicKey);
+        bool success = BinaryCryptography::underivePublicKey(l_derivation, outputIndex, l_derivedKey, l_publicKey);
 
         if (success)
         {
@@ -742,7 +957,7 @@ namespace Core
 
         Crypto::Signature l_signature = Crypto::Signature();
 
-        Crypto::generate_signature(l_prefixHash, l_publicKey, l_privateKey, l_signature);
+        BinaryCryptography::generateSignature(l_prefixHash, l_publicKey, l_privateKey, l_signature);
 
         return Common::podToHex(l_signature);
     }
@@ -764,7 +979,7 @@ namespace Core
 
         Common::podFromHex(signature, l_signature);
 
-        return Crypto::check_signature(l_prefixHash, l_publicKey, l_signature);
+        return BinaryCryptography::checkSignature(l_prefixHash, l_publicKey, l_signature);
     }
 
     std::string Cryptography::generateKeyImage(const std::string publicKey, const std::string privateKey)
@@ -779,7 +994,7 @@ namespace Core
 
         Crypto::KeyImage l_keyImage = Crypto::KeyImage();
 
-        Crypto::generate_key_image(l_publicKey, l_privateKey, l_keyImage);
+        BinaryCryptography::generateKeyImage(l_publicKey, l_privateKey, l_keyImage);
 
         return Common::podToHex(l_keyImage);
     }
@@ -794,7 +1009,9 @@ namespace Core
 
         Common::podFromHex(keyImageB, l_keyImageB);
 
-        Crypto::KeyImage l_keyImage = Crypto::scalarmultKey(l_keyImageA, l_keyImageB);
+        Crypto::KeyImage l_keyImage = Crypto::KeyImage();
+
+        BinaryCryptography::scalarmultKey(l_keyImageA, l_keyImageB, l_keyImage);
 
         return Common::podToHex(l_keyImage);
     }
@@ -807,7 +1024,7 @@ namespace Core
 
         Crypto::PublicKey l_ellipticCurve = Crypto::PublicKey();
 
-        Crypto::hash_data_to_ec(l_hash.data, sizeof(l_hash.data), l_ellipticCurve);
+        BinaryCryptography::hashToEllipticCurve(l_hash, l_ellipticCurve);
 
         return Common::podToHex(l_ellipticCurve);
     }
@@ -818,7 +1035,7 @@ namespace Core
 
         Common::podFromHex(data, l_scalar);
 
-        Crypto::scReduce32(l_scalar);
+        BinaryCryptography::scReduce32(l_scalar);
 
         return Common::podToHex(l_scalar);
     }
@@ -829,7 +1046,7 @@ namespace Core
 
         Crypto::EllipticCurveScalar l_scalar;
 
-        Crypto::hashToScalar(l_hash.data(), l_hash.size(), l_scalar);
+        BinaryCryptography::hashToScalar(l_hash.data(), l_hash.size(), l_scalar);
 
         return Common::podToHex(l_scalar);
     }
@@ -848,7 +1065,8 @@ namespace Core
 
         Crypto::PublicKey l_publicKey;
 
-        if (Crypto::generate_deterministic_subwallet_keys(l_basePrivateKey, walletIndex, l_privateKey, l_publicKey))
+        if (BinaryCryptography::generateDeterministicSubwalletKeys(
+                l_basePrivateKey, walletIndex, l_privateKey, l_publicKey))
         {
             privateKey = Common::podToHex(l_privateKey);
 
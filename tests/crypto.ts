@@ -921,6 +921,224 @@ describe('Hash Generation Methods', function () {
     });
 });
 
+describe('Batch Operations', function () {
+    const hex = (buffer: Buffer, size: number, index: number): string =>
+        buffer.slice(index * size, (index + 1) * size).toString('hex');
+
+    const pack = (values: string[]): Buffer => Buffer.concat(values.map(value => Buffer.from(value, 'hex')));
+
+    const prefixHash = 'b542df5b6e7f5f05275c98e7345884e2ac726aeeb07e03e44e0389eb86cd05f0';
+
+    const keyImage = '6865866ed8a25824e042e21dd36e946836b58b03366e489aecf979f444f599b0';
+
+    const inputKeys = [
+        '492390897da1cabd3886e3eff43ad1d04aa510a905bec0acd31a0a2f260e7862',
+        '7644ccb5410cca2be18b033e5f7497aeeeafd1d8f317f29cba4803e4306aa402',
+        'bb9a956ffdf8159ad69474e6b0811316c44a17a540d5e39a44642d4d933a6460',
+        'e1cd9ccdfdf2b3a45ac2cfd1e29185d22c185742849f52368c3cdd1c0ce499c0'
+    ];
+
+    const privateEphemeral = '73a8e577d58f7c11992201d4014ac7eef39c1e9f6f6d78673103de60a0c3240b';
+
+    const txKeys: string[] = [];
+
+    const viewKeys = {
+        public_key: '',
+        private_key: ''
+    };
+
+    const spendKeys = {
+        public_key: '',
+        private_key: ''
+    };
+
+    let ringSignatures: string[] = [];
+
+    before(async function () {
+        /* The batch methods are only exported by the Node.js native addon */
+        if (!TurtleCoinCrypto.isNative) {
+            this.skip();
+        }
+
+        for (let i = 0; i < 3; i++) {
+            txKeys.push((await TurtleCoinCrypto.generateKeys()).public_key);
+        }
+
+        Object.assign(viewKeys, await TurtleCoinCrypto.generateKeys());
+
+        Object.assign(spendKeys, await TurtleCoinCrypto.generateKeys());
+
+        ringSignatures = await TurtleCoinCrypto.generateRingSignatures(
+            prefixHash, keyImage, inputKeys, privateEphemeral, 3);
+    });
+
+    it('Generate Key Derivations', async () => {
+        const derivations = await TurtleCoinCrypto.generateKeyDerivations(
+            pack(txKeys), pack([viewKeys.private_key]));
+
+        assert(derivations.length === txKeys.length * 32);
+
+        for (let i = 0; i < txKeys.length; i++) {
+            const derivation = await TurtleCoinCrypto.generateKeyDerivation(txKeys[i], viewKeys.private_key);
+
+            assert(hex(derivations, 32, i) === derivation);
+        }
+    });
+
+    it('Derive and Underive Public Keys', async () => {
+        const derivations = await TurtleCoinCrypto.generateKeyDerivations(
+            pack(txKeys), pack([viewKeys.private_key]));
+
+        const outputKeys = await TurtleCoinCrypto.derivePublicKeys(
+            derivations, [0, 1, 2], pack([spendKeys.public_key]));
+
+        const underived = await TurtleCoinCrypto.underivePublicKeys(
+            derivations, new Uint32Array([0, 1, 2]), outputKeys);
+
+        for (let i = 0; i < txKeys.length; i++) {
+            const outputKey = await TurtleCoinCrypto.derivePublicKey(
+                hex(derivations, 32, i), i, spendKeys.public_key);
+
+            assert(hex(outputKeys, 32, i) === outputKey);
+
+            assert(hex(underived, 32, i) === await TurtleCoinCrypto.underivePublicKey(
+                hex(derivations, 32, i), i, outputKey));
+
+            assert(hex(underived, 32, i) === spendKeys.public_key);
+        }
+    });
+
+    it('Generate Key Images', async () => {
+        const keys = [];
+
+        for (let i = 0; i < 3; i++) {
+            keys.push(await TurtleCoinCrypto.generateKeys());
+        }
+
+        const keyImages = await TurtleCoinCrypto.generateKeyImages(
+            pack(keys.map(key => key.public_key)), pack(keys.map(key => key.private_key)));
+
+        for (let i = 0; i < keys.length; i++) {
+            const keyImage = await TurtleCoinCrypto.generateKeyImage(keys[i].public_key, keys[i].private_key);
+
+            assert(hex(keyImages, 32, i) === keyImage);
+        }
+    });
+
+    it('Check Signatures', async () => {
+        const keys = [viewKeys, spendKeys];
+
+        const signatures = [];
+
+        for (const key of keys) {
+            signatures.push(await TurtleCoinCrypto.generateSignature(prefixHash, key.public_key, key.private_key));
+        }
+
+        /* The first key did not make the second signature */
+        const results = await TurtleCoinCrypto.checkSignaturesBatch(
+            pack([prefixHash]),
+            pack([viewKeys.public_key, spendKeys.public_key, viewKeys.public_key]),
+            pack([signatures[0], signatures[1], signatures[1]]));
+
+        assert.deepStrictEqual([...results], [1, 1, 0]);
+
+        assert(await TurtleCoinCrypto.checkSignature(prefixHash, viewKeys.public_key, signatures[0]));
+
+        assert(!await TurtleCoinCrypto.checkSignature(prefixHash, viewKeys.public_key, signatures[1]));
+    });
+
+    it('Check Ring Signatures', async () => {
+        const tampered = ringSignatures.slice();
+
+        tampered[1] = ringSignatures[0];
+
+        const results = await TurtleCoinCrypto.checkRingSignaturesBatch(
+            pack([prefixHash]),
+            pack([keyImage]),
+            pack(inputKeys.concat(inputKeys)),
+            pack(ringSignatures.concat(tampered)),
+            [inputKeys.length, inputKeys.length]);
+
+        assert.deepStrictEqual([...results], [1, 0]);
+
+        assert(await TurtleCoinCrypto.checkRingSignatures(prefixHash, keyImage, inputKeys, ringSignatures));
+
+        assert(!await TurtleCoinCrypto.checkRingSignatures(prefixHash, keyImage, inputKeys, tampered));
+    });
+
+    it('Check Ring Signatures - User Override', async () => {
+        /* A user-defined primitive for single rings must not be handed the packed batch */
+        TurtleCoinCrypto.userCryptoFunctions = {
+            checkRingSignatures: () => Promise.resolve(true),
+            checkRingSignaturesBatch: () => Promise.resolve(true)
+        };
+
+        try {
+            const results = await TurtleCoinCrypto.checkRingSignaturesBatch(
+                pack([prefixHash]),
+                pack([keyImage]),
+                pack(inputKeys),
+                pack(ringSignatures.slice(0, 1).concat(ringSignatures.slice(0, 3))),
+                inputKeys.length);
+
+            assert(Buffer.isBuffer(results));
+
+            assert.deepStrictEqual([...results], [0]);
+        } finally {
+            TurtleCoinCrypto.userCryptoFunctions = {
+                checkRingSignatures: undefined,
+                checkRingSignaturesBatch: undefined
+            };
+        }
+    });
+
+    it('Hash Records', async () => {
+        const testdata =
+            '0100fb8e8ac805899323371bb790db19218afd8db8e3755d8b90f39b3d5506a9' +
+            'abce4fa912244500000000ee8146d49fa93ee724deb57d12cbc6c6f3b924d946' +
+            '127c7a97418f9348828f0f02';
+
+        const hashes = await TurtleCoinCrypto.cn_fast_hashes(pack([testdata, testdata]), testdata.length / 2);
+
+        assert(hashes.length === 64);
+
+        assert(hex(hashes, 32, 0) === await TurtleCoinCrypto.cn_fast_hash(testdata));
+
+        assert(hex(hashes, 32, 1) === 'b542df5b6e7f5f05275c98e7345884e2ac726aeeb07e03e44e0389eb86cd05f0');
+    });
+
+    it('Mismatched Record Counts', async () => {
+        await assert.rejects(TurtleCoinCrypto.generateKeyDerivations(
+            pack(txKeys), pack([viewKeys.private_key, spendKeys.private_key])));
+
+        await assert.rejects(TurtleCoinCrypto.derivePublicKeys(
+            pack(txKeys.slice(0, 2)), [0, 1, 2], pack([spendKeys.public_key])));
+
+        await assert.rejects(TurtleCoinCrypto.checkSignaturesBatch(
+            pack([prefixHash, prefixHash]), pack(txKeys), Buffer.alloc(3 * 64)));
+
+        await assert.rejects(TurtleCoinCrypto.cn_fast_hashes(Buffer.alloc(65), 32));
+    });
+
+    it('Mismatched Ring Sizes', async () => {
+        /* The ring sizes add up to fewer keys and signatures than were packed */
+        await assert.rejects(TurtleCoinCrypto.checkRingSignaturesBatch(
+            pack([prefixHash]),
+            pack([keyImage]),
+            pack(inputKeys.concat(inputKeys)),
+            pack(ringSignatures.concat(ringSignatures)),
+            [inputKeys.length, inputKeys.length - 1]));
+
+        /* The keys match the ring size, but the signatures do not */
+        await assert.rejects(TurtleCoinCrypto.checkRingSignaturesBatch(
+            pack([prefixHash]),
+            pack([keyImage]),
+            pack(inputKeys),
+            pack(ringSignatures.slice(0, 3)),
+            inputKeys.length));
+    });
+});
+
 describe('Test use of user crypto', async () => {
     const cn_fast_hash = (data: string): Promise<string> => {
         let hash: string;
@@ -2,18 +2,31 @@
 //
 // Please see the included LICENSE file for more information.
 
+#include <algorithm>
 #include <assert.h>
+#include <chacha20.h>
 #include <chrono>
 #include <cxxopts.hpp>
 #include <iostream>
+#include <random.h>
+#include <slow-hash-pool.h>
+#include <thread>
+#include <tree-hash-accumulator.h>
 #include <turtlecoin-crypto.h>
 
+extern "C"
+{
+#include <ed25519.h>
+}
+
 #define PERFORMANCE_ITERATIONS 1000
 #define PERFORMANCE_ITERATIONS_LONG_MULTIPLIER 10
 
 const std::string INPUT_DATA = "0100fb8e8ac805899323371bb790db19218afd8db8e3755d8b90f39b3d5506a9abce4fa912244500000000e"
                                "e8146d49fa93ee724deb57d12cbc6c6f3b924d946127c7a97418f9348828f0f02";
 
+const std::string TREE_HASH_1000 = "8039c0e21de5a8e867dc6ca6e87b9603e92abd6e431d4b6ec7b0c9ee72545f6d";
+
 const std::string CN_FAST_HASH = "b542df5b6e7f5f05275c98e7345884e2ac726aeeb07e03e44e0389eb86cd05f0";
 
 const std::string CN_SLOW_HASH_V0 = "1b606a3f4a07d6489a1bcd07697bd16696b61c8ae982f61a90160f4e52828a7f";
@@ -97,180 +110,1493 @@ const std::string CN_SOFT_SHELL_V2[] = {"b2172ec9466e1aee70ec8572a14c233ee354582
                                         "b2623a2b041dc5ae3132b964b75e193558c7095e725d882a3946aae172179cf1",
                                         "b2172ec9466e1aee70ec8572a14c233ee354582bcb93f869d429744de5726a26"};
 
-static inline bool CompareHashes(const std::string left, const std::string right)
-{
-    return (left == right);
+static inline bool CompareHashes(const std::string left, const std::string right)
+{
+    return (left == right);
+}
+
+/* Check if we're testing a v1 or v2 hash function */
+/* Hacky as fuck lmao */
+bool need43BytesOfData(std::string hashFunctionName)
+{
+    return (hashFunctionName.find("v1") != std::string::npos || hashFunctionName.find("v2") != std::string::npos);
+}
+
+/* Bit of hackery so we can get the variable name of the passed in function.
+   This way we can print the test we are currently performing. */
+#define TEST_HASH_FUNCTION(hashFunction, expectedOutput) \
+    testHashFunction(hashFunction, expectedOutput, #hashFunction, -1)
+
+#define TEST_HASH_FUNCTION_WITH_HEIGHT(hashFunction, expectedOutput, height) \
+    testHashFunction(hashFunction, expectedOutput, #hashFunction, height, height)
+
+template<typename T, typename... Args>
+void testHashFunction(
+    T hashFunction,
+    std::string expectedOutput,
+    std::string hashFunctionName,
+    int64_t height,
+    Args &&... args)
+{
+    if (need43BytesOfData(hashFunctionName) && INPUT_DATA.size() < 43)
+    {
+        return;
+    }
+
+    /* Perform the hash, with a height if given */
+    std::string hash = hashFunction(INPUT_DATA, std::forward<Args>(args)...);
+
+    if (height == -1)
+    {
+        std::cout << hashFunctionName << ": " << hash << std::endl;
+    }
+    else
+    {
+        std::cout << hashFunctionName << " (" << height << "): " << hash << std::endl;
+    }
+
+    /* Verify the hash is as expected */
+    if (!CompareHashes(hash, expectedOutput))
+    {
+        std::cout << "Hashes are not equal!\n"
+                  << "Expected: " << expectedOutput << "\nActual: " << hash << "\nTerminating.";
+
+        exit(1);
+    }
+}
+
+/* Bit of hackery so we can get the variable name of the passed in function.
+   This way we can print the test we are currently performing. */
+#define BENCHMARK(hashFunction, iterations) benchmark(hashFunction, #hashFunction, iterations)
+
+template<typename T> void benchmark(T hashFunction, std::string hashFunctionName, uint64_t iterations)
+{
+    if (need43BytesOfData(hashFunctionName) && INPUT_DATA.size() < 43)
+    {
+        return;
+    }
+
+    auto startTimer = std::chrono::high_resolution_clock::now();
+
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        std::string hash = hashFunction(INPUT_DATA);
+    }
+
+    auto elapsedTime = std::chrono::high_resolution_clock::now() - startTimer;
+
+    std::cout << hashFunctionName << ": "
+              << (iterations / std::chrono::duration_cast<std::chrono::seconds>(elapsedTime).count()) << " H/s\n";
+}
+
+void benchmarkUnderivePublicKey()
+{
+    std::string txPublicKey = "f235acd76ee38ec4f7d95123436200f9ed74f9eb291b1454fbc30742481be1ab";
+
+    std::string privateViewKey = "89df8c4d34af41a51cfae0267e8254cadd2298f9256439fa1cfa7e25ee606606";
+
+    std::string derivation;
+
+    bool success = Core::Cryptography::generateKeyDerivation(txPublicKey, privateViewKey, derivation);
+
+    const uint64_t loopIterations = 600000;
+
+    auto startTimer = std::chrono::high_resolution_clock::now();
+
+    std::string outputKey = "4a078e76cd41a3d3b534b83dc6f2ea2de500b653ca82273b7bfad8045d85a400";
+
+    for (uint64_t i = 0; i < loopIterations; i++)
+    {
+        std::string spendKey;
+
+        /* Use i as output index to prevent optimization */
+        bool success = Core::Cryptography::underivePublicKey(derivation, i, outputKey, spendKey);
+    }
+
+    auto elapsedTime = std::chrono::high_resolution_clock::now() - startTimer;
+
+    /* Need to use microseconds here then divide by 1000 - otherwise we'll just get '0' */
+    const auto timePerDerivation =
+        std::chrono::duration_cast<std::chrono::microseconds>(elapsedTime).count() / loopIterations;
+
+    std::cout << "Time to perform underivePublicKey: " << timePerDerivation / 1000.0 << " ms" << std::endl;
+}
+
+void benchmarkGenerateKeyDerivation()
+{
+    std::string txPublicKey = "f235acd76ee38ec4f7d95123436200f9ed74f9eb291b1454fbc30742481be1ab";
+
+    std::string privateViewKey = "89df8c4d34af41a51cfae0267e8254cadd2298f9256439fa1cfa7e25ee606606";
+
+    const uint64_t loopIterations = 60000;
+
+    auto startTimer = std::chrono::high_resolution_clock::now();
+
+    for (uint64_t i = 0; i < loopIterations; i++)
+    {
+        std::string derivation;
+
+        bool success = Core::Cryptography::generateKeyDerivation(txPublicKey, privateViewKey, derivation);
+    }
+
+    auto elapsedTime = std::chrono::high_resolution_clock::now() - startTimer;
+
+    const auto timePerDerivation =
+        std::chrono::duration_cast<std::chrono::microseconds>(elapsedTime).count() / loopIterations;
+
+    std::cout << "Time to perform generateKeyDerivation: " << timePerDerivation / 1000.0 << " ms" << std::endl;
+}
+
+void TestDeterministicSubwalletCreation(
+    const std::string baseSpendKey,
+    const uint64_t subWalletIndex,
+    const std::string expectedSpendKey)
+{
+    Crypto::SecretKey f_baseSpendKey;
+
+    if (!Common::podFromHex(baseSpendKey, f_baseSpendKey))
+    {
+        std::cout << "Could not decode base private spend key!\nTerminating...";
+
+        exit(1);
+    }
+
+    Crypto::SecretKey f_expectedSpendKey;
+
+    if (!Common::podFromHex(expectedSpendKey, f_expectedSpendKey))
+    {
+        std::cout << "Could not decode expected private spend key!\nTerminating...";
+
+        exit(1);
+    }
+
+    Crypto::SecretKey subwalletPrivateKey;
+
+    Crypto::PublicKey subwalletPublicKey;
+
+    Crypto::generate_deterministic_subwallet_keys(
+        f_baseSpendKey, subWalletIndex, subwalletPrivateKey, subwalletPublicKey);
+
+    if (subwalletPrivateKey != f_expectedSpendKey)
+    {
+        std::cout << "Could not deterministically create subwallet spend keys!\n"
+                  << "Expected: " << expectedSpendKey << "\nActual: " << subwalletPrivateKey << "\nTerminating.";
+
+        exit(1);
+    }
+}
+
+void TestDeterministicSubwalletRange(const std::string baseSpendKey)
+{
+    Crypto::SecretKey f_baseSpendKey;
+
+    Common::podFromHex(baseSpendKey, f_baseSpendKey);
+
+    std::vector<Crypto::SecretKey> privateKeys;
+
+    std::vector<Crypto::PublicKey> publicKeys;
+
+    std::vector<Crypto::SecretKey> morePrivateKeys;
+
+    std::vector<Crypto::PublicKey> morePublicKeys;
+
+    /* Generate 0..69 in two runs, resuming the second from the first's checkpoint */
+    Crypto::SubwalletKeysCheckpoint checkpoint;
+
+    bool success = Crypto::generate_deterministic_subwallet_keys(
+                       f_baseSpendKey, 0, 40, privateKeys, publicKeys, &checkpoint, 2)
+                   && checkpoint.nextSubwalletIndex == 40
+                   && Crypto::crypto_ops::generate_deterministic_subwallet_keys(
+                       f_baseSpendKey, checkpoint, 30, morePrivateKeys, morePublicKeys, 3)
+                   && checkpoint.nextSubwalletIndex == 70;
+
+    privateKeys.insert(privateKeys.end(), morePrivateKeys.begin(), morePrivateKeys.end());
+
+    publicKeys.insert(publicKeys.end(), morePublicKeys.begin(), morePublicKeys.end());
+
+    for (uint64_t i = 0; success && i < privateKeys.size(); i++)
+    {
+        Crypto::SecretKey privateKey;
+
+        Crypto::PublicKey publicKey;
+
+        Crypto::generate_deterministic_subwallet_keys(f_baseSpendKey, i, privateKey, publicKey);
+
+        success = privateKeys[i] == privateKey && publicKeys[i] == publicKey;
+    }
+
+    if (!success)
+    {
+        std::cout << "Could not deterministically create a range of subwallet keys!\nTerminating.";
+
+        exit(1);
+    }
+}
+
+void TestSlowHashBatch(
+    const std::string name,
+    const int light,
+    const int variant,
+    const uint64_t pageSize,
+    const uint64_t scratchpad,
+    const uint64_t iterations)
+{
+    /* An odd count makes sure the groups of 4, 2 and the single remainder are all exercised */
+    const size_t count = 7;
+
+    std::vector<std::vector<uint8_t>> inputs(count, Common::fromHex(INPUT_DATA));
+
+    std::vector<const void *> data;
+
+    std::vector<size_t> lengths;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        /* Vary the nonce so that each lane hashes something different */
+        inputs[i][39] = static_cast<uint8_t>(i);
+
+        data.push_back(inputs[i].data());
+
+        lengths.push_back(inputs[i].size());
+    }
+
+    std::vector<Crypto::Hash> hashes(count);
+
+    Crypto::cn_slow_hash_batch(
+        data.data(), lengths.data(), count, hashes.data(), light, variant, pageSize, scratchpad, iterations);
+
+    std::cout << name << ": ";
+
+    for (size_t i = 0; i < count; i++)
+    {
+        Crypto::Hash expected;
+
+        Crypto::cn_slow_hash(
+            data[i],
+            lengths[i],
+            reinterpret_cast<char *>(&expected),
+            light,
+            variant,
+            0,
+            pageSize,
+            scratchpad,
+            iterations);
+
+        if (hashes[i] != expected)
+        {
+            std::cout << "failed" << std::endl;
+
+            exit(1);
+        }
+    }
+
+    std::cout << "passed" << std::endl;
+}
+
+void benchmarkSlowHashBatch(uint64_t iterations)
+{
+    std::vector<uint8_t> input = Common::fromHex(INPUT_DATA);
+
+    const size_t count = 8;
+
+    std::vector<const void *> data(count, input.data());
+
+    std::vector<size_t> lengths(count, input.size());
+
+    std::vector<Crypto::Hash> hashes(count);
+
+    auto startTimer = std::chrono::high_resolution_clock::now();
+
+    for (uint64_t i = 0; i < iterations; i += count)
+    {
+        Crypto::cn_slow_hash_batch(
+            data.data(),
+            lengths.data(),
+            count,
+            hashes.data(),
+            0,
+            2,
+            CN_TURTLE_PAGE_SIZE,
+            CN_TURTLE_SCRATCHPAD,
+            CN_TURTLE_ITERATIONS);
+    }
+
+    auto elapsedTime = std::chrono::high_resolution_clock::now() - startTimer;
+
+    std::cout << "Crypto::cn_slow_hash_batch (turtle v2): "
+              << (iterations / std::chrono::duration_cast<std::chrono::seconds>(elapsedTime).count()) << " H/s\n";
+}
+
+void benchmarkTreeHash()
+{
+    for (size_t count = 1000; count <= 1000000; count *= 10)
+    {
+        std::vector<Crypto::Hash> hashes(count);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            Crypto::cn_fast_hash(&i, sizeof(i), hashes[i]);
+        }
+
+        std::vector<Crypto::Hash> scratch(Crypto::tree_hash_scratch_size(count));
+
+        Crypto::Hash root;
+
+        const size_t loopIterations = 10000000 / count;
+
+        auto startTimer = std::chrono::high_resolution_clock::now();
+
+        for (size_t i = 0; i < loopIterations; i++)
+        {
+            Crypto::tree_hash_with_scratch(hashes.data(), count, scratch.data(), root);
+        }
+
+        auto elapsedTime = std::chrono::high_resolution_clock::now() - startTimer;
+
+        const auto elapsedMicroseconds = std::chrono::duration_cast<std::chrono::microseconds>(elapsedTime).count();
+
+        const auto leavesPerSecond = (loopIterations * count * 1000000) / elapsedMicroseconds;
+
+        std::cout << "Crypto::tree_hash_with_scratch (" << count << " leaves): " << leavesPerSecond << " leaves/s\n";
+    }
+}
+
+void TestTreeHash()
+{
+    std::cout << "Crypto::tree_hash: ";
+
+    std::vector<Crypto::Hash> hashes(1025);
+
+    for (size_t i = 0; i < hashes.size(); i++)
+    {
+        Crypto::cn_fast_hash(&i, sizeof(i), hashes[i]);
+    }
+
+    Crypto::Hash root;
+
+    Crypto::tree_hash(hashes.data(), 1000, root);
+
+    if (!CompareHashes(Common::podToHex(root), TREE_HASH_1000))
+    {
+        std::cout << "failed" << std::endl;
+
+        exit(1);
+    }
+
+    /* Counts either side of the powers of two and of the batch size */
+    for (size_t count : {1, 2, 3, 4, 5, 63, 64, 65, 127, 128, 129, 1024, 1025})
+    {
+        std::vector<Crypto::Hash> scratch(Crypto::tree_hash_scratch_size(count));
+
+        const size_t depth = Crypto::tree_depth(count);
+
+        std::vector<Crypto::Hash> branch(depth);
+
+        Crypto::Hash expected;
+
+        Crypto::Hash fromScratch;
+
+        Crypto::Hash fromBranch;
+
+        Crypto::tree_hash(hashes.data(), count, expected);
+
+        Crypto::tree_hash_with_scratch(hashes.data(), count, scratch.data(), fromScratch);
+
+        Crypto::tree_branch_with_scratch(hashes.data(), count, scratch.data(), branch.data());
+
+        /* The branch is of the first leaf, which takes the left side at every level */
+        Crypto::tree_hash_from_branch(branch.data(), depth, hashes[0], nullptr, fromBranch);
+
+        if (fromScratch != expected || fromBranch != expected)
+        {
+            std::cout << "failed" << std::endl;
+
+            exit(1);
+        }
+    }
+
+    std::cout << "passed" << std::endl;
+}
+
+void TestTreeHashAccumulator()
+{
+    std::cout << "Crypto::TreeHashAccumulator: ";
+
+    std::vector<Crypto::Hash> hashes(600);
+
+    for (size_t i = 0; i < hashes.size(); i++)
+    {
+        Crypto::cn_fast_hash(&i, sizeof(i), hashes[i]);
+    }
+
+    Crypto::TreeHashAccumulator accumulator;
+
+    /* The root has to match after every append, as the pairing of the leaves changes each time */
+    for (size_t count = 1; count <= hashes.size(); count++)
+    {
+        accumulator.append(hashes[count - 1]);
+
+        Crypto::Hash expected;
+
+        Crypto::tree_hash(hashes.data(), count, expected);
+
+        if (accumulator.root() != expected)
+        {
+            std::cout << "failed" << std::endl;
+
+            exit(1);
+        }
+    }
+
+    const Crypto::TreeHashAccumulator fromVector(hashes);
+
+    if (fromVector.root() != accumulator.root() || fromVector.leaves() != hashes)
+    {
+        std::cout << "failed" << std::endl;
+
+        exit(1);
+    }
+
+    std::cout << "passed" << std::endl;
+}
+
+void TestChukwaContext()
+{
+    std::cout << "Crypto::ChukwaContext: ";
+
+    const std::vector<uint8_t> input = Common::fromHex(INPUT_DATA);
+
+    /* Start small so that the v2 hash has to grow the memory, then reuse it for v1 */
+    Crypto::ChukwaContext context(CHUKWA_MEMORY_V1, CHUKWA_THREADS_V1, true);
+
+    Crypto::Hash v1;
+
+    Crypto::Hash v2;
+
+    Crypto::Hash v1Again;
+
+    /* Selection only happens once, later requests just report what is in use */
+    const std::string implementation = Crypto::select_argon2_optimization();
+
+    if (implementation != Crypto::select_argon2_optimization("AVX-512F") || argon2_force_impl("bogus") == 0
+        || implementation != argon2_selected_impl_name())
+    {
+        std::cout << "failed" << std::endl;
+
+        exit(1);
+    }
+
+    if (!context.hash_v1(input.data(), input.size(), v1) || !context.hash_v2(input.data(), input.size(), v2)
+        || !context.hash_v1(input.data(), input.size(), v1Again) || !CompareHashes(Common::podToHex(v1), CHUKWA_V1)
+        || !CompareHashes(Common::podToHex(v2), CHUKWA_V2) || v1 != v1Again)
+    {
+        std::cout << "failed" << std::endl;
+
+        exit(1);
+    }
+
+    std::cout << "passed" << std::endl;
+}
+
+void TestSlowHashPool()
+{
+    std::cout << "Crypto::SlowHashPool: ";
+
+    const std::vector<uint8_t> input = Common::fromHex(INPUT_DATA);
+
+    std::vector<Crypto::SlowHashJob> jobs;
+
+    std::vector<std::string> expected;
+
+    for (uint64_t height = 0; height <= 8192; height += 512)
+    {
+        jobs.push_back({input, Crypto::SlowHashAlgorithm::CN_SOFT_SHELL_V2, height});
+
+        expected.push_back(CN_SOFT_SHELL_V2[height / 512]);
+
+        jobs.push_back({input, Crypto::SlowHashAlgorithm::CN_TURTLE_LITE_V2, height});
+
+        expected.push_back(CN_TURTLE_LITE_SLOW_HASH_V2);
+
+        jobs.push_back({input, Crypto::SlowHashAlgorithm::CN_TURTLE_LITE_V2, height});
+
+        expected.push_back(CN_TURTLE_LITE_SLOW_HASH_V2);
+    }
+
+    jobs.push_back({input, Crypto::SlowHashAlgorithm::CN_LITE_V1, 0});
+
+    expected.push_back(CN_LITE_SLOW_HASH_V1);
+
+    jobs.push_back({input, Crypto::SlowHashAlgorithm::CHUKWA_V2, 0});
+
+    expected.push_back(CHUKWA_V2);
+
+    Crypto::SlowHashPool pool(4);
+
+    std::vector<Crypto::Hash> results = pool.hash(jobs, 3).get();
+
+    for (size_t i = 0; i < jobs.size(); i++)
+    {
+        if (!CompareHashes(Common::podToHex(results[i]), expected[i]))
+        {
+            std::cout << "failed" << std::endl;
+
+            exit(1);
+        }
+    }
+
+    /* Even an empty batch completes on a worker thread rather than the caller's */
+    std::promise<std::thread::id> emptyDone;
+
+    pool.hash({}, [&emptyDone](std::vector<Crypto::Hash> hashes) {
+        emptyDone.set_value(hashes.empty() ? std::this_thread::get_id() : std::thread::id());
+    });
+
+    const std::thread::id emptyThread = emptyDone.get_future().get();
+
+    if (emptyThread == std::thread::id() || emptyThread == std::this_thread::get_id()
+        || !pool.hash({}).get().empty())
+    {
+        std::cout << "failed" << std::endl;
+
+        exit(1);
+    }
+
+    /* Destroying a pool still completes the batches queued on it */
+    std::vector<std::future<std::vector<Crypto::Hash>>> pending;
+
+    size_t callbacks = 0;
+
+    {
+        Crypto::SlowHashPool single(1);
+
+        for (size_t i = 0; i < 4; i++)
+        {
+            pending.push_back(single.hash({jobs.back()}));
+
+            /* A single worker runs the callbacks one after the other */
+            single.hash({jobs.back()}, [&callbacks](std::vector<Crypto::Hash>) { callbacks++; });
+        }
+    }
+
+    try
+    {
+        for (auto &future : pending)
+        {
+            if (!CompareHashes(Common::podToHex(future.get().at(0)), expected.back()))
+            {
+                callbacks = 0;
+            }
+        }
+    }
+    catch (const std::future_error &)
+    {
+        callbacks = 0;
+    }
+
+    if (callbacks != 4)
+    {
+        std::cout << "failed" << std::endl;
+
+        exit(1);
+    }
+
+    std::cout << "passed" << std::endl;
+}
+
+void TestFastHashBatch()
+{
+    std::cout << "Crypto::cn_fast_hash_batch: ";
+
+    /* Lengths either side of the 136 byte rate, in odd sized batches so that the
+       final group of states is only partly filled */
+    std::vector<std::vector<uint8_t>> messages;
+
+    for (size_t length = 0; length < 300; length += 7)
+    {
+        std::vector<uint8_t> message(length);
+
+        for (size_t i = 0; i < length; i++)
+        {
+            message[i] = static_cast<uint8_t>(i * 31 + length);
+        }
+
+        messages.push_back(message);
+    }
+
+    messages.push_back(std::vector<uint8_t>(136, 0xaa));
+
+    messages.push_back(Common::fromHex(INPUT_DATA));
+
+    std::vector<const void *> data;
+
+    std::vector<size_t> lengths;
+
+    for (const auto &message : messages)
+    {
+        data.push_back(message.data());
+
+        lengths.push_back(message.size());
+    }
+
+    for (size_t count : {size_t(1), size_t(3), size_t(8), size_t(11), messages.size()})
+    {
+        std::vector<Crypto::Hash> hashes(count);
+
+        const size_t first = messages.size() - count;
+
+        Crypto::cn_fast_hash_batch(data.data() + first, lengths.data() + first, count, hashes.data());
+
+        for (size_t i = 0; i < count; i++)
+        {
+            if (hashes[i] != Crypto::cn_fast_hash(data[first + i], lengths[first + i]))
+            {
+                std::cout << "failed" << std::endl;
+
+                exit(1);
+            }
+        }
+    }
+
+    std::cout << "passed" << std::endl;
+}
+
+void TestFastHashIov()
+{
+    std::cout << "Crypto::cn_fast_hash_iov: ";
+
+    std::vector<uint8_t> message(1000);
+
+    for (size_t i = 0; i < message.size(); i++)
+    {
+        message[i] = static_cast<uint8_t>(i * 13 + 5);
+    }
+
+    /* Splits that land on, inside and across the 136 byte blocks, including empty pieces */
+    const std::vector<std::vector<size_t>> splits = {
+        {}, {0}, {1000}, {136, 864}, {1, 135, 0, 136, 728}, {7, 300, 2, 2, 689}, {135, 2, 135, 728}};
+
+    for (const auto &split : splits)
+    {
+        std::vector<Crypto::hash_iovec> iov;
+
+        size_t offset = 0;
+
+        for (const auto length : split)
+        {
+            iov.push_back({message.data() + offset, length});
+
+            offset += length;
+        }
+
+        /* cn_fast_hash keeps the first 32 bytes of the full Keccak state */
+        uint8_t state[200];
+
+        Crypto::keccak_ctx ctx;
+
+        Crypto::Hash streamed;
+
+        Crypto::keccak_init(&ctx, sizeof(state));
+
+        for (const auto &piece : iov)
+        {
+            Crypto::keccak_update(&ctx, static_cast<const uint8_t *>(piece.data), piece.length);
+        }
+
+        Crypto::keccak_final(&ctx, state);
+
+        std::memcpy(&streamed, state, sizeof(streamed));
+
+        const Crypto::Hash expected = Crypto::cn_fast_hash(message.data(), offset);
+
+        if (Crypto::cn_fast_hash_iov(iov.data(), iov.size()) != expected || streamed != expected)
+        {
+            std::cout << "failed" << std::endl;
+
+            exit(1);
+        }
+    }
+
+    std::cout << "passed" << std::endl;
+}
+
+void TestBinaryCryptography(const Crypto::RingSignatureCheck &ringCheck)
+{
+    std::cout << "Core::BinaryCryptography: ";
+
+    const std::string txPublicKey = "f235acd76ee38ec4f7d95123436200f9ed74f9eb291b1454fbc30742481be1ab";
+
+    const std::string privateViewKey = "89df8c4d34af41a51cfae0267e8254cadd2298f9256439fa1cfa7e25ee606606";
+
+    Crypto::PublicKey l_txPublicKey;
+
+    Crypto::SecretKey l_privateViewKey;
+
+    Common::podFromHex(txPublicKey, l_txPublicKey);
+
+    Common::podFromHex(privateViewKey, l_privateViewKey);
+
+    Crypto::KeyDerivation derivation;
+
+    Crypto::PublicKey derivedKey;
+
+    Crypto::PublicKey underivedKey;
+
+    std::string hexDerivation;
+
+    std::string hexDerivedKey;
+
+    /* The hex methods are adapters over the binary ones, so both have to agree */
+    if (!Core::BinaryCryptography::generateKeyDerivation(l_txPublicKey, l_privateViewKey, derivation)
+        || !Core::Cryptography::generateKeyDerivation(txPublicKey, privateViewKey, hexDerivation)
+        || Common::podToHex(derivation) != hexDerivation
+        || !Core::BinaryCryptography::derivePublicKey(derivation, 3, l_txPublicKey, derivedKey)
+        || !Core::Cryptography::derivePublicKey(hexDerivation, 3, txPublicKey, hexDerivedKey)
+        || Common::podToHex(derivedKey) != hexDerivedKey
+        || !Core::BinaryCryptography::underivePublicKey(derivation, 3, derivedKey, underivedKey)
+        || underivedKey != l_txPublicKey)
+    {
+        std::cout << "failed" << std::endl;
+
+        exit(1);
+    }
+
+    const size_t ringSize = ringCheck.publicKeys.size();
+
+    if (!Core::BinaryCryptography::checkRingSignature(
+            ringCheck.prefixHash,
+            ringCheck.keyImage,
+            ringCheck.publicKeys.data(),
+            ringCheck.signatures.data(),
+            ringSize)
+        || Core::BinaryCryptography::checkRingSignature(
+            ringCheck.prefixHash,
+            ringCheck.keyImage,
+            ringCheck.publicKeys.data() + 1,
+            ringCheck.signatures.data() + 1,
+            ringSize - 1))
+    {
+        std::cout << "failed" << std::endl;
+
+        exit(1);
+    }
+
+    std::cout << "passed" << std::endl;
+}
+
+void TestHexBatch(const Crypto::RingSignatureCheck &ringCheck)
+{
+    std::cout << "Common::podFromHexBatch: ";
+
+    std::vector<std::string> texts;
+
+    Common::podToHexBatch(ringCheck.signatures.data(), ringCheck.signatures.size(), texts);
+
+    std::vector<Crypto::Signature> signatures(texts.size());
+
+    std::string joined;
+
+    for (size_t i = 0; i < texts.size(); i++)
+    {
+        if (texts[i] != Common::toHex(&ringCheck.signatures[i], sizeof(Crypto::Signature)))
+        {
+            std::cout << "failed" << std::endl;
+
+            exit(1);
+        }
+
+        joined += texts[i];
+    }
+
+    if (!Common::podFromHexBatch(texts, signatures.data()) || signatures != ringCheck.signatures)
+    {
+        std::cout << "failed" << std::endl;
+
+        exit(1);
+    }
+
+    std::vector<Crypto::Signature> fromJoined(texts.size());
+
+    if (!Common::podFromHexBatch(joined.data(), texts.size(), fromJoined.data()) || fromJoined != signatures)
+    {
+        std::cout << "failed" << std::endl;
+
+        exit(1);
+    }
+
+    /* A bad character anywhere (here inside the vectorised part of the last string) or a
+       string of the wrong length is an error rather than an exception */
+    texts.back()[40] = 'g';
+
+    std::vector<Crypto::Hash> hashes(1);
+
+    if (Common::podFromHexBatch(texts, signatures.data())
+        || Common::podFromHexBatch(std::vector<std::string> {texts.front()}, hashes.data()))
+    {
+        std::cout << "failed" << std::endl;
+
+        exit(1);
+    }
+
+    std::cout << "passed" << std::endl;
+}
+
+void TestScanTransactions()
+{
+    std::cout << "Crypto::crypto_ops::scanTransactions: ";
+
+    Crypto::PublicKey publicViewKey;
+
+    Crypto::SecretKey privateViewKey;
+
+    Crypto::generate_keys(publicViewKey, privateViewKey);
+
+    std::vector<Crypto::PublicKey> publicSpendKeys(3);
+
+    for (auto &publicSpendKey : publicSpendKeys)
+    {
+        Crypto::SecretKey privateSpendKey;
+
+        Crypto::generate_keys(publicSpendKey, privateSpendKey);
+    }
+
+    std::vector<Crypto::TransactionOutputRecord> records;
+
+    std::vector<Crypto::OwnedOutput> expected;
+
+    /* Enough outputs to span several batches, with every fourth transaction paying someone else */
+    for (size_t tx = 0; tx < 40; tx++)
+    {
+        Crypto::PublicKey txPublicKey;
+
+        Crypto::SecretKey txPrivateKey;
+
+        Crypto::generate_keys(txPublicKey, txPrivateKey);
+
+        Crypto::KeyDerivation derivation;
+
+        Crypto::generate_key_derivation(publicViewKey, txPrivateKey, derivation);
+
+        for (uint64_t outputIndex = 0; outputIndex < 3; outputIndex++)
+        {
+            Crypto::TransactionOutputRecord record {txPublicKey, outputIndex, Crypto::PublicKey()};
+
+            if (tx % 4 == 3)
+            {
+                Crypto::SecretKey unused;
+
+                Crypto::generate_keys(record.outputKey, unused);
+            }
+            else
+            {
+                const size_t subwalletIndex = (tx + outputIndex) % publicSpendKeys.size();
+
+                Crypto::derive_public_key(derivation, outputIndex, publicSpendKeys[subwalletIndex], record.outputKey);
+
+                Crypto::OwnedOutput owned {records.size(), subwalletIndex, Crypto::EllipticCurveScalar()};
+
+                Crypto::derivation_to_scalar(derivation, outputIndex, owned.derivationScalar);
+
+                expected.push_back(owned);
+            }
+
+            records.push_back(record);
+        }
+    }
+
+    std::vector<Crypto::OwnedOutput> ownedOutputs;
+
+    bool success = Crypto::crypto_ops::scanTransactions(privateViewKey, publicSpendKeys, records, ownedOutputs, 2)
+                   && ownedOutputs.size() == expected.size();
+
+    for (size_t i = 0; success && i < expected.size(); i++)
+    {
+        success = ownedOutputs[i].recordIndex == expected[i].recordIndex
+                  && ownedOutputs[i].subwalletIndex == expected[i].subwalletIndex
+                  && ownedOutputs[i].derivationScalar == expected[i].derivationScalar;
+    }
+
+    /* A single spend key only picks out its own outputs */
+    const size_t ownedBySecond = std::count_if(expected.begin(), expected.end(), [](const Crypto::OwnedOutput &o) {
+        return o.subwalletIndex == 1;
+    });
+
+    success = success
+              && Crypto::crypto_ops::scanTransactions(privateViewKey, publicSpendKeys[1], records, ownedOutputs)
+              && ownedOutputs.size() == ownedBySecond;
+
+    if (!success)
+    {
+        std::cout << "failed" << std::endl;
+
+        exit(1);
+    }
+
+    std::cout << "passed" << std::endl;
+}
+
+void TestSubwalletKeyIndex()
+{
+    std::cout << "Crypto::SubwalletKeyIndex: ";
+
+    std::vector<Crypto::PublicKey> publicSpendKeys(2000);
+
+    for (auto &publicSpendKey : publicSpendKeys)
+    {
+        Crypto::SecretKey privateSpendKey;
+
+        Crypto::generate_keys(publicSpendKey, privateSpendKey);
+    }
+
+    /* Half up front, the rest one by one to exercise rehashing */
+    Crypto::SubwalletKeyIndex index(
+        std::vector<Crypto::PublicKey>(publicSpendKeys.begin(), publicSpendKeys.begin() + 1000));
+
+    for (size_t i = 1000; i < publicSpendKeys.size(); i++)
+    {
+        index.add(publicSpendKeys[i]);
+    }
+
+    bool success = index.size() == publicSpendKeys.size() && index.add(publicSpendKeys[42]) == 42
+                   && index.size() == publicSpendKeys.size();
+
+    for (size_t i = 0; success && i < publicSpendKeys.size(); i++)
+    {
+        success = index.find(publicSpendKeys[i]) == i && index[i] == publicSpendKeys[i];
+    }
+
+    Crypto::PublicKey unknownKey;
+
+    Crypto::SecretKey unused;
+
+    Crypto::generate_keys(unknownKey, unused);
+
+    success = success && !index.contains(unknownKey)
+              && Crypto::SubwalletKeyIndex().find(unknownKey) == Crypto::SubwalletKeyIndex::npos;
+
+    /* Outputs sent to subwallets deep in the index are attributed to the right one */
+    Crypto::PublicKey publicViewKey;
+
+    Crypto::SecretKey privateViewKey;
+
+    Crypto::generate_keys(publicViewKey, privateViewKey);
+
+    std::vector<Crypto::TransactionOutputRecord> records;
+
+    for (const size_t subwalletIndex : {1999, 0, 1234})
+    {
+        Crypto::PublicKey txPublicKey;
+
+        Crypto::SecretKey txPrivateKey;
+
+        Crypto::generate_keys(txPublicKey, txPrivateKey);
+
+        Crypto::KeyDerivation derivation;
+
+        Crypto::generate_key_derivation(publicViewKey, txPrivateKey, derivation);
+
+        Crypto::TransactionOutputRecord record {txPublicKey, 7, Crypto::PublicKey()};
+
+        Crypto::derive_public_key(derivation, record.outputIndex, publicSpendKeys[subwalletIndex], record.outputKey);
+
+        records.push_back(record);
+    }
+
+    std::vector<Crypto::OwnedOutput> ownedOutputs;
+
+    success = success && Crypto::crypto_ops::scanTransactions(privateViewKey, index, records, ownedOutputs)
+              && ownedOutputs.size() == 3 && ownedOutputs[0].subwalletIndex == 1999
+              && ownedOutputs[1].subwalletIndex == 0 && ownedOutputs[2].subwalletIndex == 1234;
+
+    /* A repeated key takes up its own subwallet index, so later keys keep their positions */
+    const std::vector<Crypto::PublicKey> duplicated = {
+        publicSpendKeys[3], publicSpendKeys[4], publicSpendKeys[3], publicSpendKeys[5]};
+
+    const Crypto::SubwalletKeyIndex duplicatedIndex(duplicated);
+
+    success = success && duplicatedIndex.size() == 4 && duplicatedIndex[2] == publicSpendKeys[3]
+              && duplicatedIndex.find(publicSpendKeys[3]) == 0 && duplicatedIndex.find(publicSpendKeys[5]) == 3;
+
+    Crypto::PublicKey txPublicKey;
+
+    Crypto::SecretKey txPrivateKey;
+
+    Crypto::generate_keys(txPublicKey, txPrivateKey);
+
+    Crypto::KeyDerivation derivation;
+
+    Crypto::generate_key_derivation(publicViewKey, txPrivateKey, derivation);
+
+    Crypto::TransactionOutputRecord record {txPublicKey, 0, Crypto::PublicKey()};
+
+    Crypto::derive_public_key(derivation, record.outputIndex, publicSpendKeys[5], record.outputKey);
+
+    success = success && Crypto::crypto_ops::scanTransactions(privateViewKey, duplicated, {record}, ownedOutputs)
+              && ownedOutputs.size() == 1 && ownedOutputs[0].subwalletIndex == 3;
+
+    if (!success)
+    {
+        std::cout << "failed" << std::endl;
+
+        exit(1);
+    }
+
+    std::cout << "passed" << std::endl;
+}
+
+void TestPrecomputedPoint()
+{
+    std::cout << "Crypto::PrecomputedPoint: ";
+
+    bool success = true;
+
+    for (size_t i = 0; success && i < 8; i++)
+    {
+        Crypto::PublicKey publicKey;
+
+        Crypto::SecretKey privateKey;
+
+        Crypto::generate_keys(publicKey, privateKey);
+
+        Crypto::PublicKey txPublicKey;
+
+        Crypto::SecretKey txPrivateKey;
+
+        Crypto::generate_keys(txPublicKey, txPrivateKey);
+
+        const Crypto::PrecomputedPoint precomputed(publicKey);
+
+        Crypto::KeyDerivation derivation;
+
+        Crypto::KeyDerivation precomputedDerivation;
+
+        Crypto::PublicKey outputKey;
+
+        Crypto::PublicKey precomputedOutputKey;
+
+        Crypto::PublicKey otherOutputKey;
+
+        success = precomputed.valid() && precomputed.key() == publicKey
+                  && Crypto::generate_key_derivation(publicKey, txPrivateKey, derivation)
+                  && Crypto::generate_key_derivation(precomputed, txPrivateKey, precomputedDerivation)
+                  && derivation == precomputedDerivation
+                  && Crypto::derive_public_key(derivation, i, publicKey, outputKey)
+                  && Crypto::derive_public_key(derivation, i, precomputed, precomputedOutputKey)
+                  && outputKey == precomputedOutputKey
+                  && Crypto::is_output_for(derivation, i, outputKey, precomputed)
+                  && Crypto::derive_public_key(derivation, i + 1, publicKey, otherOutputKey)
+                  && !Crypto::is_output_for(derivation, i, otherOutputKey, precomputed);
+    }
+
+    /* The same y coordinate as the base point, but flagged with a negative zero x */
+    Crypto::PublicKey invalidKey;
+
+    Common::podFromHex("0100000000000000000000000000000000000000000000000000000000000080", invalidKey);
+
+    const Crypto::PrecomputedPoint invalid(invalidKey);
+
+    Crypto::KeyDerivation derivation;
+
+    success = success && !invalid.valid() && !Crypto::generate_key_derivation(invalid, Crypto::SecretKey(), derivation);
+
+    if (!success)
+    {
+        std::cout << "failed" << std::endl;
+
+        exit(1);
+    }
+
+    std::cout << "passed" << std::endl;
 }
 
-/* Check if we're testing a v1 or v2 hash function */
-/* Hacky as fuck lmao */
-bool need43BytesOfData(std::string hashFunctionName)
+void TestRingMemberCache(const Crypto::RingSignatureCheck &ringCheck)
 {
-    return (hashFunctionName.find("v1") != std::string::npos || hashFunctionName.find("v2") != std::string::npos);
-}
+    std::cout << "Crypto::crypto_ops::setRingMemberCacheSize: ";
 
-/* Bit of hackery so we can get the variable name of the passed in function.
-   This way we can print the test we are currently performing. */
-#define TEST_HASH_FUNCTION(hashFunction, expectedOutput) \
-    testHashFunction(hashFunction, expectedOutput, #hashFunction, -1)
+    Crypto::PublicKey publicKey;
 
-#define TEST_HASH_FUNCTION_WITH_HEIGHT(hashFunction, expectedOutput, height) \
-    testHashFunction(hashFunction, expectedOutput, #hashFunction, height, height)
+    Crypto::SecretKey privateKey;
 
-template<typename T, typename... Args>
-void testHashFunction(
-    T hashFunction,
-    std::string expectedOutput,
-    std::string hashFunctionName,
-    int64_t height,
-    Args &&... args)
-{
-    if (need43BytesOfData(hashFunctionName) && INPUT_DATA.size() < 43)
+    Crypto::generate_keys(publicKey, privateKey);
+
+    Crypto::KeyImage uncachedImage;
+
+    Crypto::generate_key_image(publicKey, privateKey, uncachedImage);
+
+    /* Two entries fit in a single shard, so touching A, B, A then C has to evict B, the
+       least recently used key, and keep A */
+    Crypto::crypto_ops::setRingMemberCacheSize(2);
+
+    Crypto::crypto_ops::clearRingMemberCache();
+
+    Crypto::PublicKey lruKeys[3];
+
+    Crypto::SecretKey lruSecrets[3];
+
+    for (size_t i = 0; i < 3; i++)
     {
-        return;
+        Crypto::generate_keys(lruKeys[i], lruSecrets[i]);
     }
 
-    /* Perform the hash, with a height if given */
-    std::string hash = hashFunction(INPUT_DATA, std::forward<Args>(args)...);
+    Crypto::KeyImage lruImage;
 
-    if (height == -1)
+    for (const size_t i : {0, 1, 0, 2})
     {
-        std::cout << hashFunctionName << ": " << hash << std::endl;
+        Crypto::generate_key_image(lruKeys[i], lruSecrets[i], lruImage);
     }
-    else
+
+    const Crypto::RingMemberCacheStats evicting = Crypto::crypto_ops::getRingMemberCacheStats();
+
+    bool success = evicting.capacity == 2 && evicting.size == 2 && evicting.hits == 1 && evicting.misses == 3;
+
+    Crypto::generate_key_image(lruKeys[0], lruSecrets[0], lruImage);
+
+    success = success && Crypto::crypto_ops::getRingMemberCacheStats().hits == 2;
+
+    Crypto::generate_key_image(lruKeys[1], lruSecrets[1], lruImage);
+
+    success = success && Crypto::crypto_ops::getRingMemberCacheStats().misses == 4
+              && Crypto::crypto_ops::getRingMemberCacheStats().size == 2;
+
+    /* Larger caches are split over shards, which between them must still hold no more
+       than the capacity asked for */
+    Crypto::crypto_ops::setRingMemberCacheSize(130);
+
+    for (size_t i = 0; i < 300; i++)
     {
-        std::cout << hashFunctionName << " (" << height << "): " << hash << std::endl;
+        Crypto::PublicKey key;
+
+        Crypto::SecretKey secret;
+
+        Crypto::generate_keys(key, secret);
+
+        Crypto::generate_key_image(key, secret, lruImage);
     }
 
-    /* Verify the hash is as expected */
-    if (!CompareHashes(hash, expectedOutput))
+    success = success && Crypto::crypto_ops::getRingMemberCacheStats().size <= 130;
+
+    Crypto::crypto_ops::setRingMemberCacheSize(64);
+
+    Crypto::crypto_ops::clearRingMemberCache();
+
+    for (size_t i = 0; success && i < 3; i++)
     {
-        std::cout << "Hashes are not equal!\n"
-                  << "Expected: " << expectedOutput << "\nActual: " << hash << "\nTerminating.";
+        success = Crypto::crypto_ops::checkRingSignature(
+                      ringCheck.prefixHash, ringCheck.keyImage, ringCheck.publicKeys, ringCheck.signatures)
+                  && Crypto::crypto_ops::checkRingSignatures({ringCheck, ringCheck});
+    }
+
+    Crypto::RingSignatureCheck tampered = ringCheck;
+
+    tampered.signatures[1].data[0] ^= 1;
+
+    success = success
+              && !Crypto::crypto_ops::checkRingSignature(
+                  tampered.prefixHash, tampered.keyImage, tampered.publicKeys, tampered.signatures);
+
+    const Crypto::RingMemberCacheStats stats = Crypto::crypto_ops::getRingMemberCacheStats();
+
+    /* Only the first check misses, every later one is served from the cache */
+    success = success && stats.size == ringCheck.publicKeys.size() && stats.misses == ringCheck.publicKeys.size()
+              && stats.hits >= 5 * ringCheck.publicKeys.size();
+
+    Crypto::KeyImage cachedImage;
+
+    Crypto::KeyImage repeatedImage;
+
+    Crypto::generate_key_image(publicKey, privateKey, cachedImage);
+
+    Crypto::generate_key_image(publicKey, privateKey, repeatedImage);
+
+    success = success && cachedImage == uncachedImage && repeatedImage == uncachedImage
+              && Crypto::crypto_ops::getRingMemberCacheStats().hits == stats.hits + 1;
+
+    Crypto::crypto_ops::setRingMemberCacheSize(0);
+
+    success = success && Crypto::crypto_ops::getRingMemberCacheStats().size == 0;
+
+    if (!success)
+    {
+        std::cout << "failed" << std::endl;
 
         exit(1);
     }
-}
 
-/* Bit of hackery so we can get the variable name of the passed in function.
-   This way we can print the test we are currently performing. */
-#define BENCHMARK(hashFunction, iterations) benchmark(hashFunction, #hashFunction, iterations)
+    std::cout << "passed" << std::endl;
+}
 
-template<typename T> void benchmark(T hashFunction, std::string hashFunctionName, uint64_t iterations)
+void TestRandom()
 {
-    if (need43BytesOfData(hashFunctionName) && INPUT_DATA.size() < 43)
+    std::cout << "Random::randomBytes: ";
+
+    /* The block function test vector of RFC 7539 section 2.3.2, with the key 00..1f,
+       block counter 1 and nonce 00000009:0000004a:00000000. In the original layout the
+       counter takes the first nonce word, giving 0x0900000000000001 and 0x4a000000 */
+    uint32_t key[Random::CHACHA20_KEY_WORDS];
+
+    for (uint32_t i = 0; i < Random::CHACHA20_KEY_WORDS; i++)
     {
-        return;
+        key[i] = (4 * i) | (4 * i + 1) << 8 | (4 * i + 2) << 16 | (4 * i + 3) << 24;
     }
 
-    auto startTimer = std::chrono::high_resolution_clock::now();
+    uint8_t block[Random::CHACHA20_BLOCK_SIZE];
 
-    for (uint64_t i = 0; i < iterations; i++)
+    Random::chacha20_block(key, 0x0900000000000001, 0x4a000000, block);
+
+    if (Common::toHex(block, sizeof(block))
+        != "10f1e7e4d13b5915500fdd1fa32071c4c7d1f4c733c068030422aa9ac3d46c4e"
+           "d2826446079faa0914c2d705d98b02a2b5129cd1de164eb9cbd083e8a2503c4e")
     {
-        std::string hash = hashFunction(INPUT_DATA);
+        std::cout << "failed" << std::endl;
+
+        exit(1);
     }
 
-    auto elapsedTime = std::chrono::high_resolution_clock::now() - startTimer;
+    /* Spans several refills of the generator's buffer, and should hit every byte value */
+    const std::vector<uint8_t> bytes = Random::randomBytes(8192);
 
-    std::cout << hashFunctionName << ": "
-              << (iterations / std::chrono::duration_cast<std::chrono::seconds>(elapsedTime).count()) << " H/s\n";
-}
+    bool seen[256] = {false};
 
-void benchmarkUnderivePublicKey()
-{
-    std::string txPublicKey = "f235acd76ee38ec4f7d95123436200f9ed74f9eb291b1454fbc30742481be1ab";
+    for (const auto byte : bytes)
+    {
+        seen[byte] = true;
+    }
 
-    std::string privateViewKey = "89df8c4d34af41a51cfae0267e8254cadd2298f9256439fa1cfa7e25ee606606";
+    bool success = std::all_of(std::begin(seen), std::end(seen), [](const bool b) { return b; })
+                   && Random::randomBytes(32) != Random::randomBytes(32);
 
-    std::string derivation;
+    /* Every thread has a generator of its own */
+    std::vector<uint8_t> otherThread;
 
-    bool success = Core::Cryptography::generateKeyDerivation(txPublicKey, privateViewKey, derivation);
+    std::thread([&otherThread]() { otherThread = Random::randomBytes(32); }).join();
 
-    const uint64_t loopIterations = 600000;
+    success = success && otherThread.size() == 32 && otherThread != Random::randomBytes(32);
 
-    auto startTimer = std::chrono::high_resolution_clock::now();
+    const int value = Random::randomValue<int>(-10, 10);
 
-    std::string outputKey = "4a078e76cd41a3d3b534b83dc6f2ea2de500b653ca82273b7bfad8045d85a400";
+    success = success && value >= -10 && value <= 10;
 
-    for (uint64_t i = 0; i < loopIterations; i++)
+    std::vector<Crypto::EllipticCurveScalar> scalars = Crypto::crypto_ops::randomScalars(40);
+
+    Crypto::EllipticCurveScalar scalar;
+
+    Crypto::crypto_ops::randomScalar(scalar);
+
+    scalars.push_back(scalar);
+
+    for (size_t i = 0; success && i < scalars.size(); i++)
     {
-        std::string spendKey;
+        Crypto::EllipticCurveScalar reduced = scalars[i];
 
-        /* Use i as output index to prevent optimization */
-        bool success = Core::Cryptography::underivePublicKey(derivation, i, outputKey, spendKey);
+        Crypto::scReduce32(reduced);
+
+        success = reduced == scalars[i]
+                  && std::count(scalars.begin(), scalars.end(), scalars[i]) == 1;
     }
 
-    auto elapsedTime = std::chrono::high_resolution_clock::now() - startTimer;
+    if (!success)
+    {
+        std::cout << "failed" << std::endl;
 
-    /* Need to use microseconds here then divide by 1000 - otherwise we'll just get '0' */
-    const auto timePerDerivation =
-        std::chrono::duration_cast<std::chrono::microseconds>(elapsedTime).count() / loopIterations;
+        exit(1);
+    }
 
-    std::cout << "Time to perform underivePublicKey: " << timePerDerivation / 1000.0 << " ms" << std::endl;
+    std::cout << "passed" << std::endl;
 }
 
-void benchmarkGenerateKeyDerivation()
+void TestGenerateKeysBatch()
 {
-    std::string txPublicKey = "f235acd76ee38ec4f7d95123436200f9ed74f9eb291b1454fbc30742481be1ab";
+    std::cout << "Crypto::crypto_ops::generate_keys_batch: ";
 
-    std::string privateViewKey = "89df8c4d34af41a51cfae0267e8254cadd2298f9256439fa1cfa7e25ee606606";
+    bool success = true;
 
-    const uint64_t loopIterations = 60000;
+    /* Counts that fill, straddle and fall short of a batch, on one and on several threads */
+    for (const size_t count : {0, 1, 64, 150})
+    {
+        for (const size_t threads : {1, 3})
+        {
+            std::vector<Crypto::PublicKey> publicKeys(count);
 
-    auto startTimer = std::chrono::high_resolution_clock::now();
+            std::vector<Crypto::SecretKey> secretKeys(count);
 
-    for (uint64_t i = 0; i < loopIterations; i++)
-    {
-        std::string derivation;
+            Crypto::crypto_ops::generate_keys_batch(count, publicKeys.data(), secretKeys.data(), threads);
 
-        bool success = Core::Cryptography::generateKeyDerivation(txPublicKey, privateViewKey, derivation);
+            for (size_t i = 0; success && i < count; i++)
+            {
+                Crypto::PublicKey expected;
+
+                success = Crypto::secret_key_to_public_key(secretKeys[i], expected) && expected == publicKeys[i]
+                          && std::count(secretKeys.begin(), secretKeys.end(), secretKeys[i]) == 1;
+            }
+        }
     }
 
-    auto elapsedTime = std::chrono::high_resolution_clock::now() - startTimer;
+    if (!success)
+    {
+        std::cout << "failed" << std::endl;
 
-    const auto timePerDerivation =
-        std::chrono::duration_cast<std::chrono::microseconds>(elapsedTime).count() / loopIterations;
+        exit(1);
+    }
 
-    std::cout << "Time to perform generateKeyDerivation: " << timePerDerivation / 1000.0 << " ms" << std::endl;
+    std::cout << "passed" << std::endl;
 }
 
-void TestDeterministicSubwalletCreation(
-    const std::string baseSpendKey,
-    const uint64_t subWalletIndex,
-    const std::string expectedSpendKey)
+void TestP2ToBytesBatch()
 {
-    Crypto::SecretKey f_baseSpendKey;
+    std::cout << "ge_p2_tobytes_batch: ";
 
-    if (!Common::podFromHex(baseSpendKey, f_baseSpendKey))
+    bool success = true;
+
+    /* A single point, exactly one chunk, one past a chunk, and several chunks */
+    for (const size_t count : {1, 64, 65, 200})
     {
-        std::cout << "Could not decode base private spend key!\nTerminating...";
+        std::vector<ge_p2> points(count);
 
-        exit(1);
-    }
+        for (auto &point : points)
+        {
+            Crypto::EllipticCurveScalar scalar;
 
-    Crypto::SecretKey f_expectedSpendKey;
+            Crypto::crypto_ops::randomScalar(scalar);
 
-    if (!Common::podFromHex(expectedSpendKey, f_expectedSpendKey))
+            ge_p3 point3;
+
+            ge_scalarmult_base(&point3, reinterpret_cast<const unsigned char *>(&scalar));
+
+            ge_p3_to_p2(&point, &point3);
+        }
+
+        /* Z = 0 at the start, in the middle and on either side of a chunk boundary. Such a
+           point has no inverse, and must not spoil the other points of its chunk */
+        for (const size_t zero : {size_t(0), count / 2, size_t(GE_P2_TOBYTES_BATCH - 1), size_t(GE_P2_TOBYTES_BATCH)})
+        {
+            if (zero < count)
+            {
+                fe_0(points[zero].Z);
+            }
+        }
+
+        std::vector<Crypto::EllipticCurvePoint> batched(count);
+
+        ge_p2_tobytes_batch(reinterpret_cast<unsigned char(*)[32]>(batched.data()), points.data(), count);
+
+        for (size_t i = 0; success && i < count; i++)
+        {
+            Crypto::EllipticCurvePoint expected;
+
+            ge_tobytes(reinterpret_cast<unsigned char *>(&expected), &points[i]);
+
+            success = batched[i] == expected;
+        }
+    }
+
+    if (!success)
     {
-        std::cout << "Could not decode expected private spend key!\nTerminating...";
+        std::cout << "failed" << std::endl;
 
         exit(1);
     }
 
-    Crypto::SecretKey subwalletPrivateKey;
+    std::cout << "passed" << std::endl;
+}
 
-    Crypto::PublicKey subwalletPublicKey;
+void TestScalarBatch()
+{
+    std::cout << "sc_batch: ";
+
+    /* a, b, c, then a mod l, a + b, a - b, ab, ab + c and c - ab, all mod l. The first two
+       rows take the inputs past l and 2^255, where the scalar backends are easiest to break */
+    const std::vector<std::vector<std::string>> vectors = {
+        {"ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff",
+         "edd3f55c1a631258d69cf7a2def9de1400000000000000000000000000000010",
+         "ecd3f55c1a631258d69cf7a2def9de1400000000000000000000000000000010",
+         "1c95988d7431ecd670cf7d73f45befc6feffffffffffffffffffffffffffff0f",
+         "1c95988d7431ecd670cf7d73f45befc6feffffffffffffffffffffffffffff0f",
+         "1c95988d7431ecd670cf7d73f45befc6feffffffffffffffffffffffffffff0f",
+         "0000000000000000000000000000000000000000000000000000000000000000",
+         "ecd3f55c1a631258d69cf7a2def9de1400000000000000000000000000000010",
+         "ecd3f55c1a631258d69cf7a2def9de1400000000000000000000000000000010"},
+        {"f2d3f55c1a631258d69cf7a2def9de1400000000000000000000000000000010",
+         "3930000000000000000000000000000000000000000000000000000000000080",
+         "0000000000000000000000000000000000000000000000000000000000000000",
+         "0500000000000000000000000000000000000000000000000000000000000000",
+         "c3644775474a7f9723b63a8be92ae76dffffffffffffffffffffffffffffff0f",
+         "346faee7d21893c0b2e6bc17f5cef7a600000000000000000000000000000000",
+         "02a88dd6fbe63295581b472c15ef07d2fcffffffffffffffffffffffffffff0f",
+         "02a88dd6fbe63295581b472c15ef07d2fcffffffffffffffffffffffffffff0f",
+         "eb2b68861e7cdfc27d81b076c90ad74203000000000000000000000000000000"},
+        {"f69980605c89bbc4ed0242ed070ef2d72a20ecd71135ed0304b4cb36eb4e54ee",
+         "4d4328dfb733044e3a28efa239fb3b79d135da0a15b6a8db17faf5f3acefe3c1",
+         "237c7441b069e308d7864f4ed9a492907f84906cec519d18b3daa896d834cfdb",
+         "00030f4beb1dbaf3346fb703db63c0b32920ecd71135ed0304b4cb36eb4e540e",
+         "4483bb714c49cfc88ca01360c6aea91dfa55c6e226eb95df1baec12a983e3800",
+         "cfae6cc76f8f92c606a16304111ff83459ea11cdfc7e4428ecb9d5423e5f700c",
+         "365db99d91465f4d93c3cf1c3b11d10509342fec049ca027a2d449435c774502",
+         "5016b226eba753dd87538c24c605118787b8bf58f1ed3d4055aff2d934ac140e",
+         "e45b3febc71a954261ccecea4fe36e7b75506180e7b5fcf010065f537cbd8909"}};
+
+    const size_t count = vectors.size();
+
+    /* columns[j][i] is the j-th value of the i-th row */
+    std::vector<std::vector<Crypto::EllipticCurveScalar>> columns(9, std::vector<Crypto::EllipticCurveScalar>(count));
+
+    for (size_t i = 0; i < count; i++)
+    {
+        for (size_t j = 0; j < 9; j++)
+        {
+            Common::podFromHex(vectors[i][j], columns[j][i]);
+        }
+    }
 
-    Crypto::generate_deterministic_subwallet_keys(
-        f_baseSpendKey, subWalletIndex, subwalletPrivateKey, subwalletPublicKey);
+    const auto in = [&](const size_t j) { return reinterpret_cast<const unsigned char(*)[32]>(columns[j].data()); };
 
-    if (subwalletPrivateKey != f_expectedSpendKey)
+    std::vector<Crypto::EllipticCurveScalar> result(count);
+
+    unsigned char(*out)[32] = reinterpret_cast<unsigned char(*)[32]>(result.data());
+
+    result = columns[0];
+
+    sc_batch_reduce32(out, count);
+
+    bool success = result == columns[3];
+
+    sc_batch_add(out, in(0), in(1), count);
+
+    success = success && result == columns[4];
+
+    sc_batch_sub(out, in(0), in(1), count);
+
+    success = success && result == columns[5];
+
+    sc_batch_mul(out, in(0), in(1), count);
+
+    success = success && result == columns[6];
+
+    sc_batch_muladd(out, in(0), in(1), in(2), count);
+
+    success = success && result == columns[7];
+
+    sc_batch_mulsub(out, in(0), in(1), in(2), count);
+
+    success = success && result == columns[8];
+
+    /* The largest 64-byte input */
+    unsigned char wide[1][64];
+
+    std::fill(wide[0], wide[0] + 64, 0xff);
+
+    sc_batch_reduce(wide, 1);
+
+    success = success
+              && Common::toHex(wide[0], 32) == "000f9c44e31106a447938568a71b0ed065bef517d273ecce3d9a307c1b419903";
+
+    if (!success)
     {
-        std::cout << "Could not deterministically create subwallet spend keys!\n"
-                  << "Expected: " << expectedSpendKey << "\nActual: " << subwalletPrivateKey << "\nTerminating.";
+        std::cout << "failed" << std::endl;
 
         exit(1);
     }
+
+    std::cout << "passed" << std::endl;
 }
 
 int main(int argc, char **argv)
@@ -361,6 +1687,8 @@ int main(int argc, char **argv)
         TEST_HASH_FUNCTION(Core::Cryptography::chukwa_slow_hash_v1, CHUKWA_V1);
         TEST_HASH_FUNCTION(Core::Cryptography::chukwa_slow_hash_v2, CHUKWA_V2);
 
+        TestChukwaContext();
+
         std::cout << std::endl;
 
         for (uint64_t height = 0; height <= 8192; height += 512)
@@ -385,6 +1713,23 @@ int main(int argc, char **argv)
                 Core::Cryptography::cn_soft_shell_slow_hash_v2, CN_SOFT_SHELL_V2[height / 512], height);
         }
 
+        std::cout << std::endl << "Batched Slow Hash Tests" << std::endl << std::endl;
+
+        TestSlowHashBatch("Crypto::cn_slow_hash_batch (v0)", 0, 0, CN_PAGE_SIZE, CN_SCRATCHPAD, CN_ITERATIONS);
+        TestSlowHashBatch(
+            "Crypto::cn_slow_hash_batch (lite v1)", 1, 1, CN_LITE_PAGE_SIZE, CN_LITE_SCRATCHPAD, CN_LITE_ITERATIONS);
+        TestSlowHashBatch(
+            "Crypto::cn_slow_hash_batch (dark v2)", 0, 2, CN_DARK_PAGE_SIZE, CN_DARK_SCRATCHPAD, CN_DARK_ITERATIONS);
+        TestSlowHashBatch(
+            "Crypto::cn_slow_hash_batch (turtle lite v2)",
+            1,
+            2,
+            CN_TURTLE_PAGE_SIZE,
+            CN_TURTLE_SCRATCHPAD,
+            CN_TURTLE_ITERATIONS);
+
+        TestSlowHashPool();
+
         if (o_benchmark)
         {
             std::cout << "\nPerformance Tests: Please wait, this may take a while depending on your system...\n\n";
@@ -418,6 +1763,10 @@ int main(int argc, char **argv)
 
             BENCHMARK(Core::Cryptography::chukwa_slow_hash_v1, o_iterations_long);
 			BENCHMARK(Core::Cryptography::chukwa_slow_hash_v2, o_iterations_long);
+
+            benchmarkSlowHashBatch(o_iterations_long);
+
+            benchmarkTreeHash();
         }
 
         std::cout << std::endl << "Deterministic Subwallet Creation Tests: ";
@@ -442,6 +1791,7 @@ int main(int argc, char **argv)
             "dd0c02d3202634821b4d9d91b63d919725f5c3e97e803f3512e52fb0dc2aab0c",
             65,
             "0c6b5fff72260832558e35c38e690072503211af065056862288dc7fd992350a");
+        TestDeterministicSubwalletRange("dd0c02d3202634821b4d9d91b63d919725f5c3e97e803f3512e52fb0dc2aab0c");
 
         std::cout << "Passed." << std::endl;
 
@@ -573,6 +1923,82 @@ int main(int argc, char **argv)
         }
 
         std::cout << "passed" << std::endl;
+
+        std::cout << "Crypto::crypto_ops::checkRingSignatures: ";
+
+        Crypto::RingSignatureCheck ringCheck;
+
+        Common::podFromHex("b542df5b6e7f5f05275c98e7345884e2ac726aeeb07e03e44e0389eb86cd05f0", ringCheck.prefixHash);
+
+        Common::podFromHex("6865866ed8a25824e042e21dd36e946836b58b03366e489aecf979f444f599b0", ringCheck.keyImage);
+
+        for (const auto &key : {"492390897da1cabd3886e3eff43ad1d04aa510a905bec0acd31a0a2f260e7862",
+                                "7644ccb5410cca2be18b033e5f7497aeeeafd1d8f317f29cba4803e4306aa402",
+                                "bb9a956ffdf8159ad69474e6b0811316c44a17a540d5e39a44642d4d933a6460",
+                                "e1cd9ccdfdf2b3a45ac2cfd1e29185d22c185742849f52368c3cdd1c0ce499c0"})
+        {
+            Crypto::PublicKey publicKey;
+
+            Common::podFromHex(key, publicKey);
+
+            ringCheck.publicKeys.push_back(publicKey);
+        }
+
+        for (const auto &signature : signatures)
+        {
+            Crypto::Signature sig;
+
+            Common::podFromHex(signature, sig);
+
+            ringCheck.signatures.push_back(sig);
+        }
+
+        std::vector<Crypto::RingSignatureCheck> ringChecks(4, ringCheck);
+
+        /* Tamper with one of the signatures, only that entry should fail */
+        ringChecks[2].signatures[1].data[0] ^= 1;
+
+        std::vector<bool> ringResults;
+
+        const bool allValid = Crypto::crypto_ops::checkRingSignatures(ringChecks, ringResults, 2);
+
+        if (allValid || ringResults != std::vector<bool> {true, true, false, true}
+            || !Crypto::crypto_ops::checkRingSignatures({ringCheck, ringCheck}))
+        {
+            std::cout << "failed" << std::endl;
+
+            exit(1);
+        }
+
+        std::cout << "passed" << std::endl;
+
+        TestBinaryCryptography(ringCheck);
+
+        TestHexBatch(ringCheck);
+
+        TestFastHashBatch();
+
+        TestFastHashIov();
+
+        TestTreeHash();
+
+        TestTreeHashAccumulator();
+
+        TestScanTransactions();
+
+        TestSubwalletKeyIndex();
+
+        TestPrecomputedPoint();
+
+        TestRingMemberCache(ringCheck);
+
+        TestRandom();
+
+        TestGenerateKeysBatch();
+
+        TestScalarBatch();
+
+        TestP2ToBytesBatch();
     }
     catch (std::exception &e)
     {
@@ -1424,6 +1424,172 @@ export class Crypto {
 
         return tryRunFunc('chukwa_slow_hash_v2', data.toLowerCase());
     }
+
+    /**
+     * Generates the key derivations (aB) of every public key with its private key. The
+     * keys are packed 32 bytes apiece, and an argument holding a single key is used for
+     * every record, e.g. a wallet's private view key. Only available with the Node.js
+     * native addon. Resolves to the packed derivations, zeroed where one failed
+     * @param public_keys the packed public keys
+     * @param private_keys the packed private keys
+     */
+    public async generateKeyDerivations (public_keys: Uint8Array, private_keys: Uint8Array): Promise<Buffer> {
+        if (!isBinary(public_keys)) {
+            throw new Error('Invalid public keys found');
+        }
+        if (!isBinary(private_keys)) {
+            throw new Error('Invalid private keys found');
+        }
+
+        return tryRunBatchFunc('generateKeyDerivations', public_keys, private_keys);
+    }
+
+    /**
+     * Derives the output keys of a batch of outputs, as derivePublicKey does for one.
+     * Only available with the Node.js native addon
+     * @param derivations the packed key derivations
+     * @param output_indexes the output indexes, or a single index for every record
+     * @param public_keys the packed public keys, or a single public key for every record
+     */
+    public async derivePublicKeys (
+        derivations: Uint8Array,
+        output_indexes: number | number[] | Uint32Array,
+        public_keys: Uint8Array
+    ): Promise<Buffer> {
+        if (!isBinary(derivations)) {
+            throw new Error('Invalid derivations found');
+        }
+        if (!isUIntRecords(output_indexes)) {
+            throw new Error('Invalid output indexes found');
+        }
+        if (!isBinary(public_keys)) {
+            throw new Error('Invalid public keys found');
+        }
+
+        return tryRunBatchFunc('derivePublicKeys', derivations, output_indexes, public_keys);
+    }
+
+    /**
+     * Underives the public keys of a batch of outputs, as underivePublicKey does for one.
+     * Only available with the Node.js native addon
+     * @param derivations the packed key derivations
+     * @param output_indexes the output indexes, or a single index for every record
+     * @param outputKeys the packed output keys
+     */
+    public async underivePublicKeys (
+        derivations: Uint8Array,
+        output_indexes: number | number[] | Uint32Array,
+        outputKeys: Uint8Array
+    ): Promise<Buffer> {
+        if (!isBinary(derivations)) {
+            throw new Error('Invalid derivations found');
+        }
+        if (!isUIntRecords(output_indexes)) {
+            throw new Error('Invalid output indexes found');
+        }
+        if (!isBinary(outputKeys)) {
+            throw new Error('Invalid output keys found');
+        }
+
+        return tryRunBatchFunc('underivePublicKeys', derivations, output_indexes, outputKeys);
+    }
+
+    /**
+     * Generates the key images of a batch of outputs, as generateKeyImage does for one.
+     * Only available with the Node.js native addon
+     * @param publicEphemerals the packed public ephemerals
+     * @param private_ephemerals the packed private ephemerals
+     */
+    public async generateKeyImages (publicEphemerals: Uint8Array, private_ephemerals: Uint8Array): Promise<Buffer> {
+        if (!isBinary(publicEphemerals)) {
+            throw new Error('Invalid public ephemerals found');
+        }
+        if (!isBinary(private_ephemerals)) {
+            throw new Error('Invalid private ephemerals found');
+        }
+
+        return tryRunBatchFunc('generateKeyImages', publicEphemerals, private_ephemerals);
+    }
+
+    /**
+     * Checks a batch of signatures, as checkSignature does for one. Only available with
+     * the Node.js native addon. Resolves to one byte per signature, 1 if it is valid
+     * @param message_digests the packed hashes, or a single hash for every record
+     * @param public_keys the packed public keys
+     * @param signatures the packed 64 byte signatures
+     */
+    public async checkSignaturesBatch (
+        message_digests: Uint8Array,
+        public_keys: Uint8Array,
+        signatures: Uint8Array
+    ): Promise<Buffer> {
+        if (!isBinary(message_digests)) {
+            throw new Error('Invalid message digests found');
+        }
+        if (!isBinary(public_keys)) {
+            throw new Error('Invalid public keys found');
+        }
+        if (!isBinary(signatures)) {
+            throw new Error('Invalid signatures found');
+        }
+
+        return tryRunBatchFunc('checkSignaturesBatch', message_digests, public_keys, signatures);
+    }
+
+    /**
+     * Checks a batch of ring signatures, as checkRingSignatures does for one. The input
+     * keys and signatures of every ring are packed one ring after the other, with the
+     * size of each ring given by ring_sizes. Only available with the Node.js native
+     * addon. Resolves to one byte per ring, 1 if its signatures are valid
+     * @param prefix_hashes the packed prefix hashes
+     * @param key_images the packed key images
+     * @param input_keys the packed input keys of every ring
+     * @param signatures the packed signatures of every ring
+     * @param ring_sizes the size of every ring, or a single size for every ring
+     */
+    public async checkRingSignaturesBatch (
+        prefix_hashes: Uint8Array,
+        key_images: Uint8Array,
+        input_keys: Uint8Array,
+        signatures: Uint8Array,
+        ring_sizes: number | number[] | Uint32Array
+    ): Promise<Buffer> {
+        if (!isBinary(prefix_hashes)) {
+            throw new Error('Invalid prefix hashes found');
+        }
+        if (!isBinary(key_images)) {
+            throw new Error('Invalid key images found');
+        }
+        if (!isBinary(input_keys)) {
+            throw new Error('Invalid input keys found');
+        }
+        if (!isBinary(signatures)) {
+            throw new Error('Invalid signatures found');
+        }
+        if (!isUIntRecords(ring_sizes)) {
+            throw new Error('Invalid ring sizes found');
+        }
+
+        return tryRunBatchFunc('checkRingSignaturesBatch',
+            prefix_hashes, key_images, input_keys, signatures, ring_sizes);
+    }
+
+    /**
+     * Calculates the cn_fast_hash of every record_length bytes of the data supplied.
+     * Only available with the Node.js native addon. Resolves to the packed hashes
+     * @param data the packed messages
+     * @param record_length the length of each message
+     */
+    public async cn_fast_hashes (data: Uint8Array, record_length: number): Promise<Buffer> {
+        if (!isBinary(data)) {
+            throw new Error('Invalid data found');
+        }
+        if (!isUInt(record_length)) {
+            throw new Error('Invalid record length found');
+        }
+
+        return tryRunBatchFunc('cn_fast_hashes', data, record_length);
+    }
 }
 
 /**
@@ -1473,6 +1639,21 @@ async function tryRunFunc (...args: any[]): Promise<any> {
             } catch (e) {
                 return reject(new Error('Error with use defined cryptographic primitive'));
             }
+        } else if (moduleVars.type === CryptoType.NODEADDON && moduleVars.crypto.async &&
+            moduleVars.crypto.async[func]) {
+            /* The asynchronous variants run on the libuv threadpool and hand
+               back (err, value) so that we do not block the event loop */
+            try {
+                moduleVars.crypto.async[func](...args, (err: boolean, res: any) => {
+                    if (err) {
+                        return reject(err);
+                    }
+
+                    return resolve(res);
+                });
+            } catch (e) {
+                return reject(new Error('Underlying cryptographic method failure'));
+            }
         } else if (moduleVars.type === CryptoType.NODEADDON && moduleVars.crypto[func]) {
             /* If the function name starts with 'check' then it
                will return a boolean which we can just send back
@@ -1524,6 +1705,44 @@ async function tryRunFunc (...args: any[]): Promise<any> {
     });
 }
 
+/**
+ * Runs one of the batch methods, which only the Node.js native addon provides. They
+ * take and return Buffers, so they are never handed to the user-defined primitives,
+ * which work on hex strings, and always resolve the result Buffer
+ * @ignore
+ */
+async function tryRunBatchFunc (...args: any[]): Promise<Buffer> {
+    const func: string = args.shift();
+
+    return new Promise((resolve, reject) => {
+        if (moduleVars.type !== CryptoType.NODEADDON || !moduleVars.crypto[func]) {
+            return reject(new Error('Batch operations require the Node.js native addon'));
+        }
+
+        try {
+            if (moduleVars.crypto.async && moduleVars.crypto.async[func]) {
+                moduleVars.crypto.async[func](...args, (err: boolean, res: Buffer) => {
+                    if (err) {
+                        return reject(err);
+                    }
+
+                    return resolve(res);
+                });
+            } else {
+                const [err, res] = moduleVars.crypto[func](...args);
+
+                if (err) {
+                    return reject(err);
+                }
+
+                return resolve(res);
+            }
+        } catch (e) {
+            return reject(new Error('Underlying cryptographic method failure'));
+        }
+    });
+}
+
 /**
  * @ignore
  */
@@ -1644,6 +1863,13 @@ function isHex128 (value: string): boolean {
     return (isHex(value) && value.length === 128);
 }
 
+/**
+ * @ignore
+ */
+function isBinary (value: Uint8Array): boolean {
+    return ArrayBuffer.isView(value);
+}
+
 /**
  * @ignore
  */
@@ -1651,6 +1877,17 @@ function isUInt (value: number) {
     return (value === toInt(value) && toInt(value) >= 0);
 }
 
+/**
+ * @ignore
+ */
+function isUIntRecords (value: number | number[] | Uint32Array): boolean {
+    if (typeof value === 'number') {
+        return isUInt(value);
+    }
+
+    return (value instanceof Uint32Array || (Array.isArray(value) && value.every(elem => isUInt(elem))));
+}
+
 /**
  * @ignore
  */